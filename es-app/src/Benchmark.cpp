@@ -0,0 +1,227 @@
+//  SPDX-License-Identifier: MIT
+//
+//  ES-DE
+//  Benchmark.cpp
+//
+//  Scripted frame time benchmark, started using the --benchmark command line option.
+//  Replays a fixed input sequence using the null renderer and reports the CPU time spent
+//  per frame along with the draw call and texture upload counts.
+//
+
+#include "Benchmark.h"
+
+#include "InputManager.h"
+#include "Log.h"
+#include "Window.h"
+#include "renderers/RendererNull.h"
+#include "utils/FileSystemUtil.h"
+#include "utils/StringUtil.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <sstream>
+
+namespace
+{
+    // Switch systems, enter a gamelist, scroll it, open and close the menu and then return
+    // to the system view.
+    const std::string defaultScript {"wait 60\n"
+                                     "press right 3\n"
+                                     "press left 2\n"
+                                     "press a\n"
+                                     "wait 30\n"
+                                     "hold down 120\n"
+                                     "hold up 60\n"
+                                     "press rightshoulder 2\n"
+                                     "press start\n"
+                                     "wait 30\n"
+                                     "press down 4\n"
+                                     "press b\n"
+                                     "wait 30\n"
+                                     "press b\n"
+                                     "wait 60\n"};
+} // namespace
+
+Benchmark::Benchmark(Window* window)
+    : mWindow {window}
+{
+}
+
+bool Benchmark::loadScript(const std::string& path)
+{
+    if (path.empty())
+        return parseScript(defaultScript, "built-in script");
+
+    if (!Utils::FileSystem::exists(path)) {
+        LOG(LogError) << "Benchmark: Couldn't find script file \"" << path << "\"";
+        return false;
+    }
+
+#if defined(_WIN64)
+    std::ifstream scriptFile {Utils::String::stringToWideString(path).c_str()};
+#else
+    std::ifstream scriptFile {path};
+#endif
+    std::stringstream script;
+    script << scriptFile.rdbuf();
+
+    return parseScript(script.str(), path);
+}
+
+void Benchmark::run()
+{
+    RendererNull* renderer {RendererNull::getInstance()};
+    renderer->resetStatistics();
+    mFrameTimes.clear();
+
+    LOG(LogInfo) << "Benchmark: Running " << mSteps.size() << " steps";
+
+    for (auto& step : mSteps) {
+        if (step.type == StepType::WAIT) {
+            runFrames(step.count);
+        }
+        else if (step.type == StepType::PRESS) {
+            for (int i {0}; i < step.count; ++i) {
+                sendInput(step.button, true);
+                runFrames(1);
+                sendInput(step.button, false);
+                runFrames(PRESS_INTERVAL);
+            }
+        }
+        else {
+            sendInput(step.button, true);
+            runFrames(step.count);
+            sendInput(step.button, false);
+            runFrames(1);
+        }
+    }
+
+    reportResults();
+}
+
+bool Benchmark::parseScript(const std::string& script, const std::string& source)
+{
+    std::istringstream lines {script};
+    int lineNumber {0};
+    mSteps.clear();
+
+    for (std::string line; std::getline(lines, line);) {
+        ++lineNumber;
+        line = Utils::String::trim(line);
+        if (line.empty() || line.front() == '#')
+            continue;
+
+        std::istringstream tokens {line};
+        std::string command;
+        Step step {StepType::WAIT, "", 1};
+        tokens >> command;
+
+        if (command == "wait") {
+            if (!(tokens >> step.count))
+                step.count = 0;
+        }
+        else if (command == "press" || command == "hold") {
+            step.type = (command == "press" ? StepType::PRESS : StepType::HOLD);
+            tokens >> step.button;
+            // The count is optional for button presses.
+            if (!(tokens >> step.count))
+                step.count = (step.type == StepType::PRESS ? 1 : 0);
+        }
+        else {
+            step.count = 0;
+        }
+
+        Input input;
+        InputConfig* config {InputManager::getInstance().getInputConfigByDevice(DEVICE_KEYBOARD)};
+        if (step.count < 1 ||
+            (step.type != StepType::WAIT && !config->getInputByName(step.button, &input))) {
+            LOG(LogError) << "Benchmark: Invalid entry on line " << lineNumber << " of "
+                          << source << ": \"" << line << "\"";
+            return false;
+        }
+
+        mSteps.emplace_back(step);
+    }
+
+    if (mSteps.empty()) {
+        LOG(LogError) << "Benchmark: No steps defined in " << source;
+        return false;
+    }
+
+    return true;
+}
+
+void Benchmark::sendInput(const std::string& button, const bool pressed)
+{
+    InputConfig* config {InputManager::getInstance().getInputConfigByDevice(DEVICE_KEYBOARD)};
+    Input input;
+
+    if (!config->getInputByName(button, &input))
+        return;
+
+    input.value = (pressed ? 1 : 0);
+    mWindow->input(config, input);
+}
+
+void Benchmark::runFrames(const int frames)
+{
+    Renderer* renderer {Renderer::getInstance()};
+
+    for (int i {0}; i < frames; ++i) {
+        const auto startTime {std::chrono::steady_clock::now()};
+        mWindow->update(FRAME_DELTA_TIME);
+        mWindow->render();
+        mFrameTimes.emplace_back(std::chrono::duration<double, std::milli>(
+                                     std::chrono::steady_clock::now() - startTime)
+                                     .count());
+        renderer->swapBuffers();
+    }
+}
+
+void Benchmark::reportResults()
+{
+    if (mFrameTimes.empty())
+        return;
+
+    std::vector<double> sortedTimes {mFrameTimes};
+    std::sort(sortedTimes.begin(), sortedTimes.end());
+
+    auto percentile = [&sortedTimes](const double percent) {
+        const size_t index {static_cast<size_t>(percent / 100.0 *
+                                                static_cast<double>(sortedTimes.size() - 1))};
+        return sortedTimes[index];
+    };
+
+    const size_t frames {sortedTimes.size()};
+    const double mean {std::accumulate(sortedTimes.cbegin(), sortedTimes.cend(), 0.0) /
+                       static_cast<double>(frames)};
+    const RendererNull::Statistics& stats {RendererNull::getInstance()->getStatistics()};
+
+    std::stringstream results;
+    results << std::fixed << std::setprecision(3);
+    results << "Benchmark results for " << frames << " frames:\n"
+            << "  Frame time (ms): mean " << mean << ", p50 " << percentile(50.0) << ", p90 "
+            << percentile(90.0) << ", p99 " << percentile(99.0) << ", max "
+            << sortedTimes.back() << "\n"
+            << std::setprecision(1) << "  Draw calls: " << stats.drawCalls << " ("
+            << static_cast<double>(stats.drawCalls) / frames << " per frame), batched to "
+            << stats.batches << " (" << static_cast<double>(stats.batches) / frames
+            << " per frame)\n"
+            << "  Vertices: " << stats.vertices << " ("
+            << static_cast<double>(stats.vertices) / frames << " per frame)\n"
+            << "  Texture uploads: " << stats.textureUploads << " ("
+            << stats.textureUploadBytes / 1024 << " KiB), texture binds: " << stats.textureBinds
+            << "\n"
+            << "  Viewport and scissor changes: " << stats.stateChanges
+            << ", post-processing passes: " << stats.postProcessingPasses << "\n";
+
+    std::cout << results.str();
+
+    std::string line;
+    for (std::istringstream resultLines {results.str()}; std::getline(resultLines, line);)
+        LOG(LogInfo) << line;
+}
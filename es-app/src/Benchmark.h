@@ -0,0 +1,57 @@
+//  SPDX-License-Identifier: MIT
+//
+//  ES-DE
+//  Benchmark.h
+//
+//  Scripted frame time benchmark, started using the --benchmark command line option.
+//  Replays a fixed input sequence using the null renderer and reports the CPU time spent
+//  per frame along with the draw call and texture upload counts.
+//
+
+#ifndef ES_APP_BENCHMARK_H
+#define ES_APP_BENCHMARK_H
+
+#include <string>
+#include <vector>
+
+class Window;
+
+class Benchmark
+{
+public:
+    Benchmark(Window* window);
+
+    // Read the input script, an empty path selects the built-in sequence.
+    bool loadScript(const std::string& path);
+    void run();
+
+private:
+    enum class StepType {
+        WAIT,
+        PRESS,
+        HOLD
+    };
+
+    struct Step {
+        StepType type;
+        std::string button;
+        int count;
+    };
+
+    bool parseScript(const std::string& script, const std::string& source);
+    void sendInput(const std::string& button, const bool pressed);
+    void runFrames(const int frames);
+    void reportResults();
+
+    Window* mWindow;
+    std::vector<Step> mSteps;
+    // Combined Window::update() and Window::render() time in milliseconds for each frame.
+    std::vector<double> mFrameTimes;
+
+    // Frames to run between the presses of a repeated button press.
+    static inline const int PRESS_INTERVAL {12};
+    // Fixed delta time passed to Window::update() so every run is deterministic.
+    static inline const int FRAME_DELTA_TIME {16};
+};
+
+#endif // ES_APP_BENCHMARK_H
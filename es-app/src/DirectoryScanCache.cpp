@@ -0,0 +1,237 @@
+//  SPDX-License-Identifier: MIT
+//
+//  ES-DE
+//  DirectoryScanCache.cpp
+//
+//  Persistent per-system cache of the ROM directory contents. Every directory is stored
+//  together with its modification time, and as long as that is unchanged the cached
+//  entries are returned instead of reading the directory and checking the file types.
+//
+
+#include "DirectoryScanCache.h"
+
+#include "Log.h"
+#include "utils/FileSystemUtil.h"
+#include "utils/SerializationUtil.h"
+#include "utils/StringUtil.h"
+
+#include <algorithm>
+#include <filesystem>
+
+namespace
+{
+    const char cacheFileMagic[4] {'E', 'S', 'D', 'C'};
+    const unsigned int cacheFileVersion {1};
+
+    const unsigned char flagDirectory {0x01};
+    const unsigned char flagSymlink {0x02};
+    const unsigned char flagHidden {0x04};
+} // namespace
+
+DirectoryScanCache::DirectoryScanCache(const std::string& systemName,
+                                       const std::string& startPath)
+    : mCacheFile {Utils::FileSystem::getAppDataDirectory() + "/cache/scan/" + systemName +
+                  ".bin"}
+    , mStartPath {startPath}
+    , mCachedDirCount {0}
+    , mScannedDirCount {0}
+    , mChanged {false}
+{
+}
+
+void DirectoryScanCache::load()
+{
+    mDirectories.clear();
+
+    std::string buffer;
+    size_t offset {0};
+    std::string startPath;
+    unsigned int dirCount {0};
+
+    if (!Utils::Serialization::readFile(mCacheFile, buffer) ||
+        !Utils::Serialization::readHeader(buffer, offset, cacheFileMagic, cacheFileVersion))
+        return;
+
+    // The ROM directory for the system may have been changed in es_systems.xml.
+    if (!Utils::Serialization::readString(buffer, offset, startPath) || startPath != mStartPath)
+        return;
+
+    if (!Utils::Serialization::readValue<unsigned int>(buffer, offset, dirCount))
+        return;
+
+    for (unsigned int i {0}; i < dirCount; ++i) {
+        std::string relativePath;
+        Directory directory {};
+        unsigned int entryCount {0};
+
+        if (!Utils::Serialization::readString(buffer, offset, relativePath) ||
+            !Utils::Serialization::readValue<long long>(buffer, offset, directory.writeTime) ||
+            !Utils::Serialization::readValue<unsigned int>(buffer, offset, entryCount)) {
+            LOG(LogWarning) << "DirectoryScanCache: Cache file \"" << mCacheFile
+                            << "\" is invalid, ignoring it";
+            mDirectories.clear();
+            return;
+        }
+
+        directory.entries.resize(entryCount);
+        for (auto& entry : directory.entries) {
+            if (!Utils::Serialization::readString(buffer, offset, entry.name) ||
+                !Utils::Serialization::readValue<unsigned char>(buffer, offset, entry.flags)) {
+                LOG(LogWarning) << "DirectoryScanCache: Cache file \"" << mCacheFile
+                                << "\" is invalid, ignoring it";
+                mDirectories.clear();
+                return;
+            }
+        }
+
+        mDirectories[relativePath] = std::move(directory);
+    }
+}
+
+void DirectoryScanCache::save()
+{
+    std::unique_lock<std::mutex> lock {mMutex};
+
+    // Prune directories that no longer exist or that are not part of the scan any longer.
+    for (auto it = mDirectories.begin(); it != mDirectories.end();) {
+        if (!(*it).second.visited) {
+            it = mDirectories.erase(it);
+            mChanged = true;
+        }
+        else {
+            ++it;
+        }
+    }
+
+    if (!mChanged)
+        return;
+
+    std::string buffer;
+    Utils::Serialization::writeHeader(buffer, cacheFileMagic, cacheFileVersion);
+    Utils::Serialization::writeString(buffer, mStartPath);
+    Utils::Serialization::writeValue<unsigned int>(
+        buffer, static_cast<unsigned int>(mDirectories.size()));
+
+    for (auto& directory : mDirectories) {
+        Utils::Serialization::writeString(buffer, directory.first);
+        Utils::Serialization::writeValue<long long>(buffer, directory.second.writeTime);
+        Utils::Serialization::writeValue<unsigned int>(
+            buffer, static_cast<unsigned int>(directory.second.entries.size()));
+        for (auto& entry : directory.second.entries) {
+            Utils::Serialization::writeString(buffer, entry.name);
+            Utils::Serialization::writeValue<unsigned char>(buffer, entry.flags);
+        }
+    }
+
+    if (!Utils::Serialization::writeFile(mCacheFile, buffer)) {
+        LOG(LogWarning) << "DirectoryScanCache: Couldn't write to cache file \"" << mCacheFile
+                        << "\"";
+        return;
+    }
+
+    mChanged = false;
+}
+
+std::vector<DirectoryScanCache::Entry> DirectoryScanCache::getDirContent(const std::string& path)
+{
+    std::vector<Entry> content;
+    const std::string relativePath {getRelativePath(path)};
+    const long long writeTime {Utils::FileSystem::getLastWriteTime(path)};
+
+    if (writeTime == -1)
+        return content;
+
+    // Recently modified directories are neither cached nor read from the cache, as further
+    // changes could happen without changing the modification time.
+    const bool recentlyModified {Utils::FileSystem::isRecentlyModified(writeTime)};
+    bool cached {false};
+    std::vector<CachedEntry> entries;
+
+    {
+        std::unique_lock<std::mutex> lock {mMutex};
+        auto it = mDirectories.find(relativePath);
+        if (it != mDirectories.end()) {
+            (*it).second.visited = true;
+            if (!recentlyModified && (*it).second.writeTime == writeTime) {
+                entries = (*it).second.entries;
+                cached = true;
+                ++mCachedDirCount;
+            }
+        }
+    }
+
+    if (!cached) {
+        std::error_code errorCode;
+#if defined(_WIN64)
+        std::filesystem::directory_iterator dirIt {
+            Utils::String::stringToWideString(Utils::FileSystem::getGenericPath(path)),
+            errorCode};
+#else
+        std::filesystem::directory_iterator dirIt {Utils::FileSystem::getGenericPath(path),
+                                                   errorCode};
+#endif
+        for (; !errorCode && dirIt != std::filesystem::directory_iterator();
+             dirIt.increment(errorCode)) {
+            // The directory entries have the file types cached from reading the directory so
+            // in most cases no additional filesystem access is needed to find these out.
+            std::error_code typeErrorCode;
+            CachedEntry entry {};
+#if defined(_WIN64)
+            entry.name = Utils::String::wideStringToString(dirIt->path().filename().wstring());
+#else
+            entry.name = dirIt->path().filename().string();
+#endif
+            if (dirIt->is_directory(typeErrorCode))
+                entry.flags |= flagDirectory;
+#if !defined(__ANDROID__)
+            // Symlinks are generally not supported on Android.
+            if (dirIt->is_symlink(typeErrorCode))
+                entry.flags |= flagSymlink;
+#endif
+            if (Utils::FileSystem::isHidden(path + "/" + entry.name))
+                entry.flags |= flagHidden;
+
+            entries.emplace_back(std::move(entry));
+        }
+
+        if (errorCode) {
+            LOG(LogWarning) << "DirectoryScanCache: Couldn't read directory \"" << path
+                            << "\": " << errorCode.message();
+            return content;
+        }
+
+        std::sort(entries.begin(), entries.end(),
+                  [](const CachedEntry& a, const CachedEntry& b) { return a.name < b.name; });
+
+        std::unique_lock<std::mutex> lock {mMutex};
+        ++mScannedDirCount;
+        if (recentlyModified) {
+            if (mDirectories.erase(relativePath) > 0)
+                mChanged = true;
+        }
+        else {
+            Directory& directory {mDirectories[relativePath]};
+            directory.writeTime = writeTime;
+            directory.entries = entries;
+            directory.visited = true;
+            mChanged = true;
+        }
+    }
+
+    content.reserve(entries.size());
+    for (auto& entry : entries) {
+        content.emplace_back(Entry {path + "/" + entry.name, (entry.flags & flagDirectory) != 0,
+                                    (entry.flags & flagSymlink) != 0,
+                                    (entry.flags & flagHidden) != 0});
+    }
+
+    return content;
+}
+
+std::string DirectoryScanCache::getRelativePath(const std::string& path) const
+{
+    if (path.size() >= mStartPath.size() && path.compare(0, mStartPath.size(), mStartPath) == 0)
+        return path.substr(mStartPath.size());
+
+    return path;
+}
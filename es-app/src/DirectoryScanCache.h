@@ -0,0 +1,67 @@
+//  SPDX-License-Identifier: MIT
+//
+//  ES-DE
+//  DirectoryScanCache.h
+//
+//  Persistent per-system cache of the ROM directory contents. Every directory is stored
+//  together with its modification time, and as long as that is unchanged the cached
+//  entries are returned instead of reading the directory and checking the file types.
+//
+
+#ifndef ES_APP_DIRECTORY_SCAN_CACHE_H
+#define ES_APP_DIRECTORY_SCAN_CACHE_H
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class DirectoryScanCache
+{
+public:
+    struct Entry {
+        std::string path;
+        bool isDirectory;
+        bool isSymlink;
+        bool isHidden;
+    };
+
+    DirectoryScanCache(const std::string& systemName, const std::string& startPath);
+
+    // Reads the cache file from disk, an outdated or invalid file is silently ignored.
+    void load();
+    // Writes the cache file if any directory has changed since it was loaded. Directories
+    // which were not requested via getDirContent() since loading are pruned.
+    void save();
+
+    // Returns the sorted directory contents, this is safe to call from multiple threads.
+    std::vector<Entry> getDirContent(const std::string& path);
+
+    const unsigned int getCachedDirCount() const { return mCachedDirCount; }
+    const unsigned int getScannedDirCount() const { return mScannedDirCount; }
+
+private:
+    struct CachedEntry {
+        std::string name;
+        unsigned char flags;
+    };
+
+    struct Directory {
+        long long writeTime;
+        std::vector<CachedEntry> entries;
+        bool visited;
+    };
+
+    std::string getRelativePath(const std::string& path) const;
+
+    std::string mCacheFile;
+    std::string mStartPath;
+    std::unordered_map<std::string, Directory> mDirectories;
+    std::mutex mMutex;
+
+    unsigned int mCachedDirCount;
+    unsigned int mScannedDirCount;
+    bool mChanged;
+};
+
+#endif // ES_APP_DIRECTORY_SCAN_CACHE_H
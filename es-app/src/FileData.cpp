@@ -15,6 +15,7 @@
 #include "FileSorts.h"
 #include "Log.h"
 #include "MameNames.h"
+#include "MediaFileIndex.h"
 #include "Scripting.h"
 #include "SystemData.h"
 #include "UIModeController.h"
@@ -79,58 +80,79 @@ FileData::~FileData()
 const std::string& FileData::getSortName()
 {
     if (mSystem->isCustomCollection() && mType == GAME) {
-        if (!metadata.get("collectionsortname").empty())
-            return metadata.get("collectionsortname");
-        else if (!metadata.get("sortname").empty())
-            return metadata.get("sortname");
+        if (!metadata.get(MD_KEY_COLLECTIONSORTNAME).empty())
+            return metadata.get(MD_KEY_COLLECTIONSORTNAME);
+        else if (!metadata.get(MD_KEY_SORTNAME).empty())
+            return metadata.get(MD_KEY_SORTNAME);
         else
-            return metadata.get("name");
+            return metadata.get(MD_KEY_NAME);
     }
 
-    if (metadata.get("sortname").empty())
-        return metadata.get("name");
+    if (metadata.get(MD_KEY_SORTNAME).empty())
+        return metadata.get(MD_KEY_NAME);
     else
-        return metadata.get("sortname");
+        return metadata.get(MD_KEY_SORTNAME);
+}
+
+const FileData::SortKeys& FileData::getSortKeys() const
+{
+    if (mSortKeys != nullptr && mSortKeys->metadataVersion == metadata.getVersion())
+        return *mSortKeys;
+
+    if (mSortKeys == nullptr)
+        mSortKeys = std::make_unique<SortKeys>();
+
+    // We use the actual metadata name, as collection files have the system appended which
+    // messes up the order.
+    const std::string* name {&metadata.get(MD_KEY_SORTNAME)};
+    if (mSystem->isCustomCollection() && !metadata.get(MD_KEY_COLLECTIONSORTNAME).empty())
+        name = &metadata.get(MD_KEY_COLLECTIONSORTNAME);
+    if (name->empty())
+        name = &metadata.get(MD_KEY_NAME);
+
+    mSortKeys->name = Utils::String::toUpper(*name);
+    mSortKeys->developer = Utils::String::toUpper(metadata.get(MD_KEY_DEVELOPER));
+    mSortKeys->publisher = Utils::String::toUpper(metadata.get(MD_KEY_PUBLISHER));
+    mSortKeys->genre = Utils::String::toUpper(metadata.get(MD_KEY_GENRE));
+    mSortKeys->systemName = Utils::String::toUpper(mSystemName);
+
+    // If there is a range of players such as '1-4' then use the number after the dash.
+    // Any non-numeric value will end up as zero.
+    std::string players {metadata.get(MD_KEY_PLAYERS)};
+    const size_t dashPos {players.find("-")};
+    if (dashPos != std::string::npos)
+        players = players.substr(dashPos + 1, players.size() - dashPos - 1);
+    mSortKeys->players = 0;
+    if (!players.empty() && std::all_of(players.begin(), players.end(), ::isdigit))
+        mSortKeys->players = static_cast<unsigned int>(std::stoul(players));
+
+    mSortKeys->metadataVersion = metadata.getVersion();
+    return *mSortKeys;
 }
 
 const bool FileData::getFavorite()
 {
-    if (metadata.get("favorite") == "true")
-        return true;
-    else
-        return false;
+    return metadata.getBool(MD_KEY_FAVORITE);
 }
 
 const bool FileData::getKidgame()
 {
-    if (metadata.get("kidgame") == "true")
-        return true;
-    else
-        return false;
+    return metadata.getBool(MD_KEY_KIDGAME);
 }
 
 const bool FileData::getHidden()
 {
-    if (metadata.get("hidden") == "true")
-        return true;
-    else
-        return false;
+    return metadata.getBool(MD_KEY_HIDDEN);
 }
 
 const bool FileData::getCountAsGame()
 {
-    if (metadata.get("nogamecount") == "true")
-        return false;
-    else
-        return true;
+    return !metadata.getBool(MD_KEY_NOGAMECOUNT);
 }
 
 const bool FileData::getExcludeFromScraper()
 {
-    if (metadata.get("nomultiscrape") == "true")
-        return true;
-    else
-        return false;
+    return metadata.getBool(MD_KEY_NOMULTISCRAPE);
 }
 
 const std::vector<FileData*> FileData::getChildrenRecursive() const
@@ -217,17 +239,10 @@ const std::string FileData::getMediafilePath(const std::string& subdirectory) co
         subFolders =
             Utils::String::replace(Utils::FileSystem::getParent(mPath), mEnvData->mStartPath, "");
 
-    const std::string tempPath {getMediaDirectory() + mSystemName + "/" + subdirectory +
-                                subFolders + "/" + getDisplayName()};
-
     // Look for an image file in the media directory.
-    for (auto& extension : sImageExtensions) {
-        const std::string mediaPath {tempPath + extension};
-        if (Utils::FileSystem::exists(mediaPath))
-            return mediaPath;
-    }
-
-    return "";
+    return MediaFileIndex::getInstance().findFile(
+        getMediaDirectory() + mSystemName + "/" + subdirectory + subFolders, getDisplayName(),
+        sImageExtensions);
 }
 
 const std::string FileData::getImagePath() const
@@ -321,17 +336,10 @@ const std::string FileData::getVideoPath() const
         subFolders =
             Utils::String::replace(Utils::FileSystem::getParent(mPath), mEnvData->mStartPath, "");
 
-    const std::string tempPath {getMediaDirectory() + mSystemName + "/videos" + subFolders + "/" +
-                                getDisplayName()};
-
     // Look for media in the media directory.
-    for (auto& extension : sVideoExtensions) {
-        const std::string mediaPath {tempPath + extension};
-        if (Utils::FileSystem::exists(mediaPath))
-            return mediaPath;
-    }
-
-    return "";
+    return MediaFileIndex::getInstance().findFile(
+        getMediaDirectory() + mSystemName + "/videos" + subFolders, getDisplayName(),
+        sVideoExtensions);
 }
 
 const std::string FileData::getManualPath() const
@@ -344,17 +352,9 @@ const std::string FileData::getManualPath() const
         subFolders =
             Utils::String::replace(Utils::FileSystem::getParent(mPath), mEnvData->mStartPath, "");
 
-    const std::string tempPath {getMediaDirectory() + mSystemName + "/manuals" + subFolders + "/" +
-                                getDisplayName()};
-
     // Look for manuals in the media directory.
-    for (size_t i {0}; i < extList.size(); ++i) {
-        std::string mediaPath {tempPath + extList[i]};
-        if (Utils::FileSystem::exists(mediaPath))
-            return mediaPath;
-    }
-
-    return "";
+    return MediaFileIndex::getInstance().findFile(
+        getMediaDirectory() + mSystemName + "/manuals" + subFolders, getDisplayName(), extList);
 }
 
 const std::vector<FileData*>& FileData::getChildrenListToDisplay()
@@ -485,13 +485,36 @@ void FileData::removeChild(FileData* file)
     assert(false);
 }
 
+void FileData::sortFiles(std::vector<FileData*>& files, ComparisonFunction* comparator)
+{
+    if (comparator != &FileSorts::compareName && comparator != &FileSorts::compareNameDescending) {
+        std::stable_sort(files.begin(), files.end(), comparator);
+        return;
+    }
+
+    std::vector<std::pair<const std::string*, FileData*>> keys;
+    keys.reserve(files.size());
+    for (FileData* file : files)
+        keys.emplace_back(&file->getSortKeys().name, file);
+
+    if (comparator == &FileSorts::compareName)
+        std::stable_sort(keys.begin(), keys.end(),
+                         [](const auto& a, const auto& b) { return *a.first < *b.first; });
+    else
+        std::stable_sort(keys.begin(), keys.end(),
+                         [](const auto& a, const auto& b) { return *a.first > *b.first; });
+
+    for (size_t i {0}; i < keys.size(); ++i)
+        files[i] = keys[i].second;
+}
+
 void FileData::sort(ComparisonFunction& comparator,
                     std::pair<unsigned int, unsigned int>& gameCount)
 {
     mOnlyFolders = true;
     mHasFolders = false;
-    bool foldersOnTop {Settings::getInstance()->getBool("FoldersOnTop")};
-    bool showHiddenGames {Settings::getInstance()->getBool("ShowHiddenGames")};
+    bool foldersOnTop {Settings::getInstance()->getBool(Settings::BoolID::FOLDERS_ON_TOP)};
+    bool showHiddenGames {Settings::getInstance()->getBool(Settings::BoolID::SHOW_HIDDEN_GAMES)};
     bool isKidMode {UIModeController::getInstance()->isUIModeKid()};
     std::vector<FileData*> mChildrenFolders;
     std::vector<FileData*> mChildrenOthers;
@@ -546,18 +569,16 @@ void FileData::sort(ComparisonFunction& comparator,
 
         // If the requested sorting is not by name, then sort in ascending name order as a first
         // step, in order to get a correct secondary sorting.
-        if (getSortTypeFromString("name, ascending").comparisonFunction != comparator &&
-            getSortTypeFromString("name, descending").comparisonFunction != comparator) {
-            std::stable_sort(mChildrenFolders.begin(), mChildrenFolders.end(),
-                             getSortTypeFromString("name, ascending").comparisonFunction);
-            std::stable_sort(mChildrenOthers.begin(), mChildrenOthers.end(),
-                             getSortTypeFromString("name, ascending").comparisonFunction);
+        if (&FileSorts::compareName != comparator &&
+            &FileSorts::compareNameDescending != comparator) {
+            sortFiles(mChildrenFolders, &FileSorts::compareName);
+            sortFiles(mChildrenOthers, &FileSorts::compareName);
         }
 
         if (foldersOnTop)
-            std::stable_sort(mChildrenFolders.begin(), mChildrenFolders.end(), comparator);
+            sortFiles(mChildrenFolders, &comparator);
 
-        std::stable_sort(mChildrenOthers.begin(), mChildrenOthers.end(), comparator);
+        sortFiles(mChildrenOthers, &comparator);
 
         mChildren.erase(mChildren.begin(), mChildren.end());
         mChildren.reserve(mChildrenFolders.size() + mChildrenOthers.size());
@@ -567,12 +588,11 @@ void FileData::sort(ComparisonFunction& comparator,
     else {
         // If the requested sorting is not by name, then sort in ascending name order as a first
         // step, in order to get a correct secondary sorting.
-        if (getSortTypeFromString("name, ascending").comparisonFunction != comparator &&
-            getSortTypeFromString("name, descending").comparisonFunction != comparator)
-            std::stable_sort(mChildren.begin(), mChildren.end(),
-                             getSortTypeFromString("name, ascending").comparisonFunction);
+        if (&FileSorts::compareName != comparator &&
+            &FileSorts::compareNameDescending != comparator)
+            sortFiles(mChildren, &FileSorts::compareName);
 
-        std::stable_sort(mChildren.begin(), mChildren.end(), comparator);
+        sortFiles(mChildren, &comparator);
     }
 
     for (auto it = mChildren.cbegin(); it != mChildren.cend(); ++it) {
@@ -604,8 +624,8 @@ void FileData::sortFavoritesOnTop(ComparisonFunction& comparator,
 {
     mOnlyFolders = true;
     mHasFolders = false;
-    bool foldersOnTop {Settings::getInstance()->getBool("FoldersOnTop")};
-    bool showHiddenGames {Settings::getInstance()->getBool("ShowHiddenGames")};
+    bool foldersOnTop {Settings::getInstance()->getBool(Settings::BoolID::FOLDERS_ON_TOP)};
+    bool showHiddenGames {Settings::getInstance()->getBool(Settings::BoolID::SHOW_HIDDEN_GAMES)};
     bool isKidMode {UIModeController::getInstance()->isUIModeKid()};
     std::vector<FileData*> mChildrenFolders;
     std::vector<FileData*> mChildrenFavoritesFolders;
@@ -682,32 +702,26 @@ void FileData::sortFavoritesOnTop(ComparisonFunction& comparator,
                                 mChildrenFavoritesFolders.end());
         mChildrenFavoritesFolders.erase(mChildrenFavoritesFolders.begin(),
                                         mChildrenFavoritesFolders.end());
-        std::stable_sort(mChildrenFolders.begin(), mChildrenFolders.end(),
-                         getSortTypeFromString("name, ascending").comparisonFunction);
+        sortFiles(mChildrenFolders, &FileSorts::compareName);
     }
 
     // If the requested sorting is not by name, then sort in ascending name order as a first
     // step, in order to get a correct secondary sorting.
-    if (getSortTypeFromString("name, ascending").comparisonFunction != comparator &&
-        getSortTypeFromString("name, descending").comparisonFunction != comparator) {
-        std::stable_sort(mChildrenFolders.begin(), mChildrenFolders.end(),
-                         getSortTypeFromString("name, ascending").comparisonFunction);
-        std::stable_sort(mChildrenFavoritesFolders.begin(), mChildrenFavoritesFolders.end(),
-                         getSortTypeFromString("name, ascending").comparisonFunction);
-        std::stable_sort(mChildrenFavorites.begin(), mChildrenFavorites.end(),
-                         getSortTypeFromString("name, ascending").comparisonFunction);
-        std::stable_sort(mChildrenOthers.begin(), mChildrenOthers.end(),
-                         getSortTypeFromString("name, ascending").comparisonFunction);
+    if (&FileSorts::compareName != comparator &&
+        &FileSorts::compareNameDescending != comparator) {
+        sortFiles(mChildrenFolders, &FileSorts::compareName);
+        sortFiles(mChildrenFavoritesFolders, &FileSorts::compareName);
+        sortFiles(mChildrenFavorites, &FileSorts::compareName);
+        sortFiles(mChildrenOthers, &FileSorts::compareName);
     }
 
     // Sort favorite games and the other games separately.
     if (foldersOnTop) {
-        std::stable_sort(mChildrenFavoritesFolders.begin(), mChildrenFavoritesFolders.end(),
-                         comparator);
-        std::stable_sort(mChildrenFolders.begin(), mChildrenFolders.end(), comparator);
+        sortFiles(mChildrenFavoritesFolders, &comparator);
+        sortFiles(mChildrenFolders, &comparator);
     }
-    std::stable_sort(mChildrenFavorites.begin(), mChildrenFavorites.end(), comparator);
-    std::stable_sort(mChildrenOthers.begin(), mChildrenOthers.end(), comparator);
+    sortFiles(mChildrenFavorites, &comparator);
+    sortFiles(mChildrenOthers, &comparator);
 
     // Iterate through any child favorite folders.
     for (auto it = mChildrenFavoritesFolders.cbegin(); // Line break.
@@ -790,7 +804,7 @@ void FileData::updateLastPlayedList()
     std::stable_sort(mChildrenLastPlayed.begin(), mChildrenLastPlayed.end());
     std::sort(std::begin(mChildrenLastPlayed), std::end(mChildrenLastPlayed),
               [](FileData* a, FileData* b) {
-                  return a->metadata.get("lastplayed") > b->metadata.get("lastplayed");
+                  return a->metadata.get(MD_KEY_LASTPLAYED) > b->metadata.get(MD_KEY_LASTPLAYED);
               });
 }
 
@@ -808,7 +822,8 @@ void FileData::updateMostPlayedList()
     std::stable_sort(mChildrenMostPlayed.begin(), mChildrenMostPlayed.end());
     std::sort(std::begin(mChildrenMostPlayed), std::end(mChildrenMostPlayed),
               [](FileData* a, FileData* b) {
-                  return a->metadata.getInt("playcount") > b->metadata.getInt("playcount");
+                  return a->metadata.getInt(MD_KEY_PLAYCOUNT) >
+                         b->metadata.getInt(MD_KEY_PLAYCOUNT);
               });
 }
 
@@ -18,6 +18,7 @@
 #include "utils/StringUtil.h"
 
 #include <functional>
+#include <memory>
 #include <unordered_map>
 
 enum FileType {
@@ -39,6 +40,20 @@ public:
 
     const std::string& getName() { return metadata.get("name"); }
     const std::string& getSortName();
+
+    // Sort keys in uppercase, used by the comparators in FileSorts. These are cached as doing
+    // the case conversion on every comparison is very slow for large collections. The cache is
+    // refreshed when the metadata has been modified.
+    struct SortKeys {
+        std::string name;
+        std::string developer;
+        std::string publisher;
+        std::string genre;
+        std::string systemName;
+        unsigned int players;
+        unsigned long long metadataVersion;
+    };
+    const SortKeys& getSortKeys() const;
     // Returns our best guess at the "real" name for this file.
     std::string getDisplayName() const { return Utils::FileSystem::getStem(mPath); }
     std::string getCleanName() const
@@ -145,6 +160,9 @@ public:
     void sortFavoritesOnTop(ComparisonFunction& comparator,
                             std::pair<unsigned int, unsigned int>& gameCount);
     void sort(const SortType& type, bool mFavoritesOnTop = false);
+    // Stable sort which extracts the sort keys once per file instead of once per comparison
+    // when sorting by name, otherwise the comparator is used as-is.
+    static void sortFiles(std::vector<FileData*>& files, ComparisonFunction* comparator);
     MetaDataList metadata;
     // Only count the games, a cheaper alternative to a full sort when that is not required.
     void countGames(std::pair<unsigned int, unsigned int>& gameCount);
@@ -171,6 +189,7 @@ private:
     std::vector<FileData*> mChildrenLastPlayed;
     std::vector<FileData*> mChildrenMostPlayed;
     std::function<void()> mUpdateListCallback;
+    mutable std::unique_ptr<SortKeys> mSortKeys;
     static inline std::vector<std::string> sImageExtensions {".png", ".jpg"};
     static inline std::vector<std::string> sVideoExtensions {".mp4", ".mkv", ".avi",
                                                              ".mp4", ".wmv", ".mov"};
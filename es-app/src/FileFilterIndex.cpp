@@ -34,6 +34,9 @@ FileFilterIndex::FileFilterIndex()
     , mFilterByBroken {false}
     , mFilterByController {false}
     , mFilterByAltemulator {false}
+    , mResultGeneration {1}
+    , mNarrowedGeneration {0}
+    , mResultsKidMode {false}
 {
     clearAllFilters();
 
@@ -123,6 +126,13 @@ void FileFilterIndex::resetIndex()
     clearIndex(mBrokenIndexAllKeys);
     clearIndex(mControllerIndexAllKeys);
     clearIndex(mAltemulatorIndexAllKeys);
+
+    mGameFilterKeys.clear();
+    for (int i {0}; i < FILTER_TYPE_COUNT; ++i) {
+        mKeyIDs[i].clear();
+        mFilteredKeyIDs[i].clear();
+    }
+    invalidateResults();
 }
 
 std::string FileFilterIndex::getIndexableKey(FileData* game,
@@ -278,6 +288,8 @@ void FileFilterIndex::removeFromIndex(FileData* game)
     manageBrokenEntryInIndex(game, true);
     manageControllerEntryInIndex(game, true);
     manageAltemulatorEntryInIndex(game, true);
+
+    mGameFilterKeys.erase(game);
 }
 
 void FileFilterIndex::setFilter(FilterIndexType type, std::vector<std::string>* values)
@@ -300,20 +312,44 @@ void FileFilterIndex::setFilter(FilterIndexType type, std::vector<std::string>*
                         filterData.currentFilteredKeys->push_back(std::string(*vit));
                     }
                 }
+
+                std::vector<bool>& filteredKeyIDs {mFilteredKeyIDs[type]};
+                filteredKeyIDs.clear();
+                for (auto& key : *filterData.currentFilteredKeys) {
+                    const int keyID {getKeyID(type, key)};
+                    if (keyID >= static_cast<int>(filteredKeyIDs.size()))
+                        filteredKeyIDs.resize(keyID + 1, false);
+                    filteredKeyIDs[keyID] = true;
+                }
             }
         }
+        invalidateResults();
     }
     return;
 }
 
 void FileFilterIndex::setTextFilter(std::string textFilter)
 {
-    mTextFilter = textFilter;
+    const std::string textFilterUpper {Utils::String::toUpper(textFilter)};
 
     if (textFilter == "")
         mFilterByText = false;
     else
         mFilterByText = true;
+
+    if (textFilterUpper == mTextFilterUpper) {
+        mTextFilter = textFilter;
+        return;
+    }
+
+    // When typing in the filter text box characters are normally only added, in which case
+    // the games that didn't match the previous text can't match the new text either.
+    const bool narrowed {!mTextFilterUpper.empty() &&
+                         textFilterUpper.find(mTextFilterUpper) != std::string::npos};
+
+    mTextFilter = textFilter;
+    mTextFilterUpper = textFilterUpper;
+    invalidateResults(narrowed);
 }
 
 void FileFilterIndex::clearAllFilters()
@@ -323,8 +359,10 @@ void FileFilterIndex::clearAllFilters()
         FilterDataDecl filterData = (*it);
         *(filterData.filteredByRef) = false;
         filterData.currentFilteredKeys->clear();
+        mFilteredKeyIDs[filterData.type].clear();
     }
     setTextFilter("");
+    invalidateResults();
     return;
 }
 
@@ -385,53 +423,101 @@ void FileFilterIndex::debugPrintIndexes()
 }
 
 bool FileFilterIndex::showFile(FileData* game)
+{
+    const bool isKidMode {UIModeController::getInstance()->isUIModeKid()};
+
+    if (isKidMode != mResultsKidMode) {
+        mResultsKidMode = isKidMode;
+        invalidateResults();
+    }
+
+    return showGame(game, isKidMode);
+}
+
+bool FileFilterIndex::showGame(FileData* game, bool isKidMode)
 {
     // If folder, needs further inspection - i.e. see if folder contains at least one element
     // that should be shown.
     if (game->getType() == FOLDER) {
-        std::vector<FileData*> children = game->getChildren();
-        // Iterate through all of the children, until there's a match.
-        for (std::vector<FileData*>::const_iterator it = children.cbegin(); it != children.cend();
-             ++it) {
-            if (showFile(*it))
+        for (FileData* child : game->getChildren()) {
+            if (showGame(child, isKidMode))
                 return true;
         }
         return false;
     }
 
-    bool nameMatch = false;
-    bool keepGoing = false;
+    GameFilterKeys& keys {getGameFilterKeys(game)};
+
+    if (keys.resultGeneration == mResultGeneration)
+        return keys.result;
+
+    // If the text filter was narrowed down then games that were filtered out before are
+    // still filtered out, so only the previously shown games need to be tested again.
+    if (mNarrowedGeneration == 0 || keys.resultGeneration != mNarrowedGeneration || keys.result)
+        keys.result = evaluateFilters(keys, isKidMode);
+
+    keys.resultGeneration = mResultGeneration;
+    return keys.result;
+}
+
+FileFilterIndex::GameFilterKeys& FileFilterIndex::getGameFilterKeys(FileData* game)
+{
+    auto it = mGameFilterKeys.find(game);
+    if (it != mGameFilterKeys.end() && (*it).second.metadataVersion == game->metadata.getVersion())
+        return (*it).second;
+
+    GameFilterKeys& keys {mGameFilterKeys[game]};
+    keys.primaryKeys.fill(-1);
+    keys.secondaryKeys.fill(-1);
+
+    for (auto& filterData : filterDataDecl) {
+        keys.primaryKeys[filterData.type] =
+            getKeyID(filterData.type, getIndexableKey(game, filterData.type, false));
+        if (filterData.hasSecondaryKey) {
+            const std::string secKey {getIndexableKey(game, filterData.type, true)};
+            if (secKey != UNKNOWN_LABEL)
+                keys.secondaryKeys[filterData.type] = getKeyID(filterData.type, secKey);
+        }
+    }
+
+    keys.name = Utils::String::toUpper(game->getName());
+    keys.kidGame = (getIndexableKey(game, KIDGAME_FILTER, false) != "FALSE");
+    keys.metadataVersion = game->metadata.getVersion();
+    keys.resultGeneration = 0;
+    keys.result = false;
 
+    return keys;
+}
+
+bool FileFilterIndex::evaluateFilters(const GameFilterKeys& keys, bool isKidMode)
+{
     // Name filters take precedence over all other filters, so if there is no match for
     // the game name, then always return false.
-    if (mTextFilter != "" &&
-        !(Utils::String::toUpper(game->getName()).find(Utils::String::toUpper(mTextFilter)) !=
-          std::string::npos)) {
+    if (mFilterByText && keys.name.find(mTextFilterUpper) == std::string::npos)
         return false;
-    }
 
-    if (mTextFilter != "")
-        nameMatch = true;
+    auto isKeyIDFiltered = [this](FilterIndexType type, int keyID) {
+        return keyID >= 0 && keyID < static_cast<int>(mFilteredKeyIDs[type].size()) &&
+               mFilteredKeyIDs[type][keyID];
+    };
 
-    for (std::vector<FilterDataDecl>::const_iterator it = filterDataDecl.cbegin();
-         it != filterDataDecl.cend(); ++it) {
-        FilterDataDecl filterData = (*it);
-        if (filterData.primaryKey == "kidgame" && UIModeController::getInstance()->isUIModeKid()) {
-            return (getIndexableKey(game, filterData.type, false) != "FALSE");
+    bool keepGoing {false};
+
+    for (auto& filterData : filterDataDecl) {
+        if (filterData.type == KIDGAME_FILTER && isKidMode) {
+            return keys.kidGame;
         }
         else if (*(filterData.filteredByRef)) {
             // Try to find a match.
-            std::string key = getIndexableKey(game, filterData.type, false);
-            keepGoing = isKeyBeingFilteredBy(key, filterData.type);
+            keepGoing = isKeyIDFiltered(filterData.type, keys.primaryKeys[filterData.type]);
 
             // If we didn't find a match, try for secondary keys - i.e.
             // publisher and dev, or first genre.
             if (!keepGoing) {
                 if (!filterData.hasSecondaryKey)
                     return false;
-                std::string secKey = getIndexableKey(game, filterData.type, true);
-                if (secKey != UNKNOWN_LABEL)
-                    keepGoing = isKeyBeingFilteredBy(secKey, filterData.type);
+                keepGoing =
+                    isKeyIDFiltered(filterData.type, keys.secondaryKeys[filterData.type]);
             }
             // If still nothing, then it's not a match.
             if (!keepGoing)
@@ -441,10 +527,24 @@ bool FileFilterIndex::showFile(FileData* game)
 
     // If there is a match for the game name, but not for any other filters, then return
     // true as it means that the name filter is the only applied filter.
-    if (!keepGoing && nameMatch)
-        return true;
-    else
-        return keepGoing;
+    return keepGoing || mFilterByText;
+}
+
+int FileFilterIndex::getKeyID(FilterIndexType type, const std::string& key)
+{
+    auto it = mKeyIDs[type].find(key);
+    if (it != mKeyIDs[type].end())
+        return (*it).second;
+
+    const int keyID {static_cast<int>(mKeyIDs[type].size())};
+    mKeyIDs[type][key] = keyID;
+    return keyID;
+}
+
+void FileFilterIndex::invalidateResults(bool textFilterNarrowed)
+{
+    mNarrowedGeneration = (textFilterNarrowed ? mResultGeneration : 0);
+    ++mResultGeneration;
 }
 
 bool FileFilterIndex::isFiltered()
@@ -13,8 +13,10 @@
 #include <sstream>
 #endif
 
+#include <array>
 #include <map>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 class FileData;
@@ -69,9 +71,31 @@ public:
     void setKidModeFilters();
 
 private:
+    static constexpr int FILTER_TYPE_COUNT {ALTEMULATOR_FILTER + 1};
+
+    // The filter keys of a game mapped to IDs, so that the filters can be evaluated without
+    // building any strings. The last result for the game is cached as well.
+    struct GameFilterKeys {
+        std::array<int, FILTER_TYPE_COUNT> primaryKeys;
+        std::array<int, FILTER_TYPE_COUNT> secondaryKeys;
+        std::string name;
+        unsigned long long metadataVersion;
+        unsigned int resultGeneration;
+        bool kidGame;
+        bool result;
+    };
+
     std::vector<FilterDataDecl> filterDataDecl;
     std::string getIndexableKey(FileData* game, FilterIndexType type, bool getSecondary);
 
+    bool showGame(FileData* game, bool isKidMode);
+    GameFilterKeys& getGameFilterKeys(FileData* game);
+    bool evaluateFilters(const GameFilterKeys& keys, bool isKidMode);
+    int getKeyID(FilterIndexType type, const std::string& key);
+    // Invalidates all cached results. If the text filter was narrowed down and nothing else
+    // changed, then the games that were previously filtered out don't need to be tested again.
+    void invalidateResults(bool textFilterNarrowed = false);
+
     void manageRatingsEntryInIndex(FileData* game, bool remove = false);
     void manageDeveloperEntryInIndex(FileData* game, bool remove = false);
     void managePublisherEntryInIndex(FileData* game, bool remove = false);
@@ -90,6 +114,7 @@ private:
     void clearIndex(std::map<std::string, int>& indexMap) { indexMap.clear(); }
 
     std::string mTextFilter;
+    std::string mTextFilterUpper;
     bool mFilterByText;
 
     bool mFilterByRatings;
@@ -130,6 +155,14 @@ private:
     std::vector<std::string> mBrokenIndexFilteredKeys;
     std::vector<std::string> mControllerIndexFilteredKeys;
     std::vector<std::string> mAltemulatorIndexFilteredKeys;
+
+    std::unordered_map<FileData*, GameFilterKeys> mGameFilterKeys;
+    std::array<std::unordered_map<std::string, int>, FILTER_TYPE_COUNT> mKeyIDs;
+    // Whether the key with this ID is currently being filtered for.
+    std::array<std::vector<bool>, FILTER_TYPE_COUNT> mFilteredKeyIDs;
+    unsigned int mResultGeneration;
+    unsigned int mNarrowedGeneration;
+    bool mResultsKidMode;
 };
 
 #endif // ES_APP_FILE_FILTER_INDEX_H
@@ -15,8 +15,55 @@
 #include "utils/FileSystemUtil.h"
 #include "utils/StringUtil.h"
 
+#include <fstream>
 #include <pugixml.hpp>
 
+namespace
+{
+    // Looks up a gamelist.xml path in the file tree that was created when scanning the ROM
+    // directory, without accessing the filesystem. Only paths relative to the system directory
+    // are handled, for anything else nullptr is returned and the caller has to fall back to
+    // resolving the path. The key argument is a scratch buffer which is reused between calls.
+    FileData* findScannedFile(FileData* root, const char* path, std::string& key)
+    {
+        if (path[0] != '.' || path[1] != '/')
+            return nullptr;
+
+        FileData* treeNode {root};
+        const char* component {path + 2};
+
+        while (true) {
+            if (treeNode->getType() != FOLDER)
+                return nullptr;
+
+            const char* end {component};
+            while (*end != '\0' && *end != '/')
+                ++end;
+
+            // Empty components and dot entries need proper path resolution.
+            const size_t length {static_cast<size_t>(end - component)};
+            if (length == 0 ||
+                (component[0] == '.' && (length == 1 || (length == 2 && component[1] == '.'))))
+                return nullptr;
+
+            key.assign(component, end);
+            const std::unordered_map<std::string, FileData*>& children {
+                treeNode->getChildrenByFilename()};
+            const auto it = children.find(key);
+
+            if (it == children.cend())
+                return nullptr;
+
+            treeNode = (*it).second;
+
+            if (*end == '\0')
+                return treeNode;
+
+            component = end + 1;
+        }
+    }
+} // namespace
+
 namespace GamelistFileParser
 {
     FileData* findOrCreateFile(SystemData* system, const std::string& path, FileType type)
@@ -148,13 +195,21 @@ namespace GamelistFileParser
         LOG(LogInfo) << "Parsing gamelist file \"" << xmlpath << "\"...";
 #endif
 
-        pugi::xml_document doc;
+        // Read the file into a single buffer which is then parsed in place, so the node names
+        // and values point directly into this buffer instead of being copied.
 #if defined(_WIN64)
-        const pugi::xml_parse_result& result {
-            doc.load_file(Utils::String::stringToWideString(xmlpath).c_str())};
+        std::ifstream stream {Utils::String::stringToWideString(xmlpath).c_str(),
+                              std::ios::binary};
 #else
-        const pugi::xml_parse_result& result {doc.load_file(xmlpath.c_str())};
+        std::ifstream stream {xmlpath, std::ios::binary};
 #endif
+        std::string buffer {std::istreambuf_iterator<char>(stream),
+                            std::istreambuf_iterator<char>()};
+        stream.close();
+
+        pugi::xml_document doc;
+        const pugi::xml_parse_result& result {
+            doc.load_buffer_inplace(&buffer[0], buffer.size())};
 
         if (!result) {
             LOG(LogError) << "Error parsing gamelist file \"" << xmlpath
@@ -195,7 +250,18 @@ namespace GamelistFileParser
         }
 
         const std::string& relativeTo {system->getStartPath()};
-        const bool showHiddenFiles {Settings::getInstance()->getBool("ShowHiddenFiles")};
+        const bool showHiddenFiles {
+            Settings::getInstance()->getBool(Settings::BoolID::SHOW_HIDDEN_FILES)};
+        const bool showHiddenGames {
+            Settings::getInstance()->getBool(Settings::BoolID::SHOW_HIDDEN_GAMES)};
+
+        // The ROM directory scan has already checked that the files in the tree exist and that
+        // they are not hidden, so they can be looked up directly. This is not possible if the
+        // folders are flattened as the tree then doesn't match the directory structure.
+        const bool lookupScannedFiles {
+            !trustGamelist && !system->getFlattenFolders() &&
+            (showHiddenFiles || !Utils::FileSystem::isHidden(system->getStartPath()))};
+        std::string key;
 
         const std::vector<std::string> tagList {"game", "folder"};
         const FileType typeList[2] = {GAME, FOLDER};
@@ -205,31 +271,43 @@ namespace GamelistFileParser
             FileType type {typeList[i]};
             for (pugi::xml_node fileNode {root.child(tag.c_str())}; fileNode;
                  fileNode = fileNode.next_sibling(tag.c_str())) {
-                const std::string& path {Utils::FileSystem::resolveRelativePath(
-                    fileNode.child("path").text().get(), relativeTo, false)};
+                const char* gamelistPath {fileNode.child("path").text().get()};
+                FileData* file {nullptr};
+                std::string path;
+
+                if (lookupScannedFiles)
+                    file = findScannedFile(system->getRootFolder(), gamelistPath, key);
+
+                if (file != nullptr) {
+                    path = file->getPath();
+                }
+                else {
+                    path = Utils::FileSystem::resolveRelativePath(gamelistPath, relativeTo, false);
 
-                if (!trustGamelist && !Utils::FileSystem::exists(path)) {
+                    if (!trustGamelist && !Utils::FileSystem::exists(path)) {
 #if defined(_WIN64)
-                    LOG(LogWarning) << (type == GAME ? "File \"" : "Folder \"")
-                                    << Utils::String::replace(path, "/", "\\")
+                        LOG(LogWarning) << (type == GAME ? "File \"" : "Folder \"")
+                                        << Utils::String::replace(path, "/", "\\")
 #else
-                    LOG(LogWarning) << (type == GAME ? "File \"" : "Folder \"") << path
+                        LOG(LogWarning) << (type == GAME ? "File \"" : "Folder \"") << path
 #endif
-                                    << "\" does not exist, skipping entry";
-                    continue;
-                }
+                                        << "\" does not exist, skipping entry";
+                        continue;
+                    }
 
-                // Skip hidden files, check both the file itself and the directory in which
-                // it is located.
-                if (!showHiddenFiles &&
-                    (Utils::FileSystem::isHidden(path) ||
-                     Utils::FileSystem::isHidden(Utils::FileSystem::getParent(path)))) {
-                    LOG(LogDebug) << "GamelistFileParser::parseGamelist(): Skipping hidden file \""
-                                  << path << "\"";
-                    continue;
-                }
+                    // Skip hidden files, check both the file itself and the directory in which
+                    // it is located.
+                    if (!showHiddenFiles &&
+                        (Utils::FileSystem::isHidden(path) ||
+                         Utils::FileSystem::isHidden(Utils::FileSystem::getParent(path)))) {
+                        LOG(LogDebug)
+                            << "GamelistFileParser::parseGamelist(): Skipping hidden file \""
+                            << path << "\"";
+                        continue;
+                    }
 
-                FileData* file {findOrCreateFile(system, path, type)};
+                    file = findOrCreateFile(system, path, type);
+                }
 
                 // Don't load entries with the wrong type. This should very rarely (if ever) happen.
                 if (file != nullptr && ((tag == "game" && file->getType() == FOLDER) ||
@@ -278,7 +356,7 @@ namespace GamelistFileParser
                 // games, then delete the entry. This leaves no trace of the entry at all in ES
                 // but that is fine as the option to show hidden files is defined as requiring an
                 // application restart.
-                if (!Settings::getInstance()->getBool("ShowHiddenGames")) {
+                if (!showHiddenGames) {
                     if (file->getHidden()) {
                         LOG(LogDebug) << "GamelistFileParser::parseGamelist(): Skipping hidden "
                                       << (type == GAME ? "file" : "folder") << " entry \""
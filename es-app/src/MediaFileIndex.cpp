@@ -0,0 +1,101 @@
+//  SPDX-License-Identifier: MIT
+//
+//  ES-DE
+//  MediaFileIndex.cpp
+//
+//  Index of the files in the game media directories. Each directory is listed on first
+//  access and the result is kept as long as the directory modification time is unchanged,
+//  so looking up a media file for a game doesn't require probing every file extension.
+//
+
+#include "MediaFileIndex.h"
+
+#include "utils/FileSystemUtil.h"
+#include "utils/StringUtil.h"
+
+#include <filesystem>
+
+MediaFileIndex& MediaFileIndex::getInstance()
+{
+    static MediaFileIndex instance;
+    return instance;
+}
+
+std::string MediaFileIndex::findFile(const std::string& directory,
+                                     const std::string& stem,
+                                     const std::vector<std::string>& extensions)
+{
+    const long long writeTime {Utils::FileSystem::getLastWriteTime(directory)};
+    const std::string basePath {directory + "/" + stem};
+
+    // The directory doesn't exist, which is common for media types that were never scraped.
+    if (writeTime == -1)
+        return "";
+
+    // Recently modified directories are not indexed as further changes could go unnoticed.
+    if (Utils::FileSystem::isRecentlyModified(writeTime)) {
+        for (auto& extension : extensions) {
+            if (Utils::FileSystem::exists(basePath + extension))
+                return basePath + extension;
+        }
+        return "";
+    }
+
+    std::unique_lock<std::mutex> lock {mMutex};
+    auto it = mDirectories.find(directory);
+
+    if (it == mDirectories.end() || (*it).second.writeTime != writeTime) {
+        // Don't hold the lock while reading the directory as it could be on a slow network
+        // share, if another thread indexes it at the same time then one result is discarded.
+        lock.unlock();
+        Directory newDirectory {writeTime, {}};
+        readDirectory(directory, newDirectory);
+        lock.lock();
+        it = mDirectories.insert_or_assign(directory, std::move(newDirectory)).first;
+    }
+
+    const Directory& index {(*it).second};
+    const std::string lowerCaseStem {Utils::String::toLower(stem)};
+
+    for (auto& extension : extensions) {
+        if (index.files.find(stem + extension) != index.files.cend())
+            return basePath + extension;
+        // Whether a filename that only differs in case matches depends on the filesystem and
+        // not on the operating system, for example vfat on Linux or case sensitive APFS on
+        // macOS, so let the filesystem decide in this case.
+        const std::string lowerCaseFile {lowerCaseStem + Utils::String::toLower(extension)};
+        if (index.lowerCaseFiles.find(lowerCaseFile) != index.lowerCaseFiles.cend() &&
+            Utils::FileSystem::exists(basePath + extension))
+            return basePath + extension;
+    }
+
+    return "";
+}
+
+void MediaFileIndex::readDirectory(const std::string& path, Directory& directory)
+{
+    std::error_code errorCode;
+#if defined(_WIN64)
+    std::filesystem::directory_iterator dirIt {
+        Utils::String::stringToWideString(Utils::FileSystem::getGenericPath(path)), errorCode};
+#else
+    std::filesystem::directory_iterator dirIt {Utils::FileSystem::getGenericPath(path),
+                                               errorCode};
+#endif
+
+    for (; !errorCode && dirIt != std::filesystem::directory_iterator();
+         dirIt.increment(errorCode)) {
+#if defined(_WIN64)
+        const std::string filename {
+            Utils::String::wideStringToString(dirIt->path().filename().wstring())};
+#else
+        const std::string filename {dirIt->path().filename().string()};
+#endif
+        directory.lowerCaseFiles.emplace(Utils::String::toLower(filename));
+        directory.files.emplace(filename);
+    }
+
+    // Force a new attempt on the next lookup if the directory couldn't be read.
+    if (errorCode)
+        directory.writeTime = -2;
+}
@@ -0,0 +1,46 @@
+//  SPDX-License-Identifier: MIT
+//
+//  ES-DE
+//  MediaFileIndex.h
+//
+//  Index of the files in the game media directories. Each directory is listed on first
+//  access and the result is kept as long as the directory modification time is unchanged,
+//  so looking up a media file for a game doesn't require probing every file extension.
+//
+
+#ifndef ES_APP_MEDIA_FILE_INDEX_H
+#define ES_APP_MEDIA_FILE_INDEX_H
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+class MediaFileIndex
+{
+public:
+    static MediaFileIndex& getInstance();
+
+    // Returns the path to directory/stem with the first extension that exists, or an empty
+    // string if there is no such file. This is safe to call from multiple threads.
+    std::string findFile(const std::string& directory,
+                         const std::string& stem,
+                         const std::vector<std::string>& extensions);
+
+private:
+    struct Directory {
+        long long writeTime;
+        std::unordered_set<std::string> files;
+        // Lowercase filenames, for files that may match depending on the filesystem.
+        std::unordered_set<std::string> lowerCaseFiles;
+    };
+
+    MediaFileIndex() {}
+    void readDirectory(const std::string& path, Directory& directory);
+
+    std::unordered_map<std::string, Directory> mDirectories;
+    std::mutex mMutex;
+};
+
+#endif // ES_APP_MEDIA_FILE_INDEX_H
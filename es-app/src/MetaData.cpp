@@ -11,8 +11,13 @@
 
 #include "Log.h"
 #include "utils/FileSystemUtil.h"
+#include "utils/TimeUtil.h"
 
+#include <atomic>
+#include <mutex>
 #include <pugixml.hpp>
+#include <string_view>
+#include <unordered_map>
 
 namespace
 {
@@ -74,6 +79,128 @@ namespace
     const std::vector<MetaDataDecl> folderMDD {
         folderDecls, folderDecls + sizeof(folderDecls) / sizeof(folderDecls[0])};
 
+    // Must be in the same order as the MetaDataKey enum.
+    const char* keyNames[MD_KEY_COUNT] {
+        "rating",
+        "releasedate",
+        "playcount",
+        "lastplayed",
+        "name",
+        "sortname",
+        "collectionsortname",
+        "desc",
+        "developer",
+        "publisher",
+        "genre",
+        "players",
+        "favorite",
+        "completed",
+        "kidgame",
+        "hidden",
+        "broken",
+        "nogamecount",
+        "nomultiscrape",
+        "hidemetadata",
+        "controller",
+        "altemulator",
+        "folderlink"};
+
+    // Maps the metadata key names to the enum values, used when parsing the gamelist.xml files.
+    std::unordered_map<std::string_view, MetaDataKey> createKeyIndex()
+    {
+        std::unordered_map<std::string_view, MetaDataKey> keyIndex;
+        for (int i {0}; i < MD_KEY_COUNT; ++i)
+            keyIndex[keyNames[i]] = static_cast<MetaDataKey>(i);
+        return keyIndex;
+    }
+
+    const std::unordered_map<std::string_view, MetaDataKey> keyIndex {createKeyIndex()};
+
+    // Values that are likely to be repeated across many games. Any empty values and all
+    // default values are pooled as well.
+    bool isPooledKey(MetaDataKey key)
+    {
+        return key == MD_KEY_RATING || key == MD_KEY_PLAYCOUNT ||
+               (key >= MD_KEY_DEVELOPER && key <= MD_KEY_ALTEMULATOR);
+    }
+
+    std::shared_ptr<const std::string> getPooledString(const std::string& value)
+    {
+        // The gamelists are parsed in parallel so the pool needs to be locked. The views in the
+        // map point to the pooled strings which are never removed.
+        static std::mutex poolMutex;
+        static std::unordered_map<std::string_view, std::shared_ptr<const std::string>> pool;
+
+        std::unique_lock<std::mutex> lock {poolMutex};
+        auto it = pool.find(value);
+        if (it != pool.cend())
+            return (*it).second;
+
+        std::shared_ptr<const std::string> pooledString {
+            std::make_shared<const std::string>(value)};
+        pool.emplace(*pooledString, pooledString);
+        return pooledString;
+    }
+
+    std::atomic<unsigned long long> versionCounter {0};
+
+    double getNumericValue(MetaDataKey key, const std::string& value)
+    {
+        switch (key) {
+            case MD_KEY_RATING:
+                return atof(value.c_str());
+            case MD_KEY_PLAYCOUNT:
+                return atoi(value.c_str());
+            case MD_KEY_RELEASEDATE:
+            case MD_KEY_LASTPLAYED:
+                // The lastplayed default value is "0" which is not a valid date.
+                if (value.size() < 8)
+                    return 0.0;
+                return static_cast<double>(Utils::Time::stringToTime(value));
+            default:
+                return 0.0;
+        }
+    }
+
+    // The key for each declaration, and the declaration for each key (or -1 if it's not
+    // declared for this metadata type). The default values are resolved once here so that
+    // constructing a MetaDataList doesn't need to lock the string pool.
+    struct KeyLayout {
+        std::vector<MetaDataKey> keys;
+        std::array<int, MD_KEY_COUNT> declarations;
+        std::array<std::shared_ptr<const std::string>, MD_KEY_COUNT> defaultValues;
+        std::array<double, MD_KEY_NUMERIC_COUNT> defaultNumericValues;
+        unsigned int defaultBoolValues;
+    };
+
+    KeyLayout createKeyLayout(const std::vector<MetaDataDecl>& mdd)
+    {
+        KeyLayout layout {};
+        layout.declarations.fill(-1);
+        for (size_t i {0}; i < mdd.size(); ++i) {
+            const auto it = keyIndex.find(mdd[i].key);
+            layout.keys.emplace_back(it == keyIndex.cend() ? MD_KEY_INVALID : (*it).second);
+            if (it == keyIndex.cend())
+                continue;
+            const MetaDataKey key {(*it).second};
+            layout.declarations[key] = static_cast<int>(i);
+            layout.defaultValues[key] = getPooledString(mdd[i].defaultValue);
+            if (key < MD_KEY_NUMERIC_COUNT)
+                layout.defaultNumericValues[key] = getNumericValue(key, mdd[i].defaultValue);
+            if (mdd[i].defaultValue == "true")
+                layout.defaultBoolValues |= 1u << key;
+        }
+        return layout;
+    }
+
+    const KeyLayout gameKeyLayout {createKeyLayout(gameMDD)};
+    const KeyLayout folderKeyLayout {createKeyLayout(folderMDD)};
+
+    const KeyLayout& getKeyLayout(MetaDataListType type)
+    {
+        return type == GAME_METADATA ? gameKeyLayout : folderKeyLayout;
+    }
+
 } // namespace
 
 const std::vector<MetaDataDecl>& getMDDByType(MetaDataListType type)
@@ -89,34 +216,53 @@ const std::vector<MetaDataDecl>& getMDDByType(MetaDataListType type)
     return gameMDD;
 }
 
+MetaDataKey getMetaDataKey(const std::string& key)
+{
+    const auto it = keyIndex.find(key);
+    return it == keyIndex.cend() ? MD_KEY_INVALID : (*it).second;
+}
+
 MetaDataList::MetaDataList(MetaDataListType type)
-    : mType(type)
-    , mWasChanged(false)
+    : mValues {getKeyLayout(type).defaultValues}
+    , mNumericValues {getKeyLayout(type).defaultNumericValues}
+    , mVersion {++versionCounter}
+    , mBoolValues {getKeyLayout(type).defaultBoolValues}
+    , mType {type}
+    , mWasChanged {false}
 {
-    const std::vector<MetaDataDecl>& mdd = getMDD();
-    for (auto it = mdd.cbegin(); it != mdd.cend(); ++it)
-        set(it->key, it->defaultValue);
 }
 
 MetaDataList MetaDataList::createFromXML(MetaDataListType type,
                                          pugi::xml_node& node,
                                          const std::string& relativeTo)
 {
+    // All entries are set to their default values by the constructor.
     MetaDataList mdl(type);
 
     const std::vector<MetaDataDecl>& mdd = mdl.getMDD();
+    const KeyLayout& layout {getKeyLayout(type)};
+    unsigned int processed {0};
+
+    // Walk the child nodes once instead of searching the node for every metadata key.
+    for (pugi::xml_node md {node.first_child()}; md; md = md.next_sibling()) {
+        const auto it = keyIndex.find(md.name());
+        if (it == keyIndex.cend())
+            continue;
+
+        const MetaDataKey key {(*it).second};
+        // Only the first occurrence of a key is used.
+        if (layout.declarations[key] == -1 || (processed & (1u << key)) != 0)
+            continue;
 
-    for (auto it = mdd.cbegin(); it != mdd.cend(); ++it) {
-        pugi::xml_node md = node.child(it->key.c_str());
-        if (md && !md.text().empty()) {
+        processed |= 1u << key;
+        const MetaDataDecl& decl {mdd[layout.declarations[key]]};
+
+        if (!md.text().empty()) {
             // If it's a path, resolve relative paths.
             std::string value = md.text().get();
-            if (it->type == MD_PATH)
+            if (decl.type == MD_PATH)
                 value = Utils::FileSystem::resolveRelativePath(value, relativeTo, true);
-            mdl.set(it->key, value);
-        }
-        else {
-            mdl.set(it->key, it->defaultValue);
+            mdl.set(key, value);
         }
     }
     return mdl;
@@ -127,50 +273,104 @@ void MetaDataList::appendToXML(pugi::xml_node& parent,
                                const std::string& relativeTo) const
 {
     const std::vector<MetaDataDecl>& mdd = getMDD();
+    const KeyLayout& layout {getKeyLayout(mType)};
 
-    for (auto it = mdd.cbegin(); it != mdd.cend(); ++it) {
-        auto mapIter = mMap.find(it->key);
-        if (mapIter != mMap.cend()) {
-            // We have this value!
-            // If it's just the default (and we ignore defaults), don't write it.
-            if (ignoreDefaults && mapIter->second == it->defaultValue)
-                continue;
+    for (size_t i {0}; i < mdd.size(); ++i) {
+        const MetaDataKey key {layout.keys[i]};
+        if (key == MD_KEY_INVALID || mValues[key] == nullptr)
+            continue;
 
-            // Try and make paths relative if we can.
-            std::string value = mapIter->second;
-            if (it->type == MD_PATH)
-                value = Utils::FileSystem::createRelativePath(value, relativeTo, true);
+        // If it's just the default (and we ignore defaults), don't write it.
+        if (ignoreDefaults && *mValues[key] == mdd[i].defaultValue)
+            continue;
 
-            parent.append_child(mapIter->first.c_str()).text().set(value.c_str());
-        }
+        // Try and make paths relative if we can.
+        std::string value = *mValues[key];
+        if (mdd[i].type == MD_PATH)
+            value = Utils::FileSystem::createRelativePath(value, relativeTo, true);
+
+        parent.append_child(mdd[i].key.c_str()).text().set(value.c_str());
     }
 }
 
 void MetaDataList::set(const std::string& key, const std::string& value)
 {
-    mMap[key] = value;
+    const MetaDataKey metaDataKey {getMetaDataKey(key)};
+
+    if (metaDataKey == MD_KEY_INVALID) {
+        LOG(LogError) << "MetaDataList::set(): Invalid metadata key \"" << key << "\"";
+        return;
+    }
+
+    set(metaDataKey, value);
+}
+
+void MetaDataList::set(MetaDataKey key, const std::string& value)
+{
+    if (value.empty() || isPooledKey(key))
+        mValues[key] = getPooledString(value);
+    else
+        mValues[key] = std::make_shared<const std::string>(value);
+
+    if (key < MD_KEY_NUMERIC_COUNT)
+        mNumericValues[key] = getNumericValue(key, value);
+
+    if (value == "true")
+        mBoolValues |= 1u << key;
+    else
+        mBoolValues &= ~(1u << key);
+
+    mVersion = ++versionCounter;
     mWasChanged = true;
 }
 
 const std::string& MetaDataList::get(const std::string& key) const
 {
     // Check that the key actually exists, otherwise return an empty string.
-    if (mMap.count(key) > 0)
-        return mMap.at(key);
+    const MetaDataKey metaDataKey {getMetaDataKey(key)};
+
+    if (metaDataKey == MD_KEY_INVALID)
+        return sNoResult;
     else
-        return mNoResult;
+        return get(metaDataKey);
 }
 
 int MetaDataList::getInt(const std::string& key) const
+{
+    const MetaDataKey metaDataKey {getMetaDataKey(key)};
+
+    if (metaDataKey == MD_KEY_INVALID)
+        return 0;
+    else
+        return getInt(metaDataKey);
+}
+
+int MetaDataList::getInt(MetaDataKey key) const
 {
     // Return integer value.
-    return atoi(get(key).c_str());
+    if (key == MD_KEY_PLAYCOUNT)
+        return static_cast<int>(mNumericValues[key]);
+    else
+        return atoi(get(key).c_str());
 }
 
 float MetaDataList::getFloat(const std::string& key) const
+{
+    const MetaDataKey metaDataKey {getMetaDataKey(key)};
+
+    if (metaDataKey == MD_KEY_INVALID)
+        return 0.0f;
+    else
+        return getFloat(metaDataKey);
+}
+
+float MetaDataList::getFloat(MetaDataKey key) const
 {
     // Return float value.
-    return static_cast<float>(atof(get(key).c_str()));
+    if (key == MD_KEY_RATING)
+        return static_cast<float>(mNumericValues[key]);
+    else
+        return static_cast<float>(atof(get(key).c_str()));
 }
 
 bool MetaDataList::wasChanged() const
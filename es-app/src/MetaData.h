@@ -14,7 +14,9 @@
 #include <sstream>
 #endif
 
-#include <map>
+#include <array>
+#include <ctime>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -55,12 +57,46 @@ struct MetaDataDecl {
     bool shouldScrape;
 };
 
+// All metadata keys, used to address the value slots in MetaDataList directly. Not all keys
+// are declared for both games and folders. The numeric keys are placed first as their values
+// are also cached as numbers.
+enum MetaDataKey {
+    MD_KEY_RATING,
+    MD_KEY_RELEASEDATE,
+    MD_KEY_PLAYCOUNT,
+    MD_KEY_LASTPLAYED,
+    MD_KEY_NAME,
+    MD_KEY_SORTNAME,
+    MD_KEY_COLLECTIONSORTNAME,
+    MD_KEY_DESC,
+    MD_KEY_DEVELOPER,
+    MD_KEY_PUBLISHER,
+    MD_KEY_GENRE,
+    MD_KEY_PLAYERS,
+    MD_KEY_FAVORITE,
+    MD_KEY_COMPLETED,
+    MD_KEY_KIDGAME,
+    MD_KEY_HIDDEN,
+    MD_KEY_BROKEN,
+    MD_KEY_NOGAMECOUNT,
+    MD_KEY_NOMULTISCRAPE,
+    MD_KEY_HIDEMETADATA,
+    MD_KEY_CONTROLLER,
+    MD_KEY_ALTEMULATOR,
+    MD_KEY_FOLDERLINK,
+    MD_KEY_COUNT,
+    MD_KEY_NUMERIC_COUNT = MD_KEY_NAME,
+    MD_KEY_INVALID = MD_KEY_COUNT
+};
+
 enum MetaDataListType {
     GAME_METADATA,
     FOLDER_METADATA
 };
 
 const std::vector<MetaDataDecl>& getMDDByType(MetaDataListType type);
+// Returns MD_KEY_INVALID if there is no such key.
+MetaDataKey getMetaDataKey(const std::string& key);
 
 class MetaDataList
 {
@@ -75,13 +111,30 @@ public:
     MetaDataList(MetaDataListType type);
 
     void set(const std::string& key, const std::string& value);
+    void set(MetaDataKey key, const std::string& value);
 
     const std::string& get(const std::string& key) const;
+    const std::string& get(MetaDataKey key) const
+    {
+        return mValues[key] != nullptr ? *mValues[key] : sNoResult;
+    }
     int getInt(const std::string& key) const;
+    int getInt(MetaDataKey key) const;
     float getFloat(const std::string& key) const;
+    float getFloat(MetaDataKey key) const;
+    // Cached value for the MD_BOOL entries, an undeclared key returns false.
+    bool getBool(MetaDataKey key) const { return (mBoolValues & (1u << key)) != 0; }
+    // Cached value for MD_KEY_RELEASEDATE and MD_KEY_LASTPLAYED, unset dates return 0.
+    time_t getTime(MetaDataKey key) const
+    {
+        return key < MD_KEY_NUMERIC_COUNT ? static_cast<time_t>(mNumericValues[key]) : 0;
+    }
 
     bool wasChanged() const;
     void resetChangedFlag();
+    // Changes whenever a value is set, and is only shared by copies with identical values.
+    // Used for invalidating data derived from the metadata.
+    unsigned long long getVersion() const { return mVersion; }
 
     MetaDataListType getType() const { return mType; }
     const std::vector<MetaDataDecl>& getMDD() const { return getMDDByType(getType()); }
@@ -91,10 +144,16 @@ public:
     }
 
 private:
+    // The values are immutable and shared, repeated values such as the defaults and the
+    // developer, publisher and genre names are pooled so each unique string is only stored once.
+    std::array<std::shared_ptr<const std::string>, MD_KEY_COUNT> mValues;
+    std::array<double, MD_KEY_NUMERIC_COUNT> mNumericValues;
+    unsigned long long mVersion;
+    unsigned int mBoolValues;
     MetaDataListType mType;
-    std::map<std::string, std::string> mMap;
-    std::string mNoResult = "";
     bool mWasChanged;
+
+    static inline const std::string sNoResult {};
 };
 
 #endif // ES_APP_META_DATA_H
@@ -16,9 +16,12 @@
 
 #include <chrono>
 
-MiximageGenerator::MiximageGenerator(FileData* game, std::string& resultMessage)
+MiximageGenerator::MiximageGenerator(FileData* game,
+                                     std::string& resultMessage,
+                                     Buffers* buffers)
     : mGame {game}
     , mResultMessage {resultMessage}
+    , mBuffers {buffers != nullptr ? buffers : &mOwnBuffers}
     , mWidth {1280}
     , mHeight {960}
     , mMarquee {false}
@@ -393,7 +396,8 @@ bool MiximageGenerator::generateImage()
     fileHeight = FreeImage_GetHeight(screenshotFile);
     filePitch = FreeImage_GetPitch(screenshotFile);
 
-    std::vector<unsigned char> screenshotVector(fileWidth * fileHeight * 4);
+    std::vector<unsigned char>& screenshotVector {mBuffers->imageVector};
+    screenshotVector.resize(fileWidth * fileHeight * 4);
 
     FreeImage_ConvertToRawBits(reinterpret_cast<BYTE*>(&screenshotVector.at(0)), screenshotFile,
                                filePitch, 32, FI_RGBA_BLUE, FI_RGBA_GREEN, FI_RGBA_RED, 1);
@@ -522,7 +526,9 @@ bool MiximageGenerator::generateImage()
     int xPosPhysicalMedia {0};
     int yPosPhysicalMedia {0};
 
-    CImg<unsigned char> canvasImage(mWidth, mHeight, 1, 4, 0);
+    // The canvas and frame are reused if they already have the correct size.
+    CImg<unsigned char>& canvasImage {mBuffers->canvasImage};
+    canvasImage.assign(mWidth, mHeight, 1, 4).fill(0);
 
     CImg<unsigned char> marqueeImage;
     CImg<unsigned char> marqueeImageRGB;
@@ -536,7 +542,8 @@ bool MiximageGenerator::generateImage()
     CImg<unsigned char> physicalMediaImageRGB;
     CImg<unsigned char> physicalMediaImageAlpha;
 
-    CImg<unsigned char> frameImage(mWidth, mHeight, 1, 4, 0);
+    CImg<unsigned char>& frameImage {mBuffers->frameImage};
+    frameImage.assign(mWidth, mHeight, 1, 4).fill(0);
 
     xPosScreenshot = canvasImage.width() / 2 - screenshotWidth / 2 + screenshotOffset;
     yPosScreenshot = canvasImage.height() / 2 - screenshotHeight / 2;
@@ -552,7 +559,8 @@ bool MiximageGenerator::generateImage()
         fileHeight = FreeImage_GetHeight(marqueeFile);
         filePitch = FreeImage_GetPitch(marqueeFile);
 
-        std::vector<unsigned char> marqueeVector(fileWidth * fileHeight * 4);
+        std::vector<unsigned char>& marqueeVector {mBuffers->imageVector};
+        marqueeVector.resize(fileWidth * fileHeight * 4);
 
         FreeImage_ConvertToRawBits(reinterpret_cast<BYTE*>(&marqueeVector.at(0)), marqueeFile,
                                    filePitch, 32, FI_RGBA_BLUE, FI_RGBA_GREEN, FI_RGBA_RED, 1);
@@ -594,7 +602,8 @@ bool MiximageGenerator::generateImage()
         fileHeight = FreeImage_GetHeight(boxFile);
         filePitch = FreeImage_GetPitch(boxFile);
 
-        std::vector<unsigned char> boxVector(fileWidth * fileHeight * 4);
+        std::vector<unsigned char>& boxVector {mBuffers->imageVector};
+        boxVector.resize(fileWidth * fileHeight * 4);
 
         FreeImage_ConvertToRawBits(reinterpret_cast<BYTE*>(&boxVector.at(0)), boxFile, filePitch,
                                    32, FI_RGBA_BLUE, FI_RGBA_GREEN, FI_RGBA_RED, 1);
@@ -656,7 +665,8 @@ bool MiximageGenerator::generateImage()
         fileHeight = FreeImage_GetHeight(physicalMediaFile);
         filePitch = FreeImage_GetPitch(physicalMediaFile);
 
-        std::vector<unsigned char> physicalMediaVector(fileWidth * fileHeight * 4);
+        std::vector<unsigned char>& physicalMediaVector {mBuffers->imageVector};
+        physicalMediaVector.resize(fileWidth * fileHeight * 4);
 
         FreeImage_ConvertToRawBits(reinterpret_cast<BYTE*>(&physicalMediaVector.at(0)),
                                    physicalMediaFile, filePitch, 32, FI_RGBA_BLUE, FI_RGBA_GREEN,
@@ -746,7 +756,8 @@ bool MiximageGenerator::generateImage()
         canvasImage.draw_image(xPosPhysicalMedia, yPosPhysicalMedia, physicalMediaImageRGB,
                                physicalMediaImageAlpha, 1, 255);
 
-    std::vector<unsigned char> canvasVector;
+    std::vector<unsigned char>& canvasVector {mBuffers->canvasVector};
+    canvasVector.clear();
 
     // Convert the image from CImg internal format.
     Utils::CImg::convertCImgToBGRA(canvasImage, canvasVector);
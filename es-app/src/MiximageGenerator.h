@@ -22,7 +22,16 @@ using namespace cimg_library;
 class MiximageGenerator
 {
 public:
-    MiximageGenerator(FileData* game, std::string& resultMessage);
+    // Working buffers that can be kept between miximages so they don't need to be reallocated
+    // for every image. The offline generator keeps one set per worker thread.
+    struct Buffers {
+        std::vector<unsigned char> imageVector;
+        std::vector<unsigned char> canvasVector;
+        CImg<unsigned char> canvasImage;
+        CImg<unsigned char> frameImage;
+    };
+
+    MiximageGenerator(FileData* game, std::string& resultMessage, Buffers* buffers = nullptr);
 
     void startThread(std::promise<bool>* miximagePromise);
 
@@ -41,6 +50,9 @@ private:
     std::string mMessage;
     std::promise<bool>* mMiximagePromise;
 
+    Buffers mOwnBuffers;
+    Buffers* mBuffers;
+
     std::string mScreenshotPath;
     std::string mMarqueePath;
     std::string mBox3DPath;
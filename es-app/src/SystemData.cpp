@@ -12,6 +12,7 @@
 #include "SystemData.h"
 
 #include "CollectionSystemsManager.h"
+#include "DirectoryScanCache.h"
 #include "FileFilterIndex.h"
 #include "FileSorts.h"
 #include "GamelistFileParser.h"
@@ -19,6 +20,7 @@
 #include "Log.h"
 #include "Settings.h"
 #include "ThemeData.h"
+#include "ThreadPool.h"
 #include "UIModeController.h"
 #include "resources/ResourceManager.h"
 #include "utils/FileSystemUtil.h"
@@ -230,27 +232,11 @@ SystemData::SystemData(const std::string& name,
 {
     mFilterIndex = new FileFilterIndex();
 
-    // If it's an actual system, initialize it, if not, just create the data structure.
+    // If it's an actual system then only the root folder is created here, the system is
+    // populated afterwards by loadConfig() which runs populateSystem() on the scan pool.
     if (!CollectionSystem) {
         mRootFolder = new FileData(FOLDER, mEnvData->mStartPath, mEnvData, this);
         mRootFolder->metadata.set("name", mFullName);
-
-        if (!Settings::getInstance()->getBool("ParseGamelistOnly")) {
-            // If there was an error populating the folder or if there were no games found,
-            // then don't continue with any additional process steps for this system.
-            if (!populateFolder(mRootFolder))
-                return;
-        }
-
-        if (!Settings::getInstance()->getBool("IgnoreGamelist"))
-            GamelistFileParser::parseGamelist(this);
-
-        setupSystemSortType(mRootFolder);
-
-        mRootFolder->sort(mRootFolder->getSortTypeFromString(mRootFolder->getSortTypeString()),
-                          Settings::getInstance()->getBool("FavoritesFirst"));
-
-        indexAllGameFilters(mRootFolder);
     }
     else {
         // Virtual systems are updated afterwards by CollectionSystemsManager.
@@ -263,7 +249,10 @@ SystemData::SystemData(const std::string& name,
     mPlaceholder = new FileData(PLACEHOLDER, "<No Entries Found>", getSystemEnvData(), this);
 
     setIsGameSystemStatus();
-    loadTheme(ThemeTriggers::TriggerType::NONE);
+
+    // The theme for game systems is loaded by loadConfig() once the system has been populated.
+    if (CollectionSystem)
+        loadTheme(ThemeTriggers::TriggerType::NONE);
 }
 
 SystemData::~SystemData()
@@ -280,6 +269,46 @@ SystemData::~SystemData()
     delete mFilterIndex;
 }
 
+void SystemData::populateSystem(ThreadPool* scanPool)
+{
+    if (!Settings::getInstance()->getBool("ParseGamelistOnly")) {
+        const bool useScanCache {Settings::getInstance()->getBool("CacheROMDirectories")};
+        mScanCache = std::make_unique<DirectoryScanCache>(mName, mEnvData->mStartPath);
+
+        if (useScanCache)
+            mScanCache->load();
+
+        const bool populated {populateFolder(mRootFolder, scanPool)};
+
+        if (useScanCache && !scanPool->stopRequested()) {
+            LOG(LogDebug) << "SystemData::populateSystem(): System \"" << mName << "\" had "
+                          << mScanCache->getCachedDirCount() << " unchanged and "
+                          << mScanCache->getScannedDirCount() << " scanned directories";
+            mScanCache->save();
+        }
+
+        mScanCache.reset();
+
+        // If there was an error populating the folder or if there were no games found,
+        // then don't continue with any additional process steps for this system.
+        if (!populated)
+            return;
+    }
+
+    if (scanPool->stopRequested())
+        return;
+
+    if (!Settings::getInstance()->getBool("IgnoreGamelist"))
+        GamelistFileParser::parseGamelist(this);
+
+    setupSystemSortType(mRootFolder);
+
+    mRootFolder->sort(mRootFolder->getSortTypeFromString(mRootFolder->getSortTypeString()),
+                      Settings::getInstance()->getBool(Settings::BoolID::FAVORITES_FIRST));
+
+    indexAllGameFilters(mRootFolder);
+}
+
 void SystemData::setIsGameSystemStatus()
 {
     // Reserved for future use, could be used to exclude certain systems from some operations,
@@ -287,42 +316,54 @@ void SystemData::setIsGameSystemStatus()
     mIsGameSystem = true;
 }
 
-bool SystemData::populateFolder(FileData* folder)
+bool SystemData::populateFolder(FileData* folder, ThreadPool* scanPool)
 {
-    if (mSymlinkMaxDepthReached)
+    if (mSymlinkMaxDepthReached || scanPool->stopRequested())
         return false;
 
     std::string filePath;
     std::string extension;
     const std::string& folderPath {folder->getPath()};
-    const bool showHiddenFiles {Settings::getInstance()->getBool("ShowHiddenFiles")};
-    const Utils::FileSystem::StringList& dirContent {Utils::FileSystem::getDirContent(folderPath)};
+    const bool showHiddenFiles {
+        Settings::getInstance()->getBool(Settings::BoolID::SHOW_HIDDEN_FILES)};
+    const std::vector<DirectoryScanCache::Entry>& dirContent {
+        mScanCache->getDirContent(folderPath)};
     bool isGame {false};
 
+    // Entries are added to the folder in directory order once all subfolders have been
+    // populated. The subfolders are scanned as separate tasks on the scan pool.
+    std::vector<FileData*> entries;
+    std::atomic<unsigned int> pendingFolders {0};
+    bool maxDepthReached {false};
+
     // If system directory exists but contains no games, return as error.
     if (dirContent.size() == 0)
         return false;
 
-    if (std::find(dirContent.cbegin(), dirContent.cend(), mEnvData->mStartPath + "/noload.txt") !=
-        dirContent.cend()) {
+    auto findFileFunc = [&dirContent](const std::string& path) {
+        return std::find_if(dirContent.cbegin(), dirContent.cend(),
+                            [&path](const DirectoryScanCache::Entry& entry) {
+                                return entry.path == path;
+                            }) != dirContent.cend();
+    };
+
+    if (findFileFunc(mEnvData->mStartPath + "/noload.txt")) {
         LOG(LogInfo) << "Not populating system \"" << mName << "\" as a noload.txt file is present";
         return false;
     }
 
-    if (std::find(dirContent.cbegin(), dirContent.cend(), mEnvData->mStartPath + "/flatten.txt") !=
-        dirContent.cend()) {
+    if (findFileFunc(mEnvData->mStartPath + "/flatten.txt")) {
         LOG(LogInfo) << "A flatten.txt file is present for the \"" << mName
                      << "\" system, folder flattening will be applied";
         mFlattenFolders = true;
     }
 
-    for (Utils::FileSystem::StringList::const_iterator it {dirContent.cbegin()};
-         it != dirContent.cend(); ++it) {
-        filePath = *it;
-        const bool isDirectory {Utils::FileSystem::isDirectory(filePath)};
+    for (auto it = dirContent.cbegin(); it != dirContent.cend(); ++it) {
+        filePath = (*it).path;
+        const bool isDirectory {(*it).isDirectory};
 
         // Skip any recursive symlinks as those would hang the application at various places.
-        if (Utils::FileSystem::isSymlink(filePath)) {
+        if ((*it).isSymlink) {
             if (Utils::FileSystem::resolveSymlink(filePath) ==
                 Utils::FileSystem::getFileName(filePath)) {
                 LOG(LogWarning) << "Skipped \"" << filePath << "\" as it's a recursive symlink";
@@ -331,7 +372,7 @@ bool SystemData::populateFolder(FileData* folder)
         }
 
         // Skip hidden files and folders.
-        if (!showHiddenFiles && Utils::FileSystem::isHidden(filePath)) {
+        if (!showHiddenFiles && (*it).isHidden) {
             LOG(LogDebug) << "SystemData::populateFolder(): Skipping hidden "
                           << (isDirectory ? "directory \"" : "file \"") << filePath << "\"";
             continue;
@@ -362,7 +403,7 @@ bool SystemData::populateFolder(FileData* folder)
 
             // Prevent new arcade assets from being added.
             if (!newGame->isArcadeAsset()) {
-                folder->addChild(newGame);
+                entries.emplace_back(newGame);
                 isGame = true;
             }
             else {
@@ -374,7 +415,7 @@ bool SystemData::populateFolder(FileData* folder)
         if (!isGame && isDirectory) {
             // Make sure that it's not a recursive symlink as the application would run into a
             // loop trying to resolve the link.
-            if (Utils::FileSystem::isSymlink(filePath)) {
+            if ((*it).isSymlink) {
                 bool recursiveSymlink {false};
                 const std::string& canonicalPath {Utils::FileSystem::getCanonicalPath(filePath)};
                 const std::string& canonicalStartPath {
@@ -390,11 +431,14 @@ bool SystemData::populateFolder(FileData* folder)
                                 LOG(LogWarning) << "Skipped \"" << filePath
                                                 << "\" as it seems to be a recursive symlink";
                                 mSymlinkMaxDepthReached = true;
-                                return false;
+                                maxDepthReached = true;
+                                break;
                             }
                         }
                     }
                 }
+                if (maxDepthReached)
+                    break;
                 if (canonicalStartPath.find(canonicalPath) != std::string::npos)
                     recursiveSymlink = true;
                 else if (canonicalPath.size() >= canonicalStartPath.size() &&
@@ -413,22 +457,36 @@ bool SystemData::populateFolder(FileData* folder)
             }
 
             FileData* newFolder {new FileData(FOLDER, filePath, mEnvData, this)};
-            populateFolder(newFolder);
+            entries.emplace_back(newFolder);
+            ++pendingFolders;
+            scanPool->submit([this, newFolder, scanPool, &pendingFolders] {
+                populateFolder(newFolder, scanPool);
+                --pendingFolders;
+            });
+        }
+    }
 
-            if (mFlattenFolders) {
-                for (auto& entry : newFolder->getChildrenByFilename())
-                    folder->addChild(entry.second);
-            }
-            else {
-                // Ignore folders that do not contain games.
-                if (newFolder->getChildrenByFilename().size() == 0)
-                    delete newFolder;
-                else
-                    folder->addChild(newFolder);
-            }
+    // Keep processing other scan tasks while waiting for our own subfolders to complete.
+    scanPool->runPendingUntil([&pendingFolders] { return pendingFolders == 0; });
+
+    for (FileData* entry : entries) {
+        if (entry->getType() != FOLDER) {
+            folder->addChild(entry);
+        }
+        else if (mFlattenFolders) {
+            for (auto& child : entry->getChildrenByFilename())
+                folder->addChild(child.second);
+        }
+        else {
+            // Ignore folders that do not contain games.
+            if (entry->getChildrenByFilename().size() == 0)
+                delete entry;
+            else
+                folder->addChild(entry);
         }
     }
-    return true;
+
+    return !maxDepthReached;
 }
 
 void SystemData::indexAllGameFilters(const FileData* folder)
@@ -485,8 +543,18 @@ bool SystemData::loadConfig()
 
     const bool splashScreen {Settings::getInstance()->getBool("SplashScreen")};
     float systemCount {0.0f};
-    float parsedSystems {0.0f};
     unsigned int gameCount {0};
+    bool configError {false};
+
+    // The systems are first created from the configuration file(s) and then populated in
+    // parallel by the scan pool. They are kept in this vector to retain the configuration order.
+    std::vector<SystemData*> newSystems;
+
+    auto deleteNewSystems = [&newSystems] {
+        for (auto system : newSystems)
+            delete system;
+        newSystems.clear();
+    };
 
     // This is only done to get the total system count, for calculating the progress bar position.
     for (auto& configPath : configPaths) {
@@ -533,7 +601,8 @@ bool SystemData::loadConfig()
 
         if (!res) {
             LOG(LogError) << "Couldn't parse es_systems.xml: " << res.description();
-            return true;
+            configError = true;
+            break;
         }
 
         const pugi::xml_node& loadExclusive {doc.child("loadExclusive")};
@@ -554,11 +623,10 @@ bool SystemData::loadConfig()
 
         if (!systemList) {
             LOG(LogError) << "es_systems.xml is missing the <systemList> tag";
-            return true;
+            configError = true;
+            break;
         }
 
-        unsigned int lastTime {0};
-        unsigned int accumulator {0};
         SDL_Event event {};
 
         for (pugi::xml_node system {systemList.child("system")}; system;
@@ -568,6 +636,7 @@ bool SystemData::loadConfig()
             while (SDL_PollEvent(&event)) {
                 InputManager::getInstance().parseEvent(event);
                 if (event.type == SDL_QUIT) {
+                    deleteNewSystems();
                     sStartupExitSignal = true;
                     return true;
                 }
@@ -584,24 +653,8 @@ bool SystemData::loadConfig()
             sortName = system.child("systemsortname").text().get();
             path = system.child("path").text().get();
 
-            if (splashScreen) {
-                const unsigned int curTime {SDL_GetTicks()};
-                accumulator += curTime - lastTime;
-                lastTime = curTime;
-                ++parsedSystems;
-                // This prevents Renderer::swapBuffers() from being called excessively which
-                // could lead to significantly longer application startup times.
-                if (accumulator > 40) {
-                    accumulator = 0;
-                    const float progress {glm::mix(0.0f, 0.5f, parsedSystems / systemCount)};
-                    Window::getInstance()->renderSplashScreen(Window::SplashScreenState::SCANNING,
-                                                              progress);
-                    lastTime += SDL_GetTicks() - curTime;
-                }
-            }
-
             auto nameFindFunc = [&] {
-                for (auto system : sSystemVector) {
+                for (auto system : newSystems) {
                     if (system->mName == name) {
                         LOG(LogDebug) << "A system with the name \"" << name
                                       << "\" has already been loaded, skipping duplicate entry";
@@ -766,7 +819,7 @@ bool SystemData::loadConfig()
             path = Utils::FileSystem::getGenericPath(path);
 
 #if defined(_WIN64)
-            if (!Settings::getInstance()->getBool("ShowHiddenFiles") &&
+            if (!Settings::getInstance()->getBool(Settings::BoolID::SHOW_HIDDEN_FILES) &&
                 Utils::FileSystem::isHidden(path)) {
                 LOG(LogWarning) << "Skipping hidden ROM folder \"" << path << "\"";
                 continue;
@@ -780,36 +833,114 @@ bool SystemData::loadConfig()
             envData->mLaunchCommands = commands;
             envData->mPlatformIds = platformIds;
 
-            SystemData* newSys {new SystemData(name, fullname, sortName, envData, themeFolder)};
-            bool onlyHidden {false};
-
-            // If the option to show hidden games has been disabled, then check whether all
-            // games for the system are hidden. That will flag the system as empty.
-            if (!Settings::getInstance()->getBool("ShowHiddenGames")) {
-                std::vector<FileData*> recursiveGames {
-                    newSys->getRootFolder()->getChildrenRecursive()};
-                onlyHidden = true;
-                for (auto it = recursiveGames.cbegin(); it != recursiveGames.cend(); ++it) {
-                    if ((*it)->getType() != FOLDER) {
-                        onlyHidden = (*it)->getHidden();
-                        if (!onlyHidden)
-                            break;
-                    }
-                }
-            }
+            newSystems.emplace_back(
+                new SystemData(name, fullname, sortName, envData, themeFolder));
+        }
+    }
 
-            if (newSys->getRootFolder()->getChildrenByFilename().size() == 0 || onlyHidden) {
-                LOG(LogDebug) << "SystemData::loadConfig(): Skipping system \"" << name
-                              << "\" as no files matched any of the defined file extensions";
-                delete newSys;
+    // Make sure the UI mode singleton is initialized before it's accessed from the scan pool
+    // when sorting the gamelists.
+    UIModeController::getInstance();
+
+    // Populate the systems. As this is mostly waiting for filesystem access the pool uses at
+    // least four threads, which makes a large difference for network shares even on slow CPUs.
+    std::atomic<unsigned int> populatedSystems {0};
+    ThreadPool scanPool {std::max(4u, std::thread::hardware_concurrency())};
+
+    for (auto system : newSystems) {
+        scanPool.submit([system, &scanPool, &populatedSystems] {
+            system->populateSystem(&scanPool);
+            ++populatedSystems;
+        });
+    }
+
+    SDL_Event event {};
+
+    // Poll events so that the OS doesn't think the application is hanging on startup and
+    // update the splash screen progress while the systems are being populated. The 40 ms
+    // interval prevents Renderer::swapBuffers() from being called excessively which could
+    // lead to significantly longer application startup times.
+    while (!scanPool.wait(40)) {
+        while (SDL_PollEvent(&event)) {
+            InputManager::getInstance().parseEvent(event);
+            if (event.type == SDL_QUIT)
+                sStartupExitSignal = true;
+        }
+
+        if (sStartupExitSignal) {
+            scanPool.requestStop();
+            scanPool.wait();
+            deleteNewSystems();
+            return true;
+        }
+
+        if (splashScreen && newSystems.size() > 0) {
+            const float progress {glm::mix(0.0f, 0.4f,
+                                           static_cast<float>(populatedSystems) /
+                                               static_cast<float>(newSystems.size()))};
+            Window::getInstance()->renderSplashScreen(Window::SplashScreenState::SCANNING,
+                                                      progress);
+        }
+    }
+
+    LOG(LogDebug) << "SystemData::loadConfig(): Populated " << newSystems.size() << " system"
+                  << (newSystems.size() == 1 ? "" : "s") << " using " << scanPool.getThreadCount()
+                  << " threads";
+
+    unsigned int lastTime {SDL_GetTicks()};
+    unsigned int accumulator {0};
+    float processedSystems {0.0f};
+
+    // Keep the systems in configuration order and load the themes for the non-empty ones.
+    for (auto newSys : newSystems) {
+        bool onlyHidden {false};
+
+        if (splashScreen) {
+            const unsigned int curTime {SDL_GetTicks()};
+            accumulator += curTime - lastTime;
+            lastTime = curTime;
+            ++processedSystems;
+            if (accumulator > 40) {
+                accumulator = 0;
+                const float progress {glm::mix(
+                    0.4f, 0.5f, processedSystems / static_cast<float>(newSystems.size()))};
+                Window::getInstance()->renderSplashScreen(Window::SplashScreenState::SCANNING,
+                                                          progress);
+                lastTime += SDL_GetTicks() - curTime;
             }
-            else {
-                sSystemVector.emplace_back(newSys);
-                gameCount += newSys->getRootFolder()->getGameCount().first;
+        }
+
+        // If the option to show hidden games has been disabled, then check whether all
+        // games for the system are hidden. That will flag the system as empty.
+        if (!Settings::getInstance()->getBool(Settings::BoolID::SHOW_HIDDEN_GAMES)) {
+            std::vector<FileData*> recursiveGames {newSys->getRootFolder()->getChildrenRecursive()};
+            onlyHidden = true;
+            for (auto it = recursiveGames.cbegin(); it != recursiveGames.cend(); ++it) {
+                if ((*it)->getType() != FOLDER) {
+                    onlyHidden = (*it)->getHidden();
+                    if (!onlyHidden)
+                        break;
+                }
             }
         }
+
+        if (newSys->getRootFolder()->getChildrenByFilename().size() == 0 || onlyHidden) {
+            LOG(LogDebug) << "SystemData::loadConfig(): Skipping system \"" << newSys->getName()
+                          << "\" as no files matched any of the defined file extensions";
+            delete newSys;
+        }
+        else {
+            newSys->loadTheme(ThemeTriggers::TriggerType::NONE);
+            sSystemVector.emplace_back(newSys);
+            gameCount += newSys->getRootFolder()->getGameCount().first;
+        }
     }
 
+    newSystems.clear();
+
+    if (configError)
+        return true;
+
     if (splashScreen) {
         if (sSystemVector.size() > 0)
             Window::getInstance()->renderSplashScreen(Window::SplashScreenState::SCANNING, 0.5f);
@@ -1522,7 +1653,7 @@ void SystemData::sortSystem(bool reloadGamelist, bool jumpToFirstRow)
         favoritesSorting = Settings::getInstance()->getBool("FavFirstCustom");
     }
     else {
-        favoritesSorting = Settings::getInstance()->getBool("FavoritesFirst");
+        favoritesSorting = Settings::getInstance()->getBool(Settings::BoolID::FAVORITES_FIRST);
     }
 
     FileData* rootFolder {getRootFolder()};
@@ -16,14 +16,17 @@
 #include "ThemeData.h"
 
 #include <algorithm>
+#include <atomic>
 #include <map>
 #include <memory>
 #include <string>
 #include <vector>
 
+class DirectoryScanCache;
 class FileData;
 class FileFilterIndex;
 class ThemeData;
+class ThreadPool;
 
 struct SystemEnvironmentData {
     std::string mStartPath;
@@ -158,7 +161,7 @@ private:
     std::string mThemeFolder;
     std::shared_ptr<ThemeData> mTheme;
 
-    bool mSymlinkMaxDepthReached;
+    std::atomic<bool> mSymlinkMaxDepthReached;
     bool mIsCollectionSystem;
     bool mIsCustomCollectionSystem;
     bool mIsGroupedCustomCollectionSystem;
@@ -166,11 +169,15 @@ private:
     bool mScrapeFlag; // Only used by scraper GUI to remember which systems to scrape.
     bool mFlattenFolders;
 
-    bool populateFolder(FileData* folder);
+    // Scans the ROM directory, parses the gamelist.xml file and sorts and indexes the games.
+    // This does not touch any shared state so it's run on the scan pool during startup.
+    void populateSystem(ThreadPool* scanPool);
+    bool populateFolder(FileData* folder, ThreadPool* scanPool);
     void indexAllGameFilters(const FileData* folder);
     void setIsGameSystemStatus();
 
     FileFilterIndex* mFilterIndex;
+    std::unique_ptr<DirectoryScanCache> mScanCache;
 
     FileData* mRootFolder;
     FileData* mPlaceholder;
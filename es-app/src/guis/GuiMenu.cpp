@@ -1694,6 +1694,34 @@ void GuiMenu::openOtherOptions()
         }
     });
 
+    // Whether to scale videos to their displayed size when decoding.
+    auto videoDecodeAtDisplaySize = std::make_shared<SwitchComponent>();
+    videoDecodeAtDisplaySize->setState(
+        Settings::getInstance()->getBool("VideoDecodeAtDisplaySize"));
+    s->addWithLabel("DECODE VIDEOS AT DISPLAYED SIZE", videoDecodeAtDisplaySize);
+    s->addSaveFunc([videoDecodeAtDisplaySize, s] {
+        if (videoDecodeAtDisplaySize->getState() !=
+            Settings::getInstance()->getBool("VideoDecodeAtDisplaySize")) {
+            Settings::getInstance()->setBool("VideoDecodeAtDisplaySize",
+                                             videoDecodeAtDisplaySize->getState());
+            s->setNeedsSaving();
+        }
+    });
+
+    // Whether to convert the video colors from YUV to RGB using a shader.
+    auto videoShaderColorConversion = std::make_shared<SwitchComponent>();
+    videoShaderColorConversion->setState(
+        Settings::getInstance()->getBool("VideoShaderColorConversion"));
+    s->addWithLabel("VIDEO COLOR CONVERSION USING SHADER", videoShaderColorConversion);
+    s->addSaveFunc([videoShaderColorConversion, s] {
+        if (videoShaderColorConversion->getState() !=
+            Settings::getInstance()->getBool("VideoShaderColorConversion")) {
+            Settings::getInstance()->setBool("VideoShaderColorConversion",
+                                             videoShaderColorConversion->getState());
+            s->setNeedsSaving();
+        }
+    });
+
     // Whether to enable alternative emulators per game (the option to disable this is intended
     // primarily for testing purposes).
     auto alternativeEmulatorPerGame = std::make_shared<SwitchComponent>();
@@ -1763,6 +1791,32 @@ void GuiMenu::openOtherOptions()
         }
     });
 
+    // Cache the ROM directory contents to speed up application startup.
+    auto cacheROMDirectories = std::make_shared<SwitchComponent>();
+    cacheROMDirectories->setState(Settings::getInstance()->getBool("CacheROMDirectories"));
+    s->addWithLabel("CACHE ROM DIRECTORY CONTENTS", cacheROMDirectories);
+    s->addSaveFunc([cacheROMDirectories, s] {
+        if (cacheROMDirectories->getState() !=
+            Settings::getInstance()->getBool("CacheROMDirectories")) {
+            Settings::getInstance()->setBool("CacheROMDirectories",
+                                             cacheROMDirectories->getState());
+            s->setNeedsSaving();
+        }
+    });
+
+    // Cache decoded images on disk to avoid decoding them again when reloading textures.
+    auto cacheDecodedImages = std::make_shared<SwitchComponent>();
+    cacheDecodedImages->setState(Settings::getInstance()->getBool("CacheDecodedImages"));
+    s->addWithLabel("CACHE DECODED IMAGES ON DISK", cacheDecodedImages);
+    s->addSaveFunc([cacheDecodedImages, s] {
+        if (cacheDecodedImages->getState() !=
+            Settings::getInstance()->getBool("CacheDecodedImages")) {
+            Settings::getInstance()->setBool("CacheDecodedImages",
+                                             cacheDecodedImages->getState());
+            s->setNeedsSaving();
+        }
+    });
+
     // Strip extra MAME name info.
     auto mameNameStripExtraInfo = std::make_shared<SwitchComponent>();
     mameNameStripExtraInfo->setState(Settings::getInstance()->getBool("MAMENameStripExtraInfo"));
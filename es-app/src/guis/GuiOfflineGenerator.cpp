@@ -23,7 +23,13 @@ GuiOfflineGenerator::GuiOfflineGenerator(const std::queue<FileData*>& gameQueue)
 
     mProcessing = false;
     mPaused = false;
-    mOverwriting = false;
+    mStopWorkers = false;
+    mDispatchedJobs = 0;
+
+    // Generate one miximage per CPU core unless multithreading has been disabled.
+    mMaxJobs = 1;
+    if (Settings::getInstance()->getBool("MiximageOfflineMultithreaded"))
+        mMaxJobs = std::max(1u, std::thread::hardware_concurrency());
 
     mTotalGames = static_cast<int>(mGameQueue.size());
     mGamesProcessed = 0;
@@ -32,8 +38,6 @@ GuiOfflineGenerator::GuiOfflineGenerator(const std::queue<FileData*>& gameQueue)
     mGamesSkipped = 0;
     mGamesFailed = 0;
 
-    mGame = nullptr;
-
     // Header.
     mTitle = std::make_shared<TextComponent>(
         "MIXIMAGE OFFLINE GENERATOR", Font::get(FONT_SIZE_LARGE), mMenuColorTitle, ALIGN_CENTER);
@@ -144,12 +148,15 @@ GuiOfflineGenerator::GuiOfflineGenerator(const std::queue<FileData*>& gameQueue)
             mCloseButton->setText("CLOSE", "close (abort processing)");
             mStatus->setText("RUNNING...");
             if (mGamesProcessed == 0) {
-                LOG(LogInfo) << "GuiOfflineGenerator: Processing " << mTotalGames << " games";
+                LOG(LogInfo) << "GuiOfflineGenerator: Processing " << mTotalGames << " games"
+                             << (mMaxJobs > 1 ? " using " + std::to_string(mMaxJobs) + " threads" :
+                                                "");
             }
+            while (mWorkerThreads.size() < mMaxJobs)
+                mWorkerThreads.emplace_back(&GuiOfflineGenerator::workerThread, this);
         }
         else {
-            if (mMiximageGeneratorThread.joinable())
-                mMiximageGeneratorThread.join();
+            waitForWorkers();
             mPaused = true;
             update(1);
             mProcessing = false;
@@ -202,13 +209,24 @@ GuiOfflineGenerator::GuiOfflineGenerator(const std::queue<FileData*>& gameQueue)
 
 GuiOfflineGenerator::~GuiOfflineGenerator()
 {
-    // Let the miximage generator thread complete.
-    if (mMiximageGeneratorThread.joinable())
-        mMiximageGeneratorThread.join();
+    // Let the worker threads complete the images they are currently generating, but don't
+    // start on any new games.
+    std::unique_lock<std::mutex> lock {mJobMutex};
+    mStopWorkers = true;
+    lock.unlock();
+    mPendingCondition.notify_all();
+
+    for (auto& thread : mWorkerThreads)
+        thread.join();
 
-    mMiximageGenerator.reset();
+    bool imagesGenerated {mImagesGenerated > 0};
 
-    if (mImagesGenerated > 0)
+    for (; !mCompletedJobs.empty(); mCompletedJobs.pop()) {
+        if (!mCompletedJobs.front().failed)
+            imagesGenerated = true;
+    }
+
+    if (imagesGenerated)
         ViewController::getInstance()->reloadAll();
 }
 
@@ -255,65 +273,60 @@ void GuiOfflineGenerator::update(int deltaTime)
     if (!mProcessing)
         return;
 
-    // Check if a miximage generator thread was started, and if the processing has been completed.
-    if (mMiximageGenerator && mGeneratorFuture.valid()) {
-        // Only wait one millisecond as this update() function runs very frequently.
-        if (mGeneratorFuture.wait_for(std::chrono::milliseconds(1)) == std::future_status::ready) {
-            // We always let the miximage generator thread complete.
-            if (mMiximageGeneratorThread.joinable())
-                mMiximageGeneratorThread.join();
-            mMiximageGenerator.reset();
-            if (!mGeneratorFuture.get()) {
-                ++mImagesGenerated;
-                TextureResource::manualUnload(mGame->getMiximagePath(), false);
-                mProcessingVal->setText("");
-                if (mOverwriting) {
-                    ++mImagesOverwritten;
-                    mOverwriting = false;
-                }
-            }
-            else {
-                std::string errorMessage {mResultMessage + " (" + mGameName + ")"};
-                mLastErrorVal->setText(errorMessage);
-                LOG(LogInfo) << "GuiOfflineGenerator: " << errorMessage;
-                ++mGamesFailed;
-            }
-            mGame = nullptr;
-            ++mGamesProcessed;
+    // Collect the results from the worker threads.
+    std::unique_lock<std::mutex> lock {mJobMutex};
+    std::queue<GeneratorJob> completedJobs;
+    completedJobs.swap(mCompletedJobs);
+    lock.unlock();
+
+    for (; !completedJobs.empty(); completedJobs.pop()) {
+        const GeneratorJob& job {completedJobs.front()};
+        if (!job.failed) {
+            ++mImagesGenerated;
+            TextureResource::manualUnload(job.game->getMiximagePath(), false);
+            if (job.overwriting)
+                ++mImagesOverwritten;
         }
+        else {
+            std::string errorMessage {job.resultMessage + " (" + job.gameName + ")"};
+            mLastErrorVal->setText(errorMessage);
+            LOG(LogInfo) << "GuiOfflineGenerator: " << errorMessage;
+            ++mGamesFailed;
+        }
+        --mDispatchedJobs;
+        ++mGamesProcessed;
     }
 
     // This is simply to retain the name of the last processed game on-screen while paused.
     if (mPaused)
         mProcessingVal->setText(mGameName);
+    else if (mDispatchedJobs == 0)
+        mProcessingVal->setText("");
 
-    if (!mPaused && !mGameQueue.empty() && !mMiximageGenerator) {
-        mGame = mGameQueue.front();
+    // Keep all workers busy. The number of games looked at per frame is limited as checking
+    // for existing miximages could otherwise stall the rendering for long game lists.
+    for (unsigned int i {0};
+         i < mMaxJobs && !mPaused && !mGameQueue.empty() && mDispatchedJobs < mMaxJobs; ++i) {
+        FileData* game {mGameQueue.front()};
         mGameQueue.pop();
 
         mGameName =
-            mGame->getName() + " [" + Utils::String::toUpper(mGame->getSystem()->getName()) + "]";
+            game->getName() + " [" + Utils::String::toUpper(game->getSystem()->getName()) + "]";
         mProcessingVal->setText(mGameName);
 
-        if (!Settings::getInstance()->getBool("MiximageOverwrite") &&
-            mGame->getMiximagePath() != "") {
+        const bool miximageExists {game->getMiximagePath() != ""};
+
+        if (!Settings::getInstance()->getBool("MiximageOverwrite") && miximageExists) {
             ++mGamesProcessed;
             ++mGamesSkipped;
             mSkippedVal->setText(std::to_string(mGamesSkipped));
         }
         else {
-            if (mGame->getMiximagePath() != "")
-                mOverwriting = true;
-
-            mMiximageGenerator = std::make_unique<MiximageGenerator>(mGame, mResultMessage);
-
-            // The promise/future mechanism is used as signaling for the thread to indicate
-            // that processing has been completed.
-            std::promise<bool>().swap(mGeneratorPromise);
-            mGeneratorFuture = mGeneratorPromise.get_future();
-
-            mMiximageGeneratorThread = std::thread(&MiximageGenerator::startThread,
-                                                   mMiximageGenerator.get(), &mGeneratorPromise);
+            lock.lock();
+            mPendingJobs.push(GeneratorJob {game, mGameName, "", miximageExists, false});
+            lock.unlock();
+            mPendingCondition.notify_one();
+            ++mDispatchedJobs;
         }
     }
 
@@ -340,6 +353,39 @@ void GuiOfflineGenerator::update(int deltaTime)
     }
 }
 
+void GuiOfflineGenerator::workerThread()
+{
+    // The scratch buffers are kept for the lifetime of the worker so they are only allocated once.
+    MiximageGenerator::Buffers buffers;
+
+    while (true) {
+        std::unique_lock<std::mutex> lock {mJobMutex};
+        mPendingCondition.wait(lock, [this] { return mStopWorkers || !mPendingJobs.empty(); });
+        if (mStopWorkers)
+            return;
+        GeneratorJob job {std::move(mPendingJobs.front())};
+        mPendingJobs.pop();
+        lock.unlock();
+
+        std::promise<bool> generatorPromise;
+        std::future<bool> generatorFuture {generatorPromise.get_future()};
+        MiximageGenerator generator {job.game, job.resultMessage, &buffers};
+        generator.startThread(&generatorPromise);
+        job.failed = generatorFuture.get();
+
+        lock.lock();
+        mCompletedJobs.push(std::move(job));
+        lock.unlock();
+        mCompletedCondition.notify_one();
+    }
+}
+
+void GuiOfflineGenerator::waitForWorkers()
+{
+    std::unique_lock<std::mutex> lock {mJobMutex};
+    mCompletedCondition.wait(lock, [this] { return mCompletedJobs.size() == mDispatchedJobs; });
+}
+
 std::vector<HelpPrompt> GuiOfflineGenerator::getHelpPrompts()
 {
     std::vector<HelpPrompt> prompts {mGrid.getHelpPrompts()};
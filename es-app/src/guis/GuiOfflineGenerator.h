@@ -16,7 +16,10 @@
 #include "components/ComponentGrid.h"
 #include "views/ViewController.h"
 
+#include <condition_variable>
+#include <mutex>
 #include <queue>
+#include <thread>
 
 class TextComponent;
 
@@ -30,22 +33,38 @@ private:
     void onSizeChanged() override;
     void update(int deltaTime) override;
 
+    // Runs on each of the worker threads, generating miximages until stopped.
+    void workerThread();
+    // Waits for all dispatched games to be processed by the worker threads.
+    void waitForWorkers();
+
     std::vector<HelpPrompt> getHelpPrompts() override;
     HelpStyle getHelpStyle() override { return ViewController::getInstance()->getViewHelpStyle(); }
 
+    struct GeneratorJob {
+        FileData* game;
+        std::string gameName;
+        std::string resultMessage;
+        bool overwriting;
+        bool failed;
+    };
+
     std::queue<FileData*> mGameQueue;
 
-    std::unique_ptr<MiximageGenerator> mMiximageGenerator;
-    std::thread mMiximageGeneratorThread;
-    std::promise<bool> mGeneratorPromise;
-    std::future<bool> mGeneratorFuture;
+    std::vector<std::thread> mWorkerThreads;
+    std::queue<GeneratorJob> mPendingJobs;
+    std::queue<GeneratorJob> mCompletedJobs;
+    std::mutex mJobMutex;
+    std::condition_variable mPendingCondition;
+    std::condition_variable mCompletedCondition;
+    bool mStopWorkers;
 
-    FileData* mGame;
+    // Number of games handed to the workers which have not yet been collected by update().
+    unsigned int mDispatchedJobs;
+    unsigned int mMaxJobs;
 
     bool mProcessing;
     bool mPaused;
-    bool mOverwriting;
-    std::string mResultMessage;
 
     unsigned int mTotalGames;
     unsigned int mGamesProcessed;
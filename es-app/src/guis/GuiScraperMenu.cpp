@@ -740,6 +740,20 @@ void GuiScraperMenu::openMiximageOptions()
         }
     });
 
+    // Whether the offline generator should process several games in parallel.
+    auto miximageOfflineMultithreaded = std::make_shared<SwitchComponent>();
+    miximageOfflineMultithreaded->setState(
+        Settings::getInstance()->getBool("MiximageOfflineMultithreaded"));
+    s->addWithLabel("USE ALL CPU CORES FOR OFFLINE GENERATOR", miximageOfflineMultithreaded);
+    s->addSaveFunc([miximageOfflineMultithreaded, s] {
+        if (miximageOfflineMultithreaded->getState() !=
+            Settings::getInstance()->getBool("MiximageOfflineMultithreaded")) {
+            Settings::getInstance()->setBool("MiximageOfflineMultithreaded",
+                                             miximageOfflineMultithreaded->getState());
+            s->setNeedsSaving();
+        }
+    });
+
     // Miximage offline generator.
     ComponentListRow offlineGeneratorRow;
     offlineGeneratorRow.elements.clear();
@@ -902,6 +916,20 @@ void GuiScraperMenu::openOtherOptions()
         }
     });
 
+    // Number of games to scrape concurrently in automatic mode.
+    auto scraperConcurrentGames = std::make_shared<SliderComponent>(1.0f, 8.0f, 1.0f);
+    scraperConcurrentGames->setValue(
+        static_cast<float>(Settings::getInstance()->getInt("ScraperConcurrentGames")));
+    s->addWithLabel("CONCURRENT GAMES IN AUTOMATIC MODE", scraperConcurrentGames);
+    s->addSaveFunc([scraperConcurrentGames, s] {
+        if (scraperConcurrentGames->getValue() !=
+            static_cast<float>(Settings::getInstance()->getInt("ScraperConcurrentGames"))) {
+            Settings::getInstance()->setInt("ScraperConcurrentGames",
+                                            static_cast<int>(scraperConcurrentGames->getValue()));
+            s->setNeedsSaving();
+        }
+    });
+
     if (mScraperRetryOnErrorCount->getValue() == 0.0f) {
         scraperRetryOnErrorTimer->setEnabled(false);
         scraperRetryOnErrorTimer->setOpacity(DISABLED_OPACITY);
@@ -15,6 +15,7 @@
 #include "FileFilterIndex.h"
 #include "GamelistFileParser.h"
 #include "MameNames.h"
+#include "MiximageGenerator.h"
 #include "SystemData.h"
 #include "Window.h"
 #include "components/ButtonComponent.h"
@@ -22,6 +23,9 @@
 #include "components/TextComponent.h"
 #include "guis/GuiMsgBox.h"
 #include "guis/GuiScraperSearch.h"
+#include "resources/TextureResource.h"
+
+#include <algorithm>
 
 GuiScraperMulti::GuiScraperMulti(
     const std::pair<std::queue<ScraperSearchParams>, std::map<SystemData*, int>>& searches,
@@ -44,6 +48,14 @@ GuiScraperMulti::GuiScraperMulti(
     mTotalSuccessful = 0;
     mTotalSkipped = 0;
 
+    // Only automatic mode can process several games concurrently as the other modes require
+    // the user to select or approve each result.
+    if (mApproveResults)
+        mConcurrentGames = 1;
+    else
+        mConcurrentGames = static_cast<unsigned int>(
+            glm::clamp(Settings::getInstance()->getInt("ScraperConcurrentGames"), 1, 8));
+
     for (auto it = searches.second.begin(); it != searches.second.end(); ++it)
         mQueueCountPerSystem[(*it).first] = std::make_pair(0, (*it).second);
 
@@ -172,11 +184,22 @@ GuiScraperMulti::GuiScraperMulti(
     setPosition((mRenderer->getScreenWidth() - mSize.x) / 2.0f,
                 (mRenderer->getScreenHeight() - mSize.y) / 2.0f);
 
-    doNextSearch();
+    if (mConcurrentGames > 1) {
+        // The thread limit is reported again by the scraper service as the account may have
+        // been changed since the last scraping session.
+        setScraperMaxThreads(0);
+        startJobs();
+        updateStatusText(mScrapeJobs.front()->params);
+    }
+    else {
+        doNextSearch();
+    }
 }
 
 GuiScraperMulti::~GuiScraperMulti()
 {
+    RomHashCache::getInstance().save();
+
     if (mTotalSuccessful > 0 || mSearchComp->getSavedNewMedia()) {
         // Sort all systems to possibly update their view style from Basic to Detailed or Video.
         for (auto it = SystemData::sSystemVector.cbegin(); // Line break.
@@ -210,6 +233,19 @@ void GuiScraperMulti::onSizeChanged()
     mBackground.fitTo(mSize);
 }
 
+void GuiScraperMulti::update(int deltaTime)
+{
+    GuiComponent::update(deltaTime);
+
+    if (mConcurrentGames < 2 || mScrapeJobs.empty())
+        return;
+
+    for (auto& job : mScrapeJobs)
+        updateJob(*job, deltaTime);
+
+    commitJobs();
+}
+
 void GuiScraperMulti::doNextSearch()
 {
     if (mSearchQueue.empty()) {
@@ -217,43 +253,47 @@ void GuiScraperMulti::doNextSearch()
         return;
     }
 
+    mScrollUp->setOpacity(0.0f);
+    mScrollDown->setOpacity(0.0f);
+    mResultList->resetScrollIndicatorStatus();
+
+    updateStatusText(mSearchQueue.front());
+    mSearchComp->search(mSearchQueue.front());
+}
+
+void GuiScraperMulti::updateStatusText(const ScraperSearchParams& search)
+{
     // Update title.
     std::stringstream ss;
 
     if (mQueueCountPerSystem.size() > 1) {
-        // const int gameCount {++mQueueCountPerSystem[mSearchQueue.front().system].first};
-        const int totalGameCount {mQueueCountPerSystem[mSearchQueue.front().system].second};
-        mSystem->setText(Utils::String::toUpper(mSearchQueue.front().system->getFullName()) + " [" +
+        // const int gameCount {++mQueueCountPerSystem[search.system].first};
+        const int totalGameCount {mQueueCountPerSystem[search.system].second};
+        mSystem->setText(Utils::String::toUpper(search.system->getFullName()) + " [" +
                          std::to_string(totalGameCount) + " GAME" +
                          (totalGameCount == 1 ? "]" : "S]"));
     }
     else {
-        mSystem->setText(Utils::String::toUpper(mSearchQueue.front().system->getFullName()));
+        mSystem->setText(Utils::String::toUpper(search.system->getFullName()));
     }
     std::string scrapeName;
 
     if (Settings::getInstance()->getBool("ScraperSearchMetadataName")) {
-        scrapeName = mSearchQueue.front().game->getName();
+        scrapeName = search.game->getName();
     }
     else {
-        if (mSearchQueue.front().game->isArcadeGame() &&
+        if (search.game->isArcadeGame() &&
             Settings::getInstance()->getString("Scraper") == "thegamesdb")
-            scrapeName =
-                Utils::FileSystem::getFileName(mSearchQueue.front().game->getPath()) + " (" +
-                MameNames::getInstance().getCleanName(mSearchQueue.front().game->getCleanName()) +
-                ")";
+            scrapeName = Utils::FileSystem::getFileName(search.game->getPath()) + " (" +
+                         MameNames::getInstance().getCleanName(search.game->getCleanName()) + ")";
         else
-            scrapeName = Utils::FileSystem::getFileName(mSearchQueue.front().game->getPath());
+            scrapeName = Utils::FileSystem::getFileName(search.game->getPath());
     }
 
-    mScrollUp->setOpacity(0.0f);
-    mScrollDown->setOpacity(0.0f);
-    mResultList->resetScrollIndicatorStatus();
-
     // Extract possible subfolders from the path.
     std::string folderPath {
-        Utils::String::replace(Utils::FileSystem::getParent(mSearchQueue.front().game->getPath()),
-                               mSearchQueue.front().system->getSystemEnvData()->mStartPath, "")};
+        Utils::String::replace(Utils::FileSystem::getParent(search.game->getPath()),
+                               search.system->getSystemEnvData()->mStartPath, "")};
 
     if (folderPath.size() >= 2) {
         folderPath.erase(0, 1);
@@ -269,29 +309,29 @@ void GuiScraperMulti::doNextSearch()
     ss.str("");
     ss << "GAME " << (mCurrentGame + 1) << " OF " << mTotalGames << " - " << folderPath
        << scrapeName
-       << ((mSearchQueue.front().game->getType() == FOLDER) ? "  " + ViewController::FOLDER_CHAR :
-                                                              "");
+       << ((search.game->getType() == FOLDER) ? "  " + ViewController::FOLDER_CHAR : "");
     mSubtitle->setText(ss.str());
-
-    mSearchComp->search(mSearchQueue.front());
 }
 
 void GuiScraperMulti::acceptResult(const ScraperSearchResult& result)
 {
-    ScraperSearchParams& search {mSearchQueue.front()};
+    saveResult(mSearchQueue.front(), result);
 
+    ++mCurrentGame;
+    ++mTotalSuccessful;
+    mSearchQueue.pop();
+    doNextSearch();
+}
+
+void GuiScraperMulti::saveResult(ScraperSearchParams& search, const ScraperSearchResult& result)
+{
     search.system->getIndex()->removeFromIndex(search.game);
 
     GuiScraperSearch::saveMetadata(result, search.game->metadata, search.game);
     GamelistFileParser::updateGamelist(search.system);
 
     search.system->getIndex()->addToIndex(search.game);
-
-    ++mCurrentGame;
-    ++mTotalSuccessful;
     CollectionSystemsManager::getInstance()->refreshCollectionSystems(search.game);
-    mSearchQueue.pop();
-    doNextSearch();
 }
 
 void GuiScraperMulti::skip()
@@ -333,6 +373,304 @@ void GuiScraperMulti::finish()
         }));
 }
 
+GuiScraperMulti::ScrapeJob::ScrapeJob(const ScraperSearchParams& searchParams)
+    : params {searchParams}
+    , stage {Stage::START}
+    , hashSearch {false}
+    , retryCount {0}
+    , retryAccumulator {0}
+{
+    // ScreenScraper will use the jeuInfos (single-game) API call, see GuiScraperSearch::search().
+    params.automaticMode = true;
+    params.md5Hash = "";
+    if (!Utils::FileSystem::isDirectory(params.game->getPath()))
+        params.fileSize = Utils::FileSystem::getFileSize(params.game->getPath());
+
+    if (Settings::getInstance()->getBool("ScraperSearchFileHash") &&
+        Settings::getInstance()->getString("Scraper") == "screenscraper" && params.fileSize != 0 &&
+        params.fileSize <=
+            Settings::getInstance()->getInt("ScraperSearchFileHashMaxSize") * 1024 * 1024)
+        hashSearch = true;
+}
+
+GuiScraperMulti::ScrapeJob::~ScrapeJob()
+{
+    // We always let the miximage generator thread complete.
+    if (miximageThread.joinable()) {
+        miximageThread.join();
+        TextureResource::manualUnload(params.game->getMiximagePath(), false);
+        ViewController::getInstance()->onFileChanged(params.game, true);
+    }
+}
+
+void GuiScraperMulti::startJobs()
+{
+    while (mScrapeJobs.size() < mConcurrentGames && !mSearchQueue.empty()) {
+        mScrapeJobs.emplace_back(std::make_unique<ScrapeJob>(mSearchQueue.front()));
+        mSearchQueue.pop();
+    }
+}
+
+void GuiScraperMulti::updateJob(ScrapeJob& job, int deltaTime)
+{
+    switch (job.stage) {
+        case ScrapeJob::Stage::START: {
+            if (!job.hashSearch) {
+                job.stage = ScrapeJob::Stage::WAITING_FOR_SEARCH;
+            }
+            // Only hash one file at a time as the entire file needs to be read from disk,
+            // unless the hashes are already cached.
+            else if (countJobs(ScrapeJob::Stage::HASHING) == 0) {
+                job.fileHashesFuture =
+                    std::async(std::launch::async, [path = job.params.game->getPath()] {
+                        return RomHashCache::getInstance().getHashes(path);
+                    });
+                job.stage = ScrapeJob::Stage::HASHING;
+            }
+            break;
+        }
+        case ScrapeJob::Stage::HASHING: {
+            if (job.fileHashesFuture.wait_for(std::chrono::milliseconds(0)) ==
+                std::future_status::ready) {
+                const Utils::Math::FileHashes hashes {job.fileHashesFuture.get()};
+                job.params.md5Hash = hashes.md5;
+                job.params.crc32Hash = hashes.crc32;
+                job.params.sha1Hash = hashes.sha1;
+                job.hashSearch = false;
+                job.stage = ScrapeJob::Stage::WAITING_FOR_SEARCH;
+            }
+            break;
+        }
+        case ScrapeJob::Stage::WAITING_FOR_SEARCH: {
+            // ScreenScraper limits the number of concurrent requests per account, and until the
+            // first response has been received we don't know what this limit is. Jobs that are
+            // resolving also count in this case as they download the media files from there.
+            int maxSearches {static_cast<int>(mConcurrentGames)};
+            int activeJobs {countJobs(ScrapeJob::Stage::SEARCHING) +
+                            countJobs(ScrapeJob::Stage::FETCHING_MEDIA_URLS)};
+            if (Settings::getInstance()->getString("Scraper") == "screenscraper") {
+                maxSearches = std::max(1, static_cast<int>(getScraperMaxThreads()));
+                activeJobs += countJobs(ScrapeJob::Stage::RESOLVING);
+            }
+
+            if (activeJobs < maxSearches) {
+                job.searchHandle = startScraperSearch(job.params);
+                job.stage = ScrapeJob::Stage::SEARCHING;
+            }
+            break;
+        }
+        case ScrapeJob::Stage::SEARCHING: {
+            const AsyncHandleStatus status {job.searchHandle->status()};
+            if (status == ASYNC_IN_PROGRESS)
+                break;
+
+            if (status == ASYNC_ERROR) {
+                onJobError(job, job.searchHandle->getStatusString(),
+                           job.searchHandle->getRetry());
+                break;
+            }
+
+            job.searchResults = job.searchHandle->getResults();
+            job.searchHandle.reset();
+
+            if (job.searchResults.empty()) {
+                LOG(LogDebug) << "GuiScraperMulti::updateJob(): Scraper service did not return "
+                                 "any results";
+                job.stage = ScrapeJob::Stage::SKIPPED;
+            }
+            else if (job.searchResults.front().mediaURLFetch != COMPLETED) {
+                std::string gameIDs;
+                for (auto it = job.searchResults.cbegin(); it != job.searchResults.cend(); ++it)
+                    gameIDs += it->gameID + ',';
+
+                // Remove the last comma
+                gameIDs.pop_back();
+                job.searchHandle = startMediaURLsFetch(gameIDs);
+                job.stage = ScrapeJob::Stage::FETCHING_MEDIA_URLS;
+            }
+            else {
+                resolveJob(job);
+            }
+            break;
+        }
+        case ScrapeJob::Stage::FETCHING_MEDIA_URLS: {
+            const AsyncHandleStatus status {job.searchHandle->status()};
+            if (status == ASYNC_IN_PROGRESS)
+                break;
+
+            if (status == ASYNC_ERROR) {
+                onJobError(job, job.searchHandle->getStatusString(),
+                           job.searchHandle->getRetry());
+                break;
+            }
+
+            GuiScraperSearch::mergeMediaURLs(job.searchResults, job.searchHandle->getResults());
+            job.searchHandle.reset();
+            resolveJob(job);
+            break;
+        }
+        case ScrapeJob::Stage::RESOLVING: {
+            const AsyncHandleStatus status {job.resolveHandle->status()};
+            if (status == ASYNC_IN_PROGRESS)
+                break;
+
+            if (status == ASYNC_ERROR) {
+                onJobError(job, job.resolveHandle->getStatusString(),
+                           job.resolveHandle->getRetry());
+                break;
+            }
+
+            job.result = job.resolveHandle->getResult();
+            job.result.mediaFilesDownloadStatus = COMPLETED;
+            job.resolveHandle.reset();
+
+            if (Settings::getInstance()->getBool("MiximageGenerate") &&
+                (job.params.game->getMiximagePath() == "" ||
+                 Settings::getInstance()->getBool("MiximageOverwrite")))
+                job.stage = ScrapeJob::Stage::WAITING_FOR_MIXIMAGE;
+            else
+                job.stage = ScrapeJob::Stage::DONE;
+            break;
+        }
+        case ScrapeJob::Stage::WAITING_FOR_MIXIMAGE: {
+            if (countJobs(ScrapeJob::Stage::GENERATING_MIXIMAGE) == 0) {
+                job.miximageGenerator =
+                    std::make_unique<MiximageGenerator>(job.params.game, job.miximageMessage);
+                std::promise<bool>().swap(job.miximagePromise);
+                job.miximageFuture = job.miximagePromise.get_future();
+                job.miximageThread = std::thread(&MiximageGenerator::startThread,
+                                                 job.miximageGenerator.get(), &job.miximagePromise);
+                job.stage = ScrapeJob::Stage::GENERATING_MIXIMAGE;
+            }
+            break;
+        }
+        case ScrapeJob::Stage::GENERATING_MIXIMAGE: {
+            if (job.miximageFuture.wait_for(std::chrono::milliseconds(0)) ==
+                std::future_status::ready) {
+                if (job.miximageThread.joinable())
+                    job.miximageThread.join();
+                if (!job.miximageFuture.get())
+                    job.result.savedNewMedia = true;
+                job.miximageGenerator.reset();
+                job.stage = ScrapeJob::Stage::DONE;
+            }
+            break;
+        }
+        case ScrapeJob::Stage::RETRY_WAIT: {
+            job.retryAccumulator += deltaTime;
+            if (job.retryAccumulator >=
+                glm::clamp(Settings::getInstance()->getInt("ScraperRetryOnErrorTimer") * 1000,
+                           1000, 30000)) {
+                job.retryAccumulator = 0;
+                job.stage = ScrapeJob::Stage::START;
+            }
+            break;
+        }
+        default: {
+            break;
+        }
+    }
+}
+
+void GuiScraperMulti::resolveJob(ScrapeJob& job)
+{
+    // Prefer the result with an MD5 digest identical to the file hash, if there is one.
+    size_t entry {0};
+    if (job.params.md5Hash != "") {
+        for (size_t i {0}; i < job.searchResults.size(); ++i) {
+            if (job.searchResults[i].md5Hash == job.params.md5Hash) {
+                entry = i;
+                break;
+            }
+        }
+    }
+
+    ScraperSearchResult& result {job.searchResults[entry]};
+    result.mediaFilesDownloadStatus = IN_PROGRESS;
+    LOG(LogDebug) << "GuiScraperMulti::resolveJob(): Resolving metadata for \""
+                  << result.mdl.get("name") << "\", game ID \"" << result.gameID << "\"";
+    job.resolveHandle = resolveMetaDataAssets(result, job.params);
+    job.stage = ScrapeJob::Stage::RESOLVING;
+}
+
+void GuiScraperMulti::onJobError(ScrapeJob& job, const std::string& error, const bool retry)
+{
+    LOG(LogError) << "GuiScraperMulti: " << Utils::String::replace(error, "\n", "");
+    job.searchHandle.reset();
+    job.resolveHandle.reset();
+
+    const int retries {
+        glm::clamp(Settings::getInstance()->getInt("ScraperRetryOnErrorCount"), 0, 10)};
+    if (retry && retries > 0 && job.retryCount < retries) {
+        ++job.retryCount;
+        LOG(LogInfo) << "GuiScraperMulti: Attempting automatic retry " << job.retryCount
+                     << " of " << retries;
+        job.stage = ScrapeJob::Stage::RETRY_WAIT;
+    }
+    else {
+        // The error is presented to the user when it's this game's turn to be saved.
+        job.error = error;
+        job.stage = ScrapeJob::Stage::FAILED;
+    }
+}
+
+void GuiScraperMulti::commitJobs()
+{
+    bool committed {false};
+
+    while (!mScrapeJobs.empty()) {
+        ScrapeJob& job {*mScrapeJobs.front()};
+
+        if (job.stage == ScrapeJob::Stage::DONE) {
+            saveResult(job.params, job.result);
+            std::string thumbnailPath {job.params.game->getScreenshotPath()};
+            if (thumbnailPath == "")
+                thumbnailPath = job.params.game->getCoverPath();
+            mSearchComp->showResult(job.result, thumbnailPath);
+            ++mTotalSuccessful;
+        }
+        else if (job.stage == ScrapeJob::Stage::SKIPPED) {
+            ++mTotalSkipped;
+        }
+        else if (job.stage == ScrapeJob::Stage::FAILED) {
+            // The following games are not saved until the user has decided what to do.
+            mWindow->pushGui(new GuiMsgBox(
+                getHelpStyle(), Utils::String::toUpper(job.error), "RETRY",
+                [this] {
+                    mScrapeJobs.front()->retryCount = 0;
+                    mScrapeJobs.front()->stage = ScrapeJob::Stage::START;
+                },
+                "SKIP", [this] { mScrapeJobs.front()->stage = ScrapeJob::Stage::SKIPPED; },
+                "CANCEL", std::bind(&GuiScraperMulti::finish, this), nullptr, true));
+            break;
+        }
+        else {
+            break;
+        }
+
+        ++mCurrentGame;
+        mScrapeJobs.pop_front();
+        committed = true;
+    }
+
+    if (!committed)
+        return;
+
+    startJobs();
+
+    if (mScrapeJobs.empty())
+        finish();
+    else
+        updateStatusText(mScrapeJobs.front()->params);
+}
+
+int GuiScraperMulti::countJobs(ScrapeJob::Stage stage)
+{
+    return static_cast<int>(std::count_if(
+        mScrapeJobs.cbegin(), mScrapeJobs.cend(),
+        [stage](const std::unique_ptr<ScrapeJob>& job) { return job->stage == stage; }));
+}
+
 std::vector<HelpPrompt> GuiScraperMulti::getHelpPrompts()
 {
     std::vector<HelpPrompt> prompts {mGrid.getHelpPrompts()};
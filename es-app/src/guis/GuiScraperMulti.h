@@ -17,10 +17,16 @@
 #include "components/ComponentGrid.h"
 #include "components/NinePatchComponent.h"
 #include "components/ScrollIndicatorComponent.h"
+#include "scrapers/RomHashCache.h"
 #include "scrapers/Scraper.h"
 #include "views/ViewController.h"
 
+#include <deque>
+#include <future>
+#include <thread>
+
 class GuiScraperSearch;
+class MiximageGenerator;
 class TextComponent;
 
 class GuiScraperMulti : public GuiComponent
@@ -33,16 +39,68 @@ public:
     virtual ~GuiScraperMulti();
 
     void onSizeChanged() override;
+    void update(int deltaTime) override;
 
     std::vector<HelpPrompt> getHelpPrompts() override;
     HelpStyle getHelpStyle() override { return ViewController::getInstance()->getViewHelpStyle(); }
 
 private:
+    // A game processed by the automatic mode pipeline. Several games are kept in flight at
+    // different stages, but the results are always saved in the order of the search queue.
+    struct ScrapeJob {
+        enum class Stage {
+            START,
+            HASHING,
+            WAITING_FOR_SEARCH,
+            SEARCHING,
+            FETCHING_MEDIA_URLS,
+            RESOLVING,
+            WAITING_FOR_MIXIMAGE,
+            GENERATING_MIXIMAGE,
+            RETRY_WAIT,
+            DONE,
+            SKIPPED,
+            FAILED
+        };
+
+        ScrapeJob(const ScraperSearchParams& searchParams);
+        ~ScrapeJob();
+
+        ScraperSearchParams params;
+        ScraperSearchResult result;
+        Stage stage;
+        bool hashSearch;
+
+        std::future<Utils::Math::FileHashes> fileHashesFuture;
+        std::unique_ptr<ScraperSearchHandle> searchHandle;
+        std::unique_ptr<MDResolveHandle> resolveHandle;
+        std::vector<ScraperSearchResult> searchResults;
+
+        std::unique_ptr<MiximageGenerator> miximageGenerator;
+        std::thread miximageThread;
+        std::promise<bool> miximagePromise;
+        std::future<bool> miximageFuture;
+        std::string miximageMessage;
+
+        std::string error;
+        int retryCount;
+        int retryAccumulator;
+    };
+
     void acceptResult(const ScraperSearchResult& result);
+    void saveResult(ScraperSearchParams& search, const ScraperSearchResult& result);
     void skip();
     void doNextSearch();
+    void updateStatusText(const ScraperSearchParams& search);
     void finish();
 
+    void startJobs();
+    void updateJob(ScrapeJob& job, int deltaTime);
+    void resolveJob(ScrapeJob& job);
+    void onJobError(ScrapeJob& job, const std::string& error, const bool retry);
+    void commitJobs();
+    int countJobs(ScrapeJob::Stage stage);
+
     Renderer* mRenderer;
     NinePatchComponent mBackground;
     ComponentGrid mGrid;
@@ -64,7 +122,10 @@ private:
     unsigned int mCurrentGame;
     unsigned int mTotalSuccessful;
     unsigned int mTotalSkipped;
+    unsigned int mConcurrentGames;
     bool mApproveResults;
+
+    std::deque<std::unique_ptr<ScrapeJob>> mScrapeJobs;
 };
 
 #endif // ES_APP_GUIS_GUI_SCRAPER_MULTI_H
@@ -175,8 +175,8 @@ GuiScraperSearch::~GuiScraperSearch()
         ViewController::getInstance()->onFileChanged(mLastSearch.game, true);
     }
 
-    if (mCalculateMD5HashThread.joinable())
-        mCalculateMD5HashThread.join();
+    if (mCalculateFileHashesThread.joinable())
+        mCalculateFileHashesThread.join();
 
     mWindow->setAllowTextScrolling(false);
 }
@@ -366,26 +366,29 @@ void GuiScraperSearch::search(ScraperSearchParams& params)
     else
         params.automaticMode = false;
 
-    mMD5Hash = "";
+    mFileHashes = {};
     params.md5Hash = "";
+    params.crc32Hash = "";
+    params.sha1Hash = "";
     if (!Utils::FileSystem::isDirectory(params.game->getPath()))
         params.fileSize = Utils::FileSystem::getFileSize(params.game->getPath());
 
-    // Only use MD5 file hash searching when in automatic mode.
+    // Only use file hash searching when in automatic mode.
     if (mSearchType == AUTOMATIC_MODE &&
         Settings::getInstance()->getBool("ScraperSearchFileHash") &&
         Settings::getInstance()->getString("Scraper") == "screenscraper" && params.fileSize != 0 &&
         params.fileSize <=
             Settings::getInstance()->getInt("ScraperSearchFileHashMaxSize") * 1024 * 1024) {
 
-        // Run the MD5 hash calculation in a separate thread as it may take a long time to
-        // complete and we don't want to freeze the UI in the meanwhile.
-        std::promise<bool>().swap(mMD5HashPromise);
-        mMD5HashFuture = mMD5HashPromise.get_future();
+        // Run the hash calculation in a separate thread as it may take a long time to
+        // complete and we don't want to freeze the UI in the meanwhile. If the file is
+        // unchanged since it was last hashed, the cached hashes are used instead.
+        std::promise<bool>().swap(mFileHashesPromise);
+        mFileHashesFuture = mFileHashesPromise.get_future();
 
         mHashSearch = true;
-        mCalculateMD5HashThread =
-            std::thread(&GuiScraperSearch::calculateMD5Hash, this, params.game->getPath());
+        mCalculateFileHashesThread =
+            std::thread(&GuiScraperSearch::calculateFileHashes, this, params.game->getPath());
     }
 
     mLastSearch = params;
@@ -447,10 +450,10 @@ void GuiScraperSearch::onSearchDone(std::vector<ScraperSearchResult>& results)
             std::string gameName {results.at(i).mdl.get("name")};
             std::string otherPlatforms;
 
-            if (mMD5Hash != "") {
+            if (mFileHashes.md5 != "") {
                 const std::string entryText {
                     results.size() > 1 ? "Result entry " + std::to_string(i) + ": " : ""};
-                if (results[i].md5Hash == mMD5Hash) {
+                if (results[i].md5Hash == mFileHashes.md5) {
                     mAutomaticModeGameEntry = static_cast<int>(i);
                     LOG(LogDebug)
                         << "GuiScraperSearch::onSearchDone(): " << entryText
@@ -634,15 +637,7 @@ void GuiScraperSearch::updateInfoPane()
         }
 
         // Metadata.
-        if (mScrapeRatings) {
-            mMD_Rating->setValue(Utils::String::toUpper(res.mdl.get("rating")));
-            mMD_Rating->setOpacity(1.0f);
-        }
-        mMD_ReleaseDate->setValue(Utils::String::toUpper(res.mdl.get("releasedate")));
-        mMD_Developer->setText(Utils::String::toUpper(res.mdl.get("developer")));
-        mMD_Publisher->setText(Utils::String::toUpper(res.mdl.get("publisher")));
-        mMD_Genre->setText(Utils::String::toUpper(res.mdl.get("genre")));
-        mMD_Players->setText(Utils::String::toUpper(res.mdl.get("players")));
+        updateMetadataFields(res.mdl);
         mGrid.onSizeChanged();
     }
     else {
@@ -665,6 +660,34 @@ void GuiScraperSearch::updateInfoPane()
     }
 }
 
+void GuiScraperSearch::updateMetadataFields(const MetaDataList& mdl)
+{
+    if (mScrapeRatings) {
+        mMD_Rating->setValue(Utils::String::toUpper(mdl.get("rating")));
+        mMD_Rating->setOpacity(1.0f);
+    }
+    mMD_ReleaseDate->setValue(Utils::String::toUpper(mdl.get("releasedate")));
+    mMD_Developer->setText(Utils::String::toUpper(mdl.get("developer")));
+    mMD_Publisher->setText(Utils::String::toUpper(mdl.get("publisher")));
+    mMD_Genre->setText(Utils::String::toUpper(mdl.get("genre")));
+    mMD_Players->setText(Utils::String::toUpper(mdl.get("players")));
+}
+
+void GuiScraperSearch::showResult(const ScraperSearchResult& result,
+                                  const std::string& thumbnailPath)
+{
+    // Keep the busy animation playing as the following games are still being processed.
+    mBlockAccept = true;
+
+    mResultName->setText(Utils::String::toUpper(result.mdl.get("name")));
+    mResultDesc->setText(Utils::String::toUpper(result.mdl.get("desc")));
+    mDescContainer->resetComponent();
+    mResultThumbnail->setImage(thumbnailPath);
+
+    updateMetadataFields(result.mdl);
+    mGrid.onSizeChanged();
+}
+
 bool GuiScraperSearch::input(InputConfig* config, Input input)
 {
     if (config->isMappedTo("a", input) && input.value != 0) {
@@ -750,13 +773,15 @@ void GuiScraperSearch::update(int deltaTime)
     // The only purpose of calling startScraperSearch() here instead of in search() is because
     // the optional MD5 hash calculation needs to run in a separate thread to not lock the UI.
     if (mNextSearch && mHashSearch) {
-        if (mMD5HashFuture.valid()) {
+        if (mFileHashesFuture.valid()) {
             // Only wait one millisecond as this update() function runs very frequently.
-            if (mMD5HashFuture.wait_for(std::chrono::milliseconds(1)) ==
+            if (mFileHashesFuture.wait_for(std::chrono::milliseconds(1)) ==
                 std::future_status::ready) {
-                if (mCalculateMD5HashThread.joinable())
-                    mCalculateMD5HashThread.join();
-                mLastSearch.md5Hash = mMD5Hash;
+                if (mCalculateFileHashesThread.joinable())
+                    mCalculateFileHashesThread.join();
+                mLastSearch.md5Hash = mFileHashes.md5;
+                mLastSearch.crc32Hash = mFileHashes.crc32;
+                mLastSearch.sha1Hash = mFileHashes.sha1;
                 mSearchHandle = startScraperSearch(mLastSearch);
                 mNextSearch = false;
             }
@@ -828,29 +853,11 @@ void GuiScraperSearch::update(int deltaTime)
     if (mMDRetrieveURLsHandle && mMDRetrieveURLsHandle->status() != ASYNC_IN_PROGRESS) {
         if (mMDRetrieveURLsHandle->status() == ASYNC_DONE) {
             auto results_media = mMDRetrieveURLsHandle->getResults();
-            auto statusString_media = mMDRetrieveURLsHandle->getStatusString();
             auto results_scrape = mScraperResults;
             mMDRetrieveURLsHandle.reset();
             mScraperResults.clear();
 
-            // Combine the intial scrape results with the media URL results.
-            for (auto it = results_media.cbegin(); it != results_media.cend(); ++it) {
-                for (unsigned int i = 0; i < results_scrape.size(); ++i) {
-                    if (results_scrape[i].gameID == it->gameID) {
-                        results_scrape[i].box3DUrl = it->box3DUrl;
-                        results_scrape[i].backcoverUrl = it->backcoverUrl;
-                        results_scrape[i].coverUrl = it->coverUrl;
-                        results_scrape[i].fanartUrl = it->fanartUrl;
-                        results_scrape[i].marqueeUrl = it->marqueeUrl;
-                        results_scrape[i].screenshotUrl = it->screenshotUrl;
-                        results_scrape[i].titlescreenUrl = it->titlescreenUrl;
-                        results_scrape[i].physicalmediaUrl = it->physicalmediaUrl;
-                        results_scrape[i].videoUrl = it->videoUrl;
-                        results_scrape[i].scraperRequestAllowance = it->scraperRequestAllowance;
-                        results_scrape[i].mediaURLFetch = COMPLETED;
-                    }
-                }
-            }
+            mergeMediaURLs(results_scrape, results_media);
             onSearchDone(results_scrape);
         }
         else if (mMDRetrieveURLsHandle->status() == ASYNC_ERROR) {
@@ -918,6 +925,28 @@ void GuiScraperSearch::update(int deltaTime)
     }
 }
 
+void GuiScraperSearch::mergeMediaURLs(std::vector<ScraperSearchResult>& results,
+                                      const std::vector<ScraperSearchResult>& mediaResults)
+{
+    for (auto it = mediaResults.cbegin(); it != mediaResults.cend(); ++it) {
+        for (unsigned int i = 0; i < results.size(); ++i) {
+            if (results[i].gameID == it->gameID) {
+                results[i].box3DUrl = it->box3DUrl;
+                results[i].backcoverUrl = it->backcoverUrl;
+                results[i].coverUrl = it->coverUrl;
+                results[i].fanartUrl = it->fanartUrl;
+                results[i].marqueeUrl = it->marqueeUrl;
+                results[i].screenshotUrl = it->screenshotUrl;
+                results[i].titlescreenUrl = it->titlescreenUrl;
+                results[i].physicalmediaUrl = it->physicalmediaUrl;
+                results[i].videoUrl = it->videoUrl;
+                results[i].scraperRequestAllowance = it->scraperRequestAllowance;
+                results[i].mediaURLFetch = COMPLETED;
+            }
+        }
+    }
+}
+
 void GuiScraperSearch::updateThumbnail()
 {
     auto it = mThumbnailReqMap.find(mScraperResults[mResultList->getCursorId()].thumbnailImageUrl +
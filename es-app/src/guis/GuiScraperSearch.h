@@ -20,6 +20,7 @@
 #include "MiximageGenerator.h"
 #include "components/BusyComponent.h"
 #include "components/ComponentGrid.h"
+#include "scrapers/RomHashCache.h"
 #include "scrapers/Scraper.h"
 #include "views/ViewController.h"
 
@@ -48,6 +49,9 @@ public:
     void search(ScraperSearchParams& params);
     void openInputScreen(ScraperSearchParams& from);
     void stop();
+    // Displays a result that has already been resolved elsewhere, used when the multi-scraper
+    // processes several games concurrently in automatic mode.
+    void showResult(const ScraperSearchResult& result, const std::string& thumbnailPath);
     int getScraperResultsSize() { return static_cast<int>(mScraperResults.size()); }
     bool getAcceptedResult() { return mAcceptedResult; }
     SearchType getSearchType() const { return mSearchType; }
@@ -60,6 +64,9 @@ public:
     static bool saveMetadata(const ScraperSearchResult& result,
                              MetaDataList& metadata,
                              FileData* scrapedGame);
+    // Combines the initial TheGamesDB search results with the separately fetched media URLs.
+    static void mergeMediaURLs(std::vector<ScraperSearchResult>& results,
+                               const std::vector<ScraperSearchResult>& mediaResults);
 
     // Metadata assets will be resolved before calling the accept callback.
     void setAcceptCallback(const std::function<void(const ScraperSearchResult&)>& acceptCallback)
@@ -105,6 +112,7 @@ private:
     void updateView();
     void updateThumbnail();
     void updateInfoPane();
+    void updateMetadataFields(const MetaDataList& mdl);
     void resizeMetadata();
 
     void onSearchError(const std::string& error,
@@ -114,10 +122,10 @@ private:
 
     int getSelectedIndex();
 
-    void calculateMD5Hash(std::string path)
+    void calculateFileHashes(std::string path)
     {
-        mMD5Hash = Utils::Math::md5Hash(path, true);
-        mMD5HashPromise.set_value(true);
+        mFileHashes = RomHashCache::getInstance().getHashes(path);
+        mFileHashesPromise.set_value(true);
     }
 
     // For TheGamesDB, retrieve URLs for the additional metadata assets
@@ -192,10 +200,10 @@ private:
     std::vector<ScraperSearchResult> mScraperResults;
     std::map<std::string, std::unique_ptr<HttpReq>> mThumbnailReqMap;
 
-    std::string mMD5Hash;
-    std::thread mCalculateMD5HashThread;
-    std::promise<bool> mMD5HashPromise;
-    std::future<bool> mMD5HashFuture;
+    Utils::Math::FileHashes mFileHashes;
+    std::thread mCalculateFileHashesThread;
+    std::promise<bool> mFileHashesPromise;
+    std::future<bool> mFileHashesFuture;
 
     std::unique_ptr<MiximageGenerator> mMiximageGenerator;
     std::thread mMiximageGeneratorThread;
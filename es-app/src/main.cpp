@@ -15,12 +15,14 @@
 #include "ApplicationUpdater.h"
 #include "ApplicationVersion.h"
 #include "AudioManager.h"
+#include "Benchmark.h"
 #include "CollectionSystemsManager.h"
 #include "InputManager.h"
 #include "Log.h"
 #include "MameNames.h"
 #include "MediaViewer.h"
 #include "PDFViewer.h"
+#include "Profiler.h"
 #include "Screensaver.h"
 #include "Scripting.h"
 #include "Settings.h"
@@ -71,6 +73,8 @@ namespace
     bool noUpdateCheck {false};
 #endif
     bool forceInputConfig {false};
+    bool runBenchmark {false};
+    std::string benchmarkScript;
     bool createSystemDirectories {false};
     bool settingsNeedSaving {false};
     bool portableMode {false};
@@ -384,6 +388,21 @@ bool parseArguments(const std::vector<std::string>& arguments)
         else if (arguments[i] == "--create-system-dirs") {
             createSystemDirectories = true;
         }
+        else if (arguments[i] == "--benchmark") {
+            // The script file is optional, the built-in input sequence is used if omitted.
+            if (i < arguments.size() - 1 && arguments[i + 1].substr(0, 2) != "--") {
+                benchmarkScript = arguments[i + 1];
+                ++i;
+            }
+            runBenchmark = true;
+            Renderer::setHeadless(true);
+#if defined(APPLICATION_UPDATER)
+            noUpdateCheck = true;
+#endif
+        }
+        else if (arguments[i] == "--profile") {
+            Profiler::getInstance().setEnabled(true);
+        }
         else if (arguments[i] == "--debug") {
             Settings::getInstance()->setBool("Debug", true);
             Settings::getInstance()->setBool("DebugFlag", true);
@@ -424,6 +443,8 @@ bool parseArguments(const std::vector<std::string>& arguments)
 "  --force-input-config                  Force configuration of input devices\n"
 "  --create-system-dirs                  Create game system directories\n"
 "  --home [path]                         Directory to use as home path\n"
+"  --benchmark [script]                  Run a headless frame time benchmark and exit\n"
+"  --profile                             Show profiling statistics and write a trace file\n"
 "  --debug                               Enable debug mode\n"
 "  --version, -v                         Display version information\n"
 "  --help, -h                            Summon a sentient, angry tuba\n";
@@ -499,6 +520,8 @@ void applicationLoop()
 #if !defined(__EMSCRIPTEN__)
     while (true) {
 #endif
+        Profiler::ScopedTimer frameTimer {"Event polling"};
+
         if (SDL_PollEvent(&event)) {
             do {
 #if defined(__ANDROID__)
@@ -542,11 +565,15 @@ void applicationLoop()
             }
         }
 #endif
+        frameTimer.restart("Update");
         window->update(deltaTime);
+        frameTimer.restart("Render");
         window->render();
 
+        frameTimer.restart("Swap buffers");
         renderer->swapBuffers();
-        Log::flush();
+        frameTimer.stop();
+        Profiler::getInstance().endFrame();
 #if !defined(__EMSCRIPTEN__)
     }
 #endif
@@ -1223,7 +1250,12 @@ int main(int argc, char* argv[])
 
         // Main application loop.
 
-        if (!SystemData::sStartupExitSignal) {
+        if (!SystemData::sStartupExitSignal && runBenchmark) {
+            Benchmark benchmark {window};
+            if (benchmark.loadScript(benchmarkScript))
+                benchmark.run();
+        }
+        else if (!SystemData::sStartupExitSignal) {
 #if defined(__EMSCRIPTEN__)
             emscripten_set_main_loop(&applicationLoop, 0, 1);
 #else
@@ -1239,6 +1271,7 @@ int main(int argc, char* argv[])
         delete window->peekGui();
     window->deinit();
 
+    Font::stopPrewarming();
     TextureResource::setExit();
     CollectionSystemsManager::getInstance()->deinit(true);
     SystemData::deleteSystems();
@@ -1255,6 +1288,9 @@ int main(int argc, char* argv[])
         Utils::Platform::revertTaskbarState(taskbarState);
 #endif
 
+    if (Profiler::getEnabled())
+        Profiler::getInstance().writeTrace();
+
     Utils::Platform::processQuitMode();
 
     LOG(LogInfo) << "ES-DE cleanly shutting down";
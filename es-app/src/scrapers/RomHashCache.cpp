@@ -0,0 +1,142 @@
+//  SPDX-License-Identifier: MIT
+//
+//  ES-DE
+//  RomHashCache.cpp
+//
+//  Persistent cache of the game file hashes used for scraper searches. The hashes are
+//  stored together with the file size and modification time, and as long as these are
+//  unchanged the file does not need to be read again when re-scraping.
+//
+
+#include "scrapers/RomHashCache.h"
+
+#include "Log.h"
+#include "utils/FileSystemUtil.h"
+#include "utils/SerializationUtil.h"
+
+namespace
+{
+    const char cacheFileMagic[4] {'E', 'S', 'H', 'C'};
+    const unsigned int cacheFileVersion {1};
+} // namespace
+
+RomHashCache::RomHashCache()
+    : mCacheFile {Utils::FileSystem::getAppDataDirectory() + "/cache/romhashes.bin"}
+    , mLoaded {false}
+    , mChanged {false}
+{
+}
+
+RomHashCache& RomHashCache::getInstance()
+{
+    static RomHashCache instance;
+    return instance;
+}
+
+Utils::Math::FileHashes RomHashCache::getHashes(const std::string& path)
+{
+    const long long fileSize {static_cast<long long>(Utils::FileSystem::getFileSize(path))};
+    const long long writeTime {Utils::FileSystem::getLastWriteTime(path)};
+
+    {
+        std::unique_lock<std::mutex> lock {mMutex};
+        if (!mLoaded)
+            load();
+
+        auto it = mEntries.find(path);
+        if (it != mEntries.end() && (*it).second.fileSize == fileSize &&
+            (*it).second.writeTime == writeTime) {
+            LOG(LogDebug) << "RomHashCache::getHashes(): Using cached hashes for \"" << path
+                          << "\"";
+            return (*it).second.hashes;
+        }
+    }
+
+    // The lock is not held while hashing as this could take a long time for large files.
+    const Utils::Math::FileHashes hashes {Utils::Math::fileHashes(path)};
+
+    // Nothing is cached if the file could not be read.
+    if (hashes.md5 == "" || writeTime == -1)
+        return hashes;
+
+    std::unique_lock<std::mutex> lock {mMutex};
+    mEntries[path] = Entry {fileSize, writeTime, hashes};
+    mChanged = true;
+
+    return hashes;
+}
+
+void RomHashCache::load()
+{
+    mLoaded = true;
+
+    std::string buffer;
+    size_t offset {0};
+    unsigned int entryCount {0};
+
+    if (!Utils::Serialization::readFile(mCacheFile, buffer) ||
+        !Utils::Serialization::readHeader(buffer, offset, cacheFileMagic, cacheFileVersion))
+        return;
+
+    if (!Utils::Serialization::readValue<unsigned int>(buffer, offset, entryCount))
+        return;
+
+    for (unsigned int i {0}; i < entryCount; ++i) {
+        std::string path;
+        Entry entry {};
+
+        if (!Utils::Serialization::readString(buffer, offset, path) ||
+            !Utils::Serialization::readValue<long long>(buffer, offset, entry.fileSize) ||
+            !Utils::Serialization::readValue<long long>(buffer, offset, entry.writeTime) ||
+            !Utils::Serialization::readString(buffer, offset, entry.hashes.crc32) ||
+            !Utils::Serialization::readString(buffer, offset, entry.hashes.md5) ||
+            !Utils::Serialization::readString(buffer, offset, entry.hashes.sha1)) {
+            LOG(LogWarning) << "RomHashCache: Cache file \"" << mCacheFile
+                            << "\" is invalid, ignoring it";
+            mEntries.clear();
+            return;
+        }
+
+        mEntries[path] = std::move(entry);
+    }
+
+    LOG(LogDebug) << "RomHashCache::load(): Loaded " << mEntries.size() << " cached file hash"
+                  << (mEntries.size() == 1 ? "" : "es");
+}
+
+void RomHashCache::save()
+{
+    std::unique_lock<std::mutex> lock {mMutex};
+
+    if (!mChanged)
+        return;
+
+    // Prune entries for files that have been removed or renamed.
+    for (auto it = mEntries.begin(); it != mEntries.end();) {
+        if (!Utils::FileSystem::exists((*it).first))
+            it = mEntries.erase(it);
+        else
+            ++it;
+    }
+
+    std::string buffer;
+    Utils::Serialization::writeHeader(buffer, cacheFileMagic, cacheFileVersion);
+    Utils::Serialization::writeValue<unsigned int>(buffer,
+                                                   static_cast<unsigned int>(mEntries.size()));
+
+    for (auto& entry : mEntries) {
+        Utils::Serialization::writeString(buffer, entry.first);
+        Utils::Serialization::writeValue<long long>(buffer, entry.second.fileSize);
+        Utils::Serialization::writeValue<long long>(buffer, entry.second.writeTime);
+        Utils::Serialization::writeString(buffer, entry.second.hashes.crc32);
+        Utils::Serialization::writeString(buffer, entry.second.hashes.md5);
+        Utils::Serialization::writeString(buffer, entry.second.hashes.sha1);
+    }
+
+    if (!Utils::Serialization::writeFile(mCacheFile, buffer)) {
+        LOG(LogWarning) << "RomHashCache: Couldn't write to cache file \"" << mCacheFile << "\"";
+        return;
+    }
+
+    mChanged = false;
+}
@@ -0,0 +1,51 @@
+//  SPDX-License-Identifier: MIT
+//
+//  ES-DE
+//  RomHashCache.h
+//
+//  Persistent cache of the game file hashes used for scraper searches. The hashes are
+//  stored together with the file size and modification time, and as long as these are
+//  unchanged the file does not need to be read again when re-scraping.
+//
+
+#ifndef ES_APP_SCRAPERS_ROM_HASH_CACHE_H
+#define ES_APP_SCRAPERS_ROM_HASH_CACHE_H
+
+#include "utils/MathUtil.h"
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+class RomHashCache
+{
+public:
+    static RomHashCache& getInstance();
+
+    // Returns the hashes for the file, which are only calculated if there is no cache entry
+    // matching the current file size and modification time. This is safe to call from
+    // multiple threads.
+    Utils::Math::FileHashes getHashes(const std::string& path);
+
+    // Writes the cache file if any hashes were added since it was loaded. Entries for files
+    // which no longer exist are pruned.
+    void save();
+
+private:
+    struct Entry {
+        long long fileSize;
+        long long writeTime;
+        Utils::Math::FileHashes hashes;
+    };
+
+    RomHashCache();
+    void load();
+
+    std::string mCacheFile;
+    std::unordered_map<std::string, Entry> mEntries;
+    std::mutex mMutex;
+    bool mLoaded;
+    bool mChanged;
+};
+
+#endif // ES_APP_SCRAPERS_ROM_HASH_CACHE_H
@@ -16,6 +16,7 @@
 #include "ScreenScraper.h"
 #include "Settings.h"
 #include "SystemData.h"
+#include "ThreadPool.h"
 #include "utils/StringUtil.h"
 
 #if defined(_WIN64)
@@ -23,15 +24,181 @@
 #endif
 
 #include <FreeImage.h>
+#include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <fstream>
+#include <thread>
 
 namespace
 {
     const std::map<std::string, generate_scraper_requests_func> scraper_request_funcs {
         {"thegamesdb", &thegamesdb_generate_json_scraper_requests},
         {"screenscraper", &screenscraper_generate_scraper_requests}};
-}
+
+    std::atomic<unsigned int> scraperMaxThreads {0};
+
+    // Small pool of threads used for writing, checking and resizing the downloaded media files
+    // so that this work does not stall the rendering. Tasks left in the queue at application
+    // shutdown are completed before the threads exit.
+    ThreadPool& getMediaSavePool()
+    {
+        static ThreadPool pool {std::clamp(std::thread::hardware_concurrency() / 2, 1u, 4u)};
+        return pool;
+    }
+
+    struct MediaSaveTask {
+        std::string mediaData;
+        std::string tempPath;
+        std::string savePath;
+        std::string existingMediaFile;
+        std::string mediaType;
+        bool resizeFile;
+        bool checkBackCover;
+    };
+
+    std::string nativePath(const std::string& path)
+    {
+#if defined(_WIN64)
+        return Utils::String::replace(path, "/", "\\");
+#else
+        return path;
+#endif
+    }
+
+    // There are multiple issues with box back covers at ScreenScraper. Some only contain a single
+    // color like pure black or more commonly pure green, and some are mostly transparent with
+    // just a few black lines at the bottom. This attempts to detect such broken images so they
+    // can be skipped.
+    bool isEmptyBackCover(const std::string& path)
+    {
+#if defined(_WIN64)
+        FREE_IMAGE_FORMAT imageFormat {
+            FreeImage_GetFileTypeU(Utils::String::stringToWideString(path).c_str())};
+#else
+        FREE_IMAGE_FORMAT imageFormat {FreeImage_GetFileType(path.c_str())};
+#endif
+        if (imageFormat == FIF_UNKNOWN)
+            return false;
+
+#if defined(_WIN64)
+        FIBITMAP* tempImage {
+            FreeImage_LoadU(imageFormat, Utils::String::stringToWideString(path).c_str())};
+#else
+        FIBITMAP* tempImage {FreeImage_Load(imageFormat, path.c_str())};
+#endif
+        if (tempImage == nullptr)
+            return true;
+
+        bool emptyImage {true};
+        RGBQUAD firstPixel;
+        RGBQUAD currPixel;
+
+        unsigned int width {FreeImage_GetWidth(tempImage)};
+        unsigned int height {FreeImage_GetHeight(tempImage)};
+
+        // Skip really small images as they're obviously not valid.
+        if (width >= 50 && height >= 50) {
+            // Remove the alpha channel which will convert fully transparent pixels to black.
+            if (FreeImage_GetBPP(tempImage) != 24) {
+                FIBITMAP* convertImage {FreeImage_ConvertTo24Bits(tempImage)};
+                FreeImage_Unload(tempImage);
+                tempImage = convertImage;
+            }
+
+            // Skip the first line as this can apparently lead to false positives.
+            FreeImage_GetPixelColor(tempImage, 0, 1, &firstPixel);
+
+            for (unsigned int x {0}; x < width; ++x) {
+                if (!emptyImage)
+                    break;
+                // Skip the last line as well.
+                for (unsigned int y {1}; y < height - 1; ++y) {
+                    FreeImage_GetPixelColor(tempImage, x, y, &currPixel);
+                    if (currPixel.rgbBlue != firstPixel.rgbBlue ||
+                        currPixel.rgbGreen != firstPixel.rgbGreen ||
+                        currPixel.rgbRed != firstPixel.rgbRed) {
+                        emptyImage = false;
+                        break;
+                    }
+                }
+            }
+        }
+        FreeImage_Unload(tempImage);
+
+        return emptyImage;
+    }
+
+    // Runs on a media save pool thread, returns an error message or an empty string on success.
+    std::string saveMediaFile(const MediaSaveTask& task, bool& savedNewMedia)
+    {
+        // If the media directory does not exist, something is wrong, possibly permission
+        // problems or the MediaDirectory setting points to a file instead of a directory.
+        if (!Utils::FileSystem::isDirectory(Utils::FileSystem::getParent(task.savePath))) {
+            LOG(LogError) << "Couldn't create media directory: \""
+                          << Utils::FileSystem::getParent(task.savePath) << "\"";
+            return "Media directory does not exist and can't be created. Permission problems?";
+        }
+
+        if (!task.mediaData.empty()) {
+#if defined(_WIN64)
+            std::ofstream stream(Utils::String::stringToWideString(task.tempPath).c_str(),
+                                 std::ios_base::out | std::ios_base::binary);
+#else
+            std::ofstream stream(task.tempPath, std::ios_base::out | std::ios_base::binary);
+#endif
+            if (!stream || stream.bad())
+                return "Failed to open path for writing media file\nPermission error?";
+
+            stream.write(task.mediaData.data(), task.mediaData.length());
+            stream.close();
+            if (stream.bad()) {
+                Utils::FileSystem::removeFile(task.tempPath);
+                return "Failed to save media file\nDisk full?";
+            }
+        }
+
+        if (task.checkBackCover && isEmptyBackCover(task.tempPath)) {
+            LOG(LogWarning) << "ScreenScraper: Image does not seem to contain any data, not saving "
+                               "it to disk: \""
+                            << nativePath(task.savePath) << "\"";
+            Utils::FileSystem::removeFile(task.tempPath);
+            return "";
+        }
+
+        // Remove any existing media file before attempting to write a new one.
+        // This avoids the problem where there's already a file for this media type
+        // with a different format/extension (e.g. game.jpg and we're going to write
+        // game.png) which would lead to two media files for this game.
+        if (task.existingMediaFile != "")
+            Utils::FileSystem::removeFile(task.existingMediaFile);
+
+        // Renaming won't replace an existing file on all operating systems.
+        if (Utils::FileSystem::exists(task.savePath))
+            Utils::FileSystem::removeFile(task.savePath);
+
+        if (Utils::FileSystem::renameFile(task.tempPath, task.savePath, true)) {
+            Utils::FileSystem::removeFile(task.tempPath);
+            return "Failed to save media file\nPermission error?";
+        }
+
+        if (task.mediaType == "manuals") {
+            LOG(LogDebug) << "Scraper::saveMediaFile(): Saving game manual \""
+                          << nativePath(task.savePath) << "\"";
+        }
+        else if (task.mediaType == "videos") {
+            LOG(LogDebug) << "Scraper::saveMediaFile(): Saving video \""
+                          << nativePath(task.savePath) << "\"";
+        }
+
+        // Resize it.
+        if (task.resizeFile && !resizeImage(task.savePath, task.mediaType))
+            return "Error saving resized image\nOut of memory? Disk full?";
+
+        savedNewMedia = true;
+        return "";
+    }
+} // namespace
 
 std::unique_ptr<ScraperSearchHandle> startScraperSearch(const ScraperSearchParams& params)
 {
@@ -103,6 +270,10 @@ bool isValidConfiguredScraper()
     return scraper_request_funcs.find(name) != scraper_request_funcs.end();
 }
 
+unsigned int getScraperMaxThreads() { return scraperMaxThreads; }
+
+void setScraperMaxThreads(unsigned int maxThreads) { scraperMaxThreads = maxThreads; }
+
 void ScraperSearchHandle::update()
 {
     if (mStatus == ASYNC_DONE)
@@ -315,52 +486,11 @@ MDResolveHandle::MDResolveHandle(const ScraperSearchResult& result,
         // If the image is cached already as the thumbnail, then we don't need
         // to download it again, in this case just save it to disk and resize it.
         if (mResult.thumbnailImageUrl == it->fileURL && mResult.thumbnailImageData.size() > 0) {
-            // Remove any existing media file before attempting to write a new one.
-            // This avoids the problem where there's already a file for this media type
-            // with a different format/extension (e.g. game.jpg and we're going to write
-            // game.png) which would lead to two media files for this game.
-            if (it->existingMediaFile != "")
-                Utils::FileSystem::removeFile(it->existingMediaFile);
-
-            // If the media directory does not exist, something is wrong, possibly permission
-            // problems or the MediaDirectory setting points to a file instead of a directory.
-            if (!Utils::FileSystem::isDirectory(Utils::FileSystem::getParent(filePath))) {
-                setError("Media directory does not exist and can't be created. "
-                         "Permission problems?",
-                         false);
-                LOG(LogError) << "Couldn't create media directory: \""
-                              << Utils::FileSystem::getParent(filePath) << "\"";
-                return;
-            }
-
-#if defined(_WIN64)
-            std::ofstream stream(Utils::String::stringToWideString(filePath).c_str(),
-                                 std::ios_base::out | std::ios_base::binary);
-#else
-            std::ofstream stream(filePath, std::ios_base::out | std::ios_base::binary);
-#endif
-            if (!stream || stream.bad()) {
-                setError("Failed to open path for writing media file\nPermission error?", false);
-                return;
-            }
-
-            const std::string& content {mResult.thumbnailImageData};
-            stream.write(content.data(), content.length());
-            stream.close();
-            if (stream.bad()) {
-                setError("Failed to save media file\nDisk full?", false);
-                return;
-            }
-
-            // Resize it.
-            if (it->resizeFile) {
-                if (!resizeImage(filePath, it->subDirectory)) {
-                    setError("Error saving resized image\nOut of memory? Disk full?", false);
-                    return;
-                }
-            }
-
-            mResult.savedNewMedia = true;
+            mFuncs.push_back(ResolvePair(
+                std::make_unique<MediaDownloadHandle>(
+                    it->fileURL, filePath, it->existingMediaFile, it->subDirectory,
+                    it->resizeFile, mResult.savedNewMedia, mResult.thumbnailImageData),
+                [filePath] {}));
         }
         // If it's not cached, then initiate the download.
         else {
@@ -412,173 +542,107 @@ MediaDownloadHandle::MediaDownloadHandle(const std::string& url,
                                          const std::string& existingMediaPath,
                                          const std::string& mediaType,
                                          const bool resizeFile,
-                                         bool& savedNewMedia)
-    : mReq(new HttpReq(url, true))
-    , mSavePath(path)
+                                         bool& savedNewMedia,
+                                         const std::string& mediaData)
+    : mSavePath(path)
+    , mTempPath(path + ".part")
     , mExistingMediaFile(existingMediaPath)
     , mMediaType(mediaType)
     , mResizeFile(resizeFile)
 {
     mSavedNewMediaPtr = &savedNewMedia;
-}
 
-void MediaDownloadHandle::update()
-{
-    if (mReq->status() == HttpReq::REQ_IN_PROGRESS)
-        return;
-
-    if (mReq->status() != HttpReq::REQ_SUCCESS) {
-        std::stringstream ss;
-        ss << "Network error: " << mReq->getErrorMsg();
-        setError(ss.str(), true);
+    if (!mediaData.empty()) {
+        startSaving(mediaData);
         return;
     }
 
-    // This seems to take care of a strange race condition where the media saving and
-    // resizing would sometimes take place twice.
-    if (mStatus == ASYNC_DONE)
+    // The temporary file is created in the media directory, so check that it exists before
+    // starting the download.
+    if (!Utils::FileSystem::isDirectory(Utils::FileSystem::getParent(mSavePath))) {
+        setError("Media directory does not exist and can't be created. Permission problems?",
+                 false);
+        LOG(LogError) << "Couldn't create media directory: \""
+                      << Utils::FileSystem::getParent(mSavePath) << "\"";
         return;
+    }
 
-    // Download is done, save it to disk.
+    // The response is written straight to the temporary file, which means that large files
+    // such as videos and manuals are never held in memory.
+    mReq = std::make_unique<HttpReq>(url, true, mTempPath);
+}
 
-    // There are multiple issues with box back covers at ScreenScraper. Some only contain a single
-    // color like pure black or more commonly pure green, and some are mostly transparent with just
-    // a few black lines at the bottom. The following code attempts to detect such broken images
-    // and skip them so they're not saved to disk.
-    if (Settings::getInstance()->getString("Scraper") == "screenscraper" &&
-        mMediaType == "backcovers") {
-        bool emptyImage {false};
-        FREE_IMAGE_FORMAT imageFormat {FIF_UNKNOWN};
-        std::string imageData {mReq->getContent()};
-        FIMEMORY* memoryStream {FreeImage_OpenMemory(reinterpret_cast<BYTE*>(&imageData.at(0)),
-                                                     static_cast<DWORD>(imageData.size()))};
-        imageFormat = FreeImage_GetFileTypeFromMemory(memoryStream, 0);
-
-        if (imageFormat != FIF_UNKNOWN) {
-            emptyImage = true;
-
-            FIBITMAP* tempImage {FreeImage_LoadFromMemory(imageFormat, memoryStream)};
-            RGBQUAD firstPixel;
-            RGBQUAD currPixel;
-
-            unsigned int width {FreeImage_GetWidth(tempImage)};
-            unsigned int height {FreeImage_GetHeight(tempImage)};
-
-            // Skip really small images as they're obviously not valid.
-            if (width < 50) {
-                emptyImage = true;
-            }
-            else if (height < 50) {
-                emptyImage = true;
-            }
-            else {
-                // Remove the alpha channel which will convert fully transparent pixels to black.
-                if (FreeImage_GetBPP(tempImage) != 24) {
-                    FIBITMAP* convertImage {FreeImage_ConvertTo24Bits(tempImage)};
-                    FreeImage_Unload(tempImage);
-                    tempImage = convertImage;
-                }
+MediaDownloadHandle::~MediaDownloadHandle()
+{
+    // An unfinished or failed download leaves a partial file behind. Once the file has been
+    // handed over to the worker it's the responsibility of the worker to clean it up.
+    if (mReq) {
+        mReq.reset();
+        if (Utils::FileSystem::exists(mTempPath))
+            Utils::FileSystem::removeFile(mTempPath);
+    }
+}
 
-                // Skip the first line as this can apparently lead to false positives.
-                FreeImage_GetPixelColor(tempImage, 0, 1, &firstPixel);
+void MediaDownloadHandle::update()
+{
+    if (mStatus == ASYNC_DONE || mStatus == ASYNC_ERROR)
+        return;
 
-                for (unsigned int x {0}; x < width; ++x) {
-                    if (!emptyImage)
-                        break;
-                    // Skip the last line as well.
-                    for (unsigned int y {1}; y < height - 1; ++y) {
-                        FreeImage_GetPixelColor(tempImage, x, y, &currPixel);
-                        if (currPixel.rgbBlue != firstPixel.rgbBlue ||
-                            currPixel.rgbGreen != firstPixel.rgbGreen ||
-                            currPixel.rgbRed != firstPixel.rgbRed) {
-                            emptyImage = false;
-                            break;
-                        }
-                    }
-                }
-            }
-            FreeImage_Unload(tempImage);
-        }
-        FreeImage_CloseMemory(memoryStream);
+    if (mSaveState) {
+        if (!mSaveState->done)
+            return;
 
-        if (emptyImage) {
-            LOG(LogWarning) << "ScreenScraper: Image does not seem to contain any data, not saving "
-                               "it to disk: \""
-#if defined(_WIN64)
-                            << Utils::String::replace(mSavePath, "/", "\\") << "\"";
-#else
-                            << mSavePath << "\"";
-#endif
-            setStatus(ASYNC_DONE);
+        if (!mSaveState->errorMessage.empty()) {
+            setError(mSaveState->errorMessage, false);
             return;
         }
-    }
 
-    // Remove any existing media file before attempting to write a new one.
-    // This avoids the problem where there's already a file for this media type
-    // with a different format/extension (e.g. game.jpg and we're going to write
-    // game.png) which would lead to two media files for this game.
-    if (mExistingMediaFile != "")
-        Utils::FileSystem::removeFile(mExistingMediaFile);
+        // If this media file was successfully saved, update savedNewMedia in ScraperSearchResult.
+        if (mSaveState->savedNewMedia)
+            *mSavedNewMediaPtr = true;
 
-    // If the media directory does not exist, something is wrong, possibly permission
-    // problems or the MediaDirectory setting points to a file instead of a directory.
-    if (!Utils::FileSystem::isDirectory(Utils::FileSystem::getParent(mSavePath))) {
-        setError("Media directory does not exist and can't be created. Permission problems?",
-                 false);
-        LOG(LogError) << "Couldn't create media directory: \""
-                      << Utils::FileSystem::getParent(mSavePath) << "\"";
+        setStatus(ASYNC_DONE);
         return;
     }
 
-#if defined(_WIN64)
-    std::ofstream stream(Utils::String::stringToWideString(mSavePath).c_str(),
-                         std::ios_base::out | std::ios_base::binary);
-#else
-    std::ofstream stream(mSavePath, std::ios_base::out | std::ios_base::binary);
-#endif
-    if (!stream || stream.bad()) {
-        setError("Failed to open path for writing media file\nPermission error?", false);
+    if (mReq->status() == HttpReq::REQ_IN_PROGRESS)
         return;
-    }
 
-    const std::string& content {mReq->getContent()};
-    stream.write(content.data(), content.length());
-    stream.close();
-    if (stream.bad()) {
-        setError("Failed to save media file\nDisk full?", false);
+    if (mReq->status() != HttpReq::REQ_SUCCESS) {
+        std::stringstream ss;
+        ss << "Network error: " << mReq->getErrorMsg();
+        setError(ss.str(), true);
+        mReq.reset();
+        if (Utils::FileSystem::exists(mTempPath))
+            Utils::FileSystem::removeFile(mTempPath);
         return;
     }
 
-    if (mMediaType == "manuals") {
-#if defined(_WIN64)
-        LOG(LogDebug) << "Scraper::update(): Saving game manual \""
-                      << Utils::String::replace(mSavePath, "/", "\\") << "\"";
-#else
-        LOG(LogDebug) << "Scraper::update(): Saving game manual \"" << mSavePath << "\"";
-#endif
-    }
-    else if (mMediaType == "videos") {
-#if defined(_WIN64)
-        LOG(LogDebug) << "Scraper::update(): Saving video \""
-                      << Utils::String::replace(mSavePath, "/", "\\") << "\"";
-#else
-        LOG(LogDebug) << "Scraper::update(): Saving video \"" << mSavePath << "\"";
-#endif
-    }
-
-    // Resize it.
-    if (mResizeFile) {
-        if (!resizeImage(mSavePath, mMediaType)) {
-            setError("Error saving resized image\nOut of memory? Disk full?", false);
-            return;
-        }
-    }
-
-    // If this media file was successfully saved, update savedNewMedia in ScraperSearchResult.
-    *mSavedNewMediaPtr = true;
+    // Download is done, the file has already been closed by HttpReq.
+    mReq.reset();
+    startSaving("");
+}
 
-    setStatus(ASYNC_DONE);
+void MediaDownloadHandle::startSaving(const std::string& mediaData)
+{
+    MediaSaveTask task {mediaData,
+                        mTempPath,
+                        mSavePath,
+                        mExistingMediaFile,
+                        mMediaType,
+                        mResizeFile,
+                        Settings::getInstance()->getString("Scraper") == "screenscraper" &&
+                            mMediaType == "backcovers"};
+
+    mSaveState = std::make_shared<SaveState>();
+    getMediaSavePool().submit([task, state = mSaveState] {
+        bool savedNewMedia {false};
+        const std::string errorMessage {saveMediaFile(task, savedNewMedia)};
+        state->errorMessage = errorMessage;
+        state->savedNewMedia = savedNewMedia;
+        // The completion is picked up by MediaDownloadHandle::update() on the main thread.
+        state->done = true;
+    });
 }
 
 bool resizeImage(const std::string& path, const std::string& mediaType)
@@ -17,6 +17,7 @@
 #include "PlatformId.h"
 
 #include <assert.h>
+#include <atomic>
 #include <functional>
 #include <memory>
 #include <queue>
@@ -37,6 +38,8 @@ struct ScraperSearchParams {
     SystemData* system;
     FileData* game;
     std::string md5Hash;
+    std::string crc32Hash;
+    std::string sha1Hash;
     long fileSize;
 
     std::string nameOverride;
@@ -163,6 +166,11 @@ std::vector<std::string> getScraperList();
 // Returns true if the scraper configured in the settings is still valid.
 bool isValidConfiguredScraper();
 
+// How many concurrent requests the scraper service allows for the account in use, as reported
+// in the server responses. Returns 0 if this is not known (yet).
+unsigned int getScraperMaxThreads();
+void setScraperMaxThreads(unsigned int maxThreads);
+
 using generate_scraper_requests_func =
     void (*)(const ScraperSearchParams& params,
              std::queue<std::unique_ptr<ScraperRequest>>& requests,
@@ -191,6 +199,9 @@ private:
     std::vector<ResolvePair> mFuncs;
 };
 
+// Downloads the media file to a temporary file next to the target path, and then hands it over
+// to a background worker which checks, renames and resizes it. If mediaData is set then no
+// download takes place and the data is saved directly, this is used for cached thumbnails.
 class MediaDownloadHandle : public AsyncHandle
 {
 public:
@@ -199,13 +210,26 @@ public:
                         const std::string& existingMediaPath,
                         const std::string& mediaType,
                         const bool resizeFile,
-                        bool& savedNewMedia);
+                        bool& savedNewMedia,
+                        const std::string& mediaData = "");
+    ~MediaDownloadHandle();
 
     void update() override;
 
 private:
+    // Shared with the worker so it stays valid if the handle is deleted while saving.
+    struct SaveState {
+        std::atomic<bool> done {false};
+        std::string errorMessage;
+        bool savedNewMedia {false};
+    };
+
+    void startSaving(const std::string& mediaData);
+
     std::unique_ptr<HttpReq> mReq;
+    std::shared_ptr<SaveState> mSaveState;
     std::string mSavePath;
+    std::string mTempPath;
     std::string mExistingMediaFile;
     std::string mMediaType;
     bool mResizeFile;
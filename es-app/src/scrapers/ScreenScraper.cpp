@@ -202,8 +202,7 @@ void screenscraper_generate_scraper_requests(const ScraperSearchParams& params,
     if (params.nameOverride == "") {
         if (Settings::getInstance()->getBool("ScraperSearchMetadataName")) {
             path = ssConfig.getGameSearchUrl(
-                Utils::String::removeParenthesis(params.game->metadata.get("name")), params.md5Hash,
-                params.fileSize);
+                Utils::String::removeParenthesis(params.game->metadata.get("name")), params);
         }
         else {
             std::string cleanName;
@@ -217,11 +216,11 @@ void screenscraper_generate_scraper_requests(const ScraperSearchParams& params,
                 cleanName = params.game->getCleanName();
             }
 
-            path = ssConfig.getGameSearchUrl(cleanName, params.md5Hash, params.fileSize);
+            path = ssConfig.getGameSearchUrl(cleanName, params);
         }
     }
     else {
-        path = ssConfig.getGameSearchUrl(params.nameOverride, params.md5Hash, params.fileSize);
+        path = ssConfig.getGameSearchUrl(params.nameOverride, params);
     }
 
     auto& platforms = params.system->getPlatformIds();
@@ -361,6 +360,15 @@ void ScreenScraperRequest::processGame(const pugi::xml_document& xmldoc,
     unsigned requestsToday {data.child("ssuser").child("requeststoday").text().as_uint()};
     unsigned maxRequestsPerDay {data.child("ssuser").child("maxrequestsperday").text().as_uint()};
     unsigned int scraperRequestAllowance {maxRequestsPerDay - requestsToday};
+    unsigned int maxThreads {data.child("ssuser").child("maxthreads").text().as_uint()};
+
+    // The number of concurrent requests allowed for the account, used by the multi-scraper
+    // to limit how many games are searched for at the same time.
+    if (maxThreads > 0 && maxThreads != getScraperMaxThreads()) {
+        LOG(LogDebug) << "ScreenScraperRequest::processGame(): Maximum number of threads: "
+                      << maxThreads;
+        setScraperMaxThreads(maxThreads);
+    }
 
     // Scraping allowance.
     if (maxRequestsPerDay > 0) {
@@ -751,15 +759,18 @@ int ScreenScraperRequest::processMedia(ScraperSearchResult& result,
     return regionPos;
 }
 
-std::string ScreenScraperRequest::ScreenScraperConfig::getGameSearchUrl(const std::string& gameName,
-                                                                        const std::string& md5Hash,
-                                                                        const long fileSize) const
+std::string ScreenScraperRequest::ScreenScraperConfig::getGameSearchUrl(
+    const std::string& gameName, const ScraperSearchParams& params) const
 {
+    const std::string& md5Hash {params.md5Hash};
+    const long fileSize {params.fileSize};
+
     if (md5Hash != "") {
         LOG(LogDebug)
-            << "ScreenScraperRequest::getGameSearchUrl(): Performing MD5 file hash search "
-               "using digest \""
-            << md5Hash << "\"";
+            << "ScreenScraperRequest::getGameSearchUrl(): Performing file hash search "
+               "using MD5 digest \""
+            << md5Hash << "\", CRC32 \"" << params.crc32Hash << "\" and SHA1 digest \""
+            << params.sha1Hash << "\"";
     }
     else if (md5Hash == "" && Settings::getInstance()->getBool("ScraperSearchFileHash") &&
              fileSize >
@@ -851,6 +862,11 @@ std::string ScreenScraperRequest::ScreenScraperConfig::getGameSearchUrl(const st
                 .append(md5Hash)
                 .append("&romtaille=")
                 .append(std::to_string(fileSize));
+            // The CRC32 and SHA1 hashes are optional but make matches more reliable.
+            if (params.crc32Hash != "")
+                screenScraperURL.append("&crc=").append(params.crc32Hash);
+            if (params.sha1Hash != "")
+                screenScraperURL.append("&sha1=").append(params.sha1Hash);
         }
     }
     else {
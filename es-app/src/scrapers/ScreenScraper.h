@@ -42,8 +42,7 @@ public:
     // Settings for the scraper.
     static const struct ScreenScraperConfig {
         std::string getGameSearchUrl(const std::string& gameName,
-                                     const std::string& md5Hash,
-                                     const long fileSize) const;
+                                     const ScraperSearchParams& params) const;
 
         // Access to the API.
         const std::string API_DEV_U = {15, 21, 39, 22, 42, 40};
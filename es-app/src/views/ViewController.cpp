@@ -31,6 +31,7 @@
 #include "guis/GuiMenu.h"
 #include "guis/GuiTextEditKeyboardPopup.h"
 #include "guis/GuiTextEditPopup.h"
+#include "resources/Font.h"
 #include "views/GamelistView.h"
 #include "views/SystemView.h"
 
@@ -1337,6 +1338,16 @@ void ViewController::preload()
     if (SystemData::sSystemVector.size() > 0)
         ThemeData::setThemeTransitions();
 
+    // Rasterize the glyphs used by the game names in the background, so that scrolling to games
+    // with characters outside the ASCII range won't cause frame spikes on first display.
+    for (auto system : SystemData::sSystemVector) {
+        if (system->isCollection())
+            continue;
+        for (auto game : system->getRootFolder()->getFilesRecursive(GAME))
+            Font::addPrewarmCharacters(game->getName());
+    }
+    Font::prewarmGlyphs();
+
     // Load navigation sounds, either from the theme if it supports it, or otherwise from
     // the bundled fallback sound files.
     bool themeSoundSupport {false};
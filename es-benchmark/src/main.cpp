@@ -0,0 +1,254 @@
+//  SPDX-License-Identifier: MIT
+//
+//  ES-DE benchmark
+//  main.cpp
+//
+//  Measures the performance of the pixel processing kernels in PixelUtil, comparing the
+//  vectorized code paths to the scalar code paths as well as to CImg where applicable.
+//  Also verifies that all code paths give identical output.
+//
+//  Usage: es-benchmark [width] [height] [iterations]
+//
+//  The column limit is 100 characters.
+//  All ES-DE C++ source code is formatted using clang-format.
+//
+
+#define cimg_display 0
+
+#include "CImg.h"
+#include "utils/PixelUtil.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    int width {1920};
+    int height {1080};
+    int iterations {20};
+    int mismatches {0};
+
+    // Returns the average time in milliseconds for a single run of the function.
+    double measure(const std::function<void()>& function)
+    {
+        // Warm up the caches before starting the measurement.
+        function();
+        const auto start {std::chrono::steady_clock::now()};
+        for (int i {0}; i < iterations; ++i)
+            function();
+        const std::chrono::duration<double, std::milli> duration {
+            std::chrono::steady_clock::now() - start};
+        return duration.count() / iterations;
+    }
+
+    // Runs the setup and kernel functions with the vectorized and scalar code paths, and
+    // compares the output which is returned by the setup function as a reference to the buffer.
+    void benchmark(const std::string& name,
+                   const std::function<std::vector<unsigned char>&()>& setup,
+                   const std::function<void()>& kernel,
+                   const std::function<void()>& reference = nullptr)
+    {
+        Utils::Pixel::setVectorization(false);
+        std::vector<unsigned char>& output {setup()};
+        kernel();
+        const std::vector<unsigned char> scalarOutput {output};
+        const double scalarTime {measure([&] {
+            setup();
+            kernel();
+        })};
+
+        Utils::Pixel::setVectorization(true);
+        setup();
+        kernel();
+        const bool identical {output == scalarOutput};
+        const double vectorTime {measure([&] {
+            setup();
+            kernel();
+        })};
+
+        if (!identical)
+            ++mismatches;
+
+        std::cout << std::left << std::setw(16) << name << std::right << std::fixed
+                  << std::setprecision(3) << std::setw(12) << scalarTime << std::setw(12)
+                  << vectorTime << std::setw(9) << std::setprecision(2)
+                  << scalarTime / vectorTime << "x";
+
+        if (reference) {
+            const double referenceTime {measure([&] {
+                setup();
+                reference();
+            })};
+            std::cout << std::setw(12) << std::setprecision(3) << referenceTime;
+        }
+        else {
+            std::cout << std::setw(12) << "-";
+        }
+
+        std::cout << (identical ? "" : "  MISMATCH") << std::endl;
+    }
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    if (argc > 1)
+        width = std::max(1, atoi(argv[1]));
+    if (argc > 2)
+        height = std::max(1, atoi(argv[2]));
+    if (argc > 3)
+        iterations = std::max(1, atoi(argv[3]));
+
+    const size_t numPixels {static_cast<size_t>(width) * height};
+
+    std::cout << "Image size " << width << "x" << height << ", " << iterations
+              << " iterations, instruction set " << Utils::Pixel::getInstructionSet() << "\n"
+              << std::endl;
+    std::cout << std::left << std::setw(16) << "Kernel" << std::right << std::setw(12)
+              << "Scalar (ms)" << std::setw(12) << "Vector (ms)" << std::setw(10) << "Speedup"
+              << std::setw(12) << "CImg (ms)" << std::endl;
+
+    // Random pixels with a fair amount of fully transparent and opaque values.
+    std::mt19937 generator {1};
+    std::vector<unsigned char> pixels(numPixels * 4);
+    for (auto& value : pixels) {
+        const unsigned int random {static_cast<unsigned int>(generator())};
+        value = (random % 4 == 0) ? 0 : (random % 4 == 1) ? 255 : random >> 24;
+    }
+
+    std::vector<unsigned char> planes(numPixels * 4);
+    unsigned char* const planePtrs[4] {planes.data(), planes.data() + numPixels,
+                                       planes.data() + numPixels * 2,
+                                       planes.data() + numPixels * 3};
+    std::vector<unsigned char> output;
+    cimg_library::CImg<unsigned char> image(width, height, 1, 4);
+
+    benchmark(
+        "deinterleave", [&]() -> std::vector<unsigned char>& { return planes; },
+        [&] { Utils::Pixel::deinterleave(pixels.data(), planePtrs, numPixels); },
+        [&] {
+            int counter {0};
+            for (int r {0}; r < height; ++r) {
+                for (int c {0}; c < width; ++c) {
+                    for (int channel {0}; channel < 4; ++channel)
+                        image(c, r, 0, channel) = pixels[counter + channel];
+                    counter += 4;
+                }
+            }
+        });
+
+    benchmark(
+        "interleave",
+        [&]() -> std::vector<unsigned char>& {
+            output.assign(numPixels * 4, 0);
+            return output;
+        },
+        [&] {
+            Utils::Pixel::interleave({planePtrs[0], planePtrs[1], planePtrs[2], planePtrs[3]},
+                                     output.data(), numPixels);
+        },
+        [&] {
+            output.clear();
+            for (int r {0}; r < height; ++r) {
+                for (int c {0}; c < width; ++c) {
+                    for (int channel {0}; channel < 4; ++channel)
+                        output.emplace_back(image(c, r, 0, channel));
+                }
+            }
+        });
+
+    // The last row of an otherwise transparent image is opaque, which is the worst case.
+    std::vector<unsigned char> transparent(numPixels, 0);
+    std::fill(transparent.end() - width, transparent.end(), 255);
+    std::vector<unsigned char> zeroOutput(1);
+    benchmark(
+        "isZero",
+        [&]() -> std::vector<unsigned char>& {
+            zeroOutput[0] = 0;
+            return zeroOutput;
+        },
+        [&] {
+            for (int r {0}; r < height; ++r)
+                zeroOutput[0] += Utils::Pixel::isZero(transparent.data() + r * width, width);
+        });
+
+    benchmark(
+        "orBytes",
+        [&]() -> std::vector<unsigned char>& {
+            output.assign(width, 0);
+            return output;
+        },
+        [&] {
+            for (int r {0}; r < height; ++r)
+                Utils::Pixel::orBytes(output.data(), planePtrs[3] + r * width, width);
+        });
+
+    benchmark(
+        "swapBytes",
+        [&]() -> std::vector<unsigned char>& {
+            output = pixels;
+            return output;
+        },
+        [&] {
+            const size_t rowSize {static_cast<size_t>(width) * 4};
+            for (int r {0}; r < height / 2; ++r)
+                Utils::Pixel::swapBytes(output.data() + r * rowSize,
+                                        output.data() + (height - r - 1) * rowSize, rowSize);
+        });
+
+    benchmark(
+        "premultiply",
+        [&]() -> std::vector<unsigned char>& {
+            output.assign(numPixels, 0);
+            return output;
+        },
+        [&] {
+            Utils::Pixel::premultiply(output.data(), planePtrs[0], planePtrs[3], numPixels);
+        });
+
+    benchmark(
+        "alphaOver",
+        [&]() -> std::vector<unsigned char>& {
+            output.assign(planePtrs[2], planePtrs[2] + numPixels);
+            return output;
+        },
+        [&] { Utils::Pixel::alphaOver(output.data(), planePtrs[3], numPixels); });
+
+    // Same parameters as used for the miximage drop shadows.
+    constexpr unsigned int boxSize {5};
+    constexpr unsigned int blurIterations {2};
+    cimg_library::CImg<unsigned char> alphaImage(width, height, 1, 1);
+
+    benchmark(
+        "boxBlur",
+        [&]() -> std::vector<unsigned char>& {
+            output.assign(planePtrs[3], planePtrs[3] + numPixels);
+            std::copy_n(planePtrs[3], numPixels, alphaImage.data());
+            return output;
+        },
+        [&] { Utils::Pixel::boxBlur(output.data(), width, height, boxSize, blurIterations); },
+        [&] { alphaImage.blur_box(boxSize, boxSize, 1, true, blurIterations); });
+
+    // Also make sure that the blur is identical to the CImg implementation.
+    output.assign(planePtrs[3], planePtrs[3] + numPixels);
+    std::copy_n(planePtrs[3], numPixels, alphaImage.data());
+    Utils::Pixel::boxBlur(output.data(), width, height, boxSize, blurIterations);
+    alphaImage.blur_box(boxSize, boxSize, 1, true, blurIterations);
+    if (!std::equal(output.cbegin(), output.cend(), alphaImage.data())) {
+        std::cout << "boxBlur output differs from CImg" << std::endl;
+        ++mismatches;
+    }
+
+    if (mismatches > 0) {
+        std::cout << "\n" << mismatches << " kernel(s) gave mismatching output" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
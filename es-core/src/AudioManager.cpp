@@ -99,14 +99,14 @@ void AudioManager::init()
     }
 
     // Just in case someone changed the es_settings.xml file manually to invalid values.
-    if (Settings::getInstance()->getInt("SoundVolumeNavigation") > 100)
-        Settings::getInstance()->setInt("SoundVolumeNavigation", 100);
-    if (Settings::getInstance()->getInt("SoundVolumeNavigation") < 0)
-        Settings::getInstance()->setInt("SoundVolumeNavigation", 0);
-    if (Settings::getInstance()->getInt("SoundVolumeVideos") > 100)
-        Settings::getInstance()->setInt("SoundVolumeVideos", 100);
-    if (Settings::getInstance()->getInt("SoundVolumeVideos") < 0)
-        Settings::getInstance()->setInt("SoundVolumeVideos", 0);
+    if (Settings::getInstance()->getInt(Settings::IntID::SOUND_VOLUME_NAVIGATION) > 100)
+        Settings::getInstance()->setInt(Settings::IntID::SOUND_VOLUME_NAVIGATION, 100);
+    if (Settings::getInstance()->getInt(Settings::IntID::SOUND_VOLUME_NAVIGATION) < 0)
+        Settings::getInstance()->setInt(Settings::IntID::SOUND_VOLUME_NAVIGATION, 0);
+    if (Settings::getInstance()->getInt(Settings::IntID::SOUND_VOLUME_VIDEOS) > 100)
+        Settings::getInstance()->setInt(Settings::IntID::SOUND_VOLUME_VIDEOS, 100);
+    if (Settings::getInstance()->getInt(Settings::IntID::SOUND_VOLUME_VIDEOS) < 0)
+        Settings::getInstance()->setInt(Settings::IntID::SOUND_VOLUME_VIDEOS, 0);
 
     setupAudioStream(sRequestedAudioFormat.freq);
 }
@@ -131,6 +131,12 @@ void AudioManager::mixAudio(void* /*unused*/, Uint8* stream, int len)
     // Initialize the buffer to "silence".
     SDL_memset(stream, 0, len);
 
+    // This runs on the audio thread so the volumes are read using the atomic indexed settings.
+    const int navigationVolume {static_cast<int>(
+        Settings::getInstance()->getInt(Settings::IntID::SOUND_VOLUME_NAVIGATION) * 1.28f)};
+    const int videoVolume {static_cast<int>(
+        Settings::getInstance()->getInt(Settings::IntID::SOUND_VOLUME_VIDEOS) * 1.28f)};
+
     // Iterate through all our samples.
     std::vector<std::shared_ptr<Sound>>::const_iterator soundIt = sSoundVector.cbegin();
     while (soundIt != sSoundVector.cend()) {
@@ -143,9 +149,8 @@ void AudioManager::mixAudio(void* /*unused*/, Uint8* stream, int len)
                 restLength = len;
             }
             // Mix sample into stream.
-            SDL_MixAudioFormat(
-                stream, &(sound->getData()[sound->getPosition()]), sAudioFormat.format, restLength,
-                static_cast<int>(Settings::getInstance()->getInt("SoundVolumeNavigation") * 1.28f));
+            SDL_MixAudioFormat(stream, &(sound->getData()[sound->getPosition()]),
+                               sAudioFormat.format, restLength, navigationVolume);
             if (sound->getPosition() + restLength < sound->getLength()) {
                 // Sample hasn't ended yet.
                 stillPlaying = true;
@@ -201,9 +206,8 @@ void AudioManager::mixAudio(void* /*unused*/, Uint8* stream, int len)
         SDL_MixAudioFormat(stream, &converted.at(0), sAudioFormat.format, processedLength, 0);
     }
     else {
-        SDL_MixAudioFormat(
-            stream, &converted.at(0), sAudioFormat.format, processedLength,
-            static_cast<int>(Settings::getInstance()->getInt("SoundVolumeVideos") * 1.28f));
+        SDL_MixAudioFormat(stream, &converted.at(0), sAudioFormat.format, processedLength,
+                           videoVolume);
     }
 
     // If nothing is playing, pause the device until there is more audio to output.
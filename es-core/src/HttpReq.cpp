@@ -11,9 +11,11 @@
 
 #include "ApplicationVersion.h"
 #include "Log.h"
+#include "Profiler.h"
 #include "Settings.h"
 #include "resources/ResourceManager.h"
 #include "utils/FileSystemUtil.h"
+#include "utils/StringUtil.h"
 
 #include <algorithm>
 #include <assert.h>
@@ -38,7 +40,7 @@ std::string HttpReq::urlEncode(const std::string& s)
     return escaped;
 }
 
-HttpReq::HttpReq(const std::string& url, bool scraperRequest)
+HttpReq::HttpReq(const std::string& url, bool scraperRequest, const std::string& filePath)
     : mStatus {REQ_IN_PROGRESS}
     , mHandle {nullptr}
     , mTotalBytes {0}
@@ -50,6 +52,20 @@ HttpReq::HttpReq(const std::string& url, bool scraperRequest)
     if (!sMultiHandle)
         sMultiHandle = curl_multi_init();
 
+    if (filePath != "") {
+#if defined(_WIN64)
+        mFile.open(Utils::String::stringToWideString(filePath).c_str(),
+                   std::ios_base::out | std::ios_base::binary);
+#else
+        mFile.open(filePath, std::ios_base::out | std::ios_base::binary);
+#endif
+        if (!mFile.is_open()) {
+            mStatus = REQ_IO_ERROR;
+            onError("Couldn't open file for writing");
+            return;
+        }
+    }
+
     mHandle = curl_easy_init();
 
     if (mHandle == nullptr) {
@@ -308,8 +324,16 @@ size_t HttpReq::writeContent(void* buff, size_t size, size_t nmemb, void* req_pt
 
     if (validEntry) {
         // size = size of an element, nmemb = number of elements.
-        std::stringstream& ss {static_cast<HttpReq*>(req_ptr)->mContent};
-        ss.write(static_cast<char*>(buff), size * nmemb);
+        HttpReq* req {static_cast<HttpReq*>(req_ptr)};
+        if (req->mFile.is_open()) {
+            req->mFile.write(static_cast<char*>(buff), size * nmemb);
+            // Returning zero makes curl abort the transfer with CURLE_WRITE_ERROR.
+            if (req->mFile.fail())
+                return 0;
+        }
+        else {
+            req->mContent.write(static_cast<char*>(buff), size * nmemb);
+        }
     }
 
     requestLock.unlock();
@@ -368,6 +392,7 @@ void HttpReq::pollCurl()
             std::unique_lock<std::mutex> handleLock {sHandleMutex};
             CURLMcode merr {curl_multi_perform(sMultiHandle, &handleCount)};
             handleLock.unlock();
+            Profiler::setCounter(Profiler::HTTP_REQUESTS, handleCount);
             if (merr != CURLM_OK && merr != CURLM_CALL_MULTI_PERFORM) {
                 LOG(LogError) << "Error reading data from multi: " << curl_multi_strerror(merr);
             }
@@ -385,6 +410,18 @@ void HttpReq::pollCurl()
                         continue;
                     }
 
+                    // Make sure all data has been written to disk before reporting the status.
+                    const bool fileTransfer {req->mFile.is_open()};
+                    if (fileTransfer) {
+                        req->mFile.close();
+                        if (req->mFile.fail() && msg->data.result == CURLE_OK) {
+                            req->mStatus = REQ_IO_ERROR;
+                            req->onError("Couldn't write the downloaded data to disk");
+                            requestLock.unlock();
+                            continue;
+                        }
+                    }
+
                     if (msg->data.result == CURLE_OK) {
                         req->mStatus = REQ_SUCCESS;
                     }
@@ -396,7 +433,7 @@ void HttpReq::pollCurl()
                         long responseCode;
                         curl_easy_getinfo(msg->easy_handle, CURLINFO_RESPONSE_CODE, &responseCode);
 
-                        if (responseCode == 430 &&
+                        if (responseCode == 430 && !fileTransfer &&
                             Settings::getInstance()->getString("Scraper") == "screenscraper") {
                             req->mContent << "You have exceeded your daily scrape quota";
                             req->mStatus = REQ_SUCCESS;
@@ -13,6 +13,7 @@
 #include <curl/curl.h>
 
 #include <atomic>
+#include <fstream>
 #include <map>
 #include <mutex>
 #include <queue>
@@ -22,7 +23,9 @@
 class HttpReq
 {
 public:
-    HttpReq(const std::string& url, bool scraperRequest);
+    // If filePath is set the response body is streamed to that file instead of being kept in
+    // memory, and the file is closed before the status changes to REQ_SUCCESS.
+    HttpReq(const std::string& url, bool scraperRequest, const std::string& filePath = "");
     ~HttpReq();
 
     enum Status {
@@ -84,6 +87,7 @@ private:
     static inline std::mutex sRequestMutex;
 
     std::stringstream mContent;
+    std::ofstream mFile;
     std::string mErrorMsg;
     static inline std::atomic<bool> sStopPoll = false;
     std::atomic<long> mTotalBytes;
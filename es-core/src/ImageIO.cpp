@@ -9,27 +9,83 @@
 #include "ImageIO.h"
 
 #include "Log.h"
+#include "utils/PixelUtil.h"
 
 #include <FreeImage.h>
+#include <algorithm>
+#include <cmath>
 #include <string.h>
 
 std::vector<unsigned char> ImageIO::loadFromMemoryRGBA32(const unsigned char* data,
                                                          const size_t size,
                                                          size_t& width,
                                                          size_t& height)
+{
+    size_t sourceWidth {0};
+    size_t sourceHeight {0};
+    return loadFromMemoryRGBA32(data, size, 0, 0, width, height, sourceWidth, sourceHeight);
+}
+
+std::vector<unsigned char> ImageIO::loadFromMemoryRGBA32(const unsigned char* data,
+                                                         const size_t size,
+                                                         const size_t maxWidth,
+                                                         const size_t maxHeight,
+                                                         size_t& width,
+                                                         size_t& height,
+                                                         size_t& sourceWidth,
+                                                         size_t& sourceHeight)
 {
     std::vector<unsigned char> rawData;
     width = 0;
     height = 0;
+    sourceWidth = 0;
+    sourceHeight = 0;
     FIMEMORY* fiMemory {FreeImage_OpenMemory(const_cast<BYTE*>(data), static_cast<DWORD>(size))};
 
     if (fiMemory != nullptr) {
         // Detect the filetype from data.
         FREE_IMAGE_FORMAT format {FreeImage_GetFileTypeFromMemory(fiMemory)};
         if (format != FIF_UNKNOWN && FreeImage_FIFSupportsReading(format)) {
+            size_t targetWidth {0};
+            size_t targetHeight {0};
+            int loadFlags {0};
+
+            if ((maxWidth != 0 || maxHeight != 0) && FreeImage_FIFSupportsNoPixels(format)) {
+                // Read only the header to find out whether the image needs to be scaled down.
+                FIBITMAP* fiHeader {FreeImage_LoadFromMemory(format, fiMemory, FIF_LOAD_NOPIXELS)};
+                if (fiHeader != nullptr) {
+                    sourceWidth = FreeImage_GetWidth(fiHeader);
+                    sourceHeight = FreeImage_GetHeight(fiHeader);
+                    FreeImage_Unload(fiHeader);
+                }
+                FreeImage_SeekMemory(fiMemory, 0, SEEK_SET);
+
+                if (sourceWidth != 0 && sourceHeight != 0) {
+                    // An axis set to zero doesn't constrain the size.
+                    const double scale {std::max(
+                        static_cast<double>(maxWidth) / static_cast<double>(sourceWidth),
+                        static_cast<double>(maxHeight) / static_cast<double>(sourceHeight))};
+                    if (scale < 1.0) {
+                        targetWidth = std::max(
+                            static_cast<size_t>(std::ceil(sourceWidth * scale)), size_t {1});
+                        targetHeight = std::max(
+                            static_cast<size_t>(std::ceil(sourceHeight * scale)), size_t {1});
+                        // The JPEG decoder can scale down by a factor of 2, 4 or 8 while
+                        // decoding, the requested size in the upper bits is the minimum size
+                        // of the longest side.
+                        if (format == FIF_JPEG)
+                            loadFlags = static_cast<int>(std::max(targetWidth, targetHeight) << 16);
+                    }
+                }
+            }
+
             // File type is supported, load image.
-            FIBITMAP* fiBitmap {FreeImage_LoadFromMemory(format, fiMemory)};
+            FIBITMAP* fiBitmap {FreeImage_LoadFromMemory(format, fiMemory, loadFlags)};
             if (fiBitmap != nullptr) {
+                if (sourceWidth == 0 || sourceHeight == 0) {
+                    sourceWidth = FreeImage_GetWidth(fiBitmap);
+                    sourceHeight = FreeImage_GetHeight(fiBitmap);
+                }
                 // Loaded. convert to 32-bit if necessary.
                 if (FreeImage_GetBPP(fiBitmap) != 32) {
                     FIBITMAP* fiConverted {FreeImage_ConvertTo32Bits(fiBitmap)};
@@ -39,6 +95,17 @@ std::vector<unsigned char> ImageIO::loadFromMemoryRGBA32(const unsigned char* da
                         fiBitmap = fiConverted;
                     }
                 }
+                if (targetWidth != 0 && (FreeImage_GetWidth(fiBitmap) != targetWidth ||
+                                         FreeImage_GetHeight(fiBitmap) != targetHeight)) {
+                    FIBITMAP* fiRescaled {FreeImage_Rescale(fiBitmap,
+                                                            static_cast<int>(targetWidth),
+                                                            static_cast<int>(targetHeight),
+                                                            FILTER_BILINEAR)};
+                    if (fiRescaled != nullptr) {
+                        FreeImage_Unload(fiBitmap);
+                        fiBitmap = fiRescaled;
+                    }
+                }
                 FreeImage_PreMultiplyWithAlpha(fiBitmap);
 
                 if (fiBitmap != nullptr) {
@@ -74,13 +141,8 @@ std::vector<unsigned char> ImageIO::loadFromMemoryRGBA32(const unsigned char* da
 
 void ImageIO::flipPixelsVert(unsigned char* imagePx, const size_t& width, const size_t& height)
 {
-    unsigned int temp;
-    unsigned int* arr {reinterpret_cast<unsigned int*>(imagePx)};
-    for (size_t y = 0; y < height / 2; ++y) {
-        for (size_t x = 0; x < width; ++x) {
-            temp = arr[x + (y * width)];
-            arr[x + (y * width)] = arr[x + (height * width) - ((y + 1) * width)];
-            arr[x + (height * width) - ((y + 1) * width)] = temp;
-        }
-    }
+    const size_t rowSize {width * 4};
+    for (size_t y = 0; y < height / 2; ++y)
+        Utils::Pixel::swapBytes(imagePx + y * rowSize, imagePx + (height - y - 1) * rowSize,
+                                rowSize);
 }
@@ -19,6 +19,17 @@ public:
                                                            const size_t size,
                                                            size_t& width,
                                                            size_t& height);
+    // If maxWidth or maxHeight is set then larger images are scaled down while keeping the
+    // aspect ratio so that they still cover this size, JPEG images are scaled already by the
+    // decoder. The dimensions of the image file itself are returned in sourceWidth/sourceHeight.
+    static std::vector<unsigned char> loadFromMemoryRGBA32(const unsigned char* data,
+                                                           const size_t size,
+                                                           const size_t maxWidth,
+                                                           const size_t maxHeight,
+                                                           size_t& width,
+                                                           size_t& height,
+                                                           size_t& sourceWidth,
+                                                           size_t& sourceHeight);
     static void flipPixelsVert(unsigned char* imagePx, const size_t& width, const size_t& height);
 };
 
@@ -4,24 +4,15 @@
 //  Log.cpp
 //
 //  Log output.
-//  This class is thread safe.
+//  This class is thread safe. Messages are added to a lock-free queue and written to disk
+//  by a background thread so logging only blocks on file I/O for errors.
 //
 
 #include "Log.h"
 #include "Settings.h"
 #include "utils/StringUtil.h"
 
-LogLevel Log::getReportingLevel()
-{
-    std::unique_lock<std::mutex> lock {sLogMutex};
-    return sReportingLevel;
-}
-
-void Log::setReportingLevel(LogLevel level)
-{
-    std::unique_lock<std::mutex> lock {sLogMutex};
-    sReportingLevel = level;
-}
+#include <ctime>
 
 void Log::init()
 {
@@ -38,40 +29,82 @@ void Log::init()
 
 void Log::open()
 {
-    std::unique_lock<std::mutex> lock {sLogMutex};
 #if defined(_WIN64)
     sFile.open(Utils::String::stringToWideString(sLogPath).c_str());
 #else
     sFile.open(sLogPath.c_str());
 #endif
+
+    if (!sFile.is_open() || sWriterRunning)
+        return;
+
+    // Each slot holds the position it can next be written at, see pushMessage().
+    sQueue = std::make_unique<QueueSlot[]>(QUEUE_SIZE);
+    for (size_t i {0}; i < QUEUE_SIZE; ++i)
+        sQueue[i].sequence.store(i, std::memory_order_relaxed);
+
+    sEnqueuePosition = 0;
+    sDequeuePosition = 0;
+    sWrittenPosition = 0;
+    sWriterExit = false;
+    sWriterRunning = true;
+    sWriterThread = std::thread(&Log::writerThread);
 }
 
 void Log::flush()
 {
-    std::unique_lock<std::mutex> lock {sLogMutex};
-    sFile.flush();
+    if (!sWriterRunning) {
+        if (sFile.is_open())
+            sFile.flush();
+        return;
+    }
+
+    const size_t position {sEnqueuePosition.load()};
+    std::unique_lock<std::mutex> lock {sWriterMutex};
+    sFlushRequested = true;
+    sWriterEvent.notify_one();
+    sFlushedEvent.wait(lock, [position] {
+        return sWrittenPosition.load() >= position || !sWriterRunning;
+    });
 }
 
 void Log::close()
 {
-    std::unique_lock<std::mutex> lock {sLogMutex};
+    if (sWriterRunning) {
+        {
+            std::unique_lock<std::mutex> lock {sWriterMutex};
+            sWriterExit = true;
+        }
+        sWriterEvent.notify_one();
+        if (sWriterThread.joinable())
+            sWriterThread.join();
+    }
+
     if (sFile.is_open())
         sFile.close();
 }
 
 std::ostringstream& Log::get(LogLevel level)
 {
-    time_t t {time(nullptr)};
-    struct tm tm;
+    // The timestamp only has a resolution of one second so only format it when it changes.
+    thread_local time_t cachedTime {0};
+    thread_local char timestamp[32] {};
+
+    const time_t t {time(nullptr)};
+    if (t != cachedTime) {
+        struct tm tm;
 #if defined(_WIN64)
-    // Of course Windows does not follow standards and puts the parameters the other way
-    // around compared to POSIX.
-    localtime_s(&tm, &t);
+        // Of course Windows does not follow standards and puts the parameters the other way
+        // around compared to POSIX.
+        localtime_s(&tm, &t);
 #else
-    localtime_r(&t, &tm);
+        localtime_r(&t, &tm);
 #endif
-    std::unique_lock<std::mutex> lock {sLogMutex};
-    mOutStringStream << std::put_time(&tm, "%b %d %H:%M:%S ") << mLogLevelMap[level]
+        strftime(timestamp, sizeof(timestamp), "%b %d %H:%M:%S ", &tm);
+        cachedTime = t;
+    }
+
+    mOutStringStream << timestamp << LEVEL_NAMES[level]
                      << (level == LogLevel::LogInfo || level == LogLevel::LogWarning ? ":   " :
                                                                                        ":  ");
     mMessageLevel = level;
@@ -81,46 +114,159 @@ std::ostringstream& Log::get(LogLevel level)
 
 Log::~Log()
 {
-    std::unique_lock<std::mutex> lock {sLogMutex};
-    mOutStringStream << std::endl;
+    mOutStringStream << '\n';
+
+    if (sWriterRunning) {
+        if (!pushMessage(mOutStringStream.str(), mMessageLevel))
+            ++sDroppedMessages;
+        // Errors are written to the file before returning in case the application is about to
+        // crash. The writer thread is also woken up early if messages are logged in rapid
+        // succession.
+        if (mMessageLevel == LogError && std::this_thread::get_id() != sWriterThread.get_id()) {
+            flush();
+        }
+        else if (sEnqueuePosition.load(std::memory_order_relaxed) -
+                     sDequeuePosition.load(std::memory_order_relaxed) >=
+                 QUEUE_SIZE / 4) {
+            sWriterWakeup = true;
+            sWriterEvent.notify_one();
+        }
+        return;
+    }
 
-    if (!sFile.is_open()) {
-        // Not open yet, print to stdout.
+    // Not open yet, print to stdout.
 #if defined(__ANDROID__)
-        __android_log_print(
-            ANDROID_LOG_ERROR, ANDROID_APPLICATION_ID,
-            "Error: Tried to write to log file before it was open, the following won't be logged:");
-        __android_log_print(ANDROID_LOG_ERROR, ANDROID_APPLICATION_ID, "%s",
-                            mOutStringStream.str().c_str());
+    __android_log_print(
+        ANDROID_LOG_ERROR, ANDROID_APPLICATION_ID,
+        "Error: Tried to write to log file before it was open, the following won't be logged:");
+    __android_log_print(ANDROID_LOG_ERROR, ANDROID_APPLICATION_ID, "%s",
+                        mOutStringStream.str().c_str());
 #else
-        std::cerr << "Error: Tried to write to log file before it was open, "
-                     "the following won't be logged:\n";
-        std::cerr << mOutStringStream.str();
+    std::cerr << "Error: Tried to write to log file before it was open, "
+                 "the following won't be logged:\n";
+    std::cerr << mOutStringStream.str();
 #endif
-        return;
+}
+
+bool Log::pushMessage(std::string&& text, const LogLevel level)
+{
+    // Bounded multi-producer queue, each slot has a sequence number which tells whether it's
+    // free to be written at the current enqueue position or still waiting to be consumed.
+    size_t position {sEnqueuePosition.load(std::memory_order_relaxed)};
+    QueueSlot* slot {nullptr};
+
+    while (true) {
+        slot = &sQueue[position & (QUEUE_SIZE - 1)];
+        const size_t sequence {slot->sequence.load(std::memory_order_acquire)};
+        const long long difference {static_cast<long long>(sequence) -
+                                    static_cast<long long>(position)};
+        if (difference == 0) {
+            if (sEnqueuePosition.compare_exchange_weak(position, position + 1,
+                                                       std::memory_order_relaxed))
+                break;
+        }
+        else if (difference < 0) {
+            return false;
+        }
+        else {
+            position = sEnqueuePosition.load(std::memory_order_relaxed);
+        }
     }
 
-    sFile << mOutStringStream.str();
+    slot->message.text = std::move(text);
+    slot->message.level = level;
+    slot->sequence.store(position + 1, std::memory_order_release);
+
+    return true;
+}
+
+bool Log::popMessage(Message& message)
+{
+    const size_t position {sDequeuePosition.load(std::memory_order_relaxed)};
+    QueueSlot& slot {sQueue[position & (QUEUE_SIZE - 1)]};
+
+    // Either the queue is empty or the producer hasn't finished writing the slot yet.
+    if (slot.sequence.load(std::memory_order_acquire) != position + 1)
+        return false;
+
+    message = std::move(slot.message);
+    slot.sequence.store(position + QUEUE_SIZE, std::memory_order_release);
+    sDequeuePosition.store(position + 1, std::memory_order_release);
+
+    return true;
+}
 
+void Log::writeToConsole(const Message& message)
+{
 #if defined(__ANDROID__)
-    if (mMessageLevel == LogError) {
+    if (message.level == LogError) {
         __android_log_print(ANDROID_LOG_ERROR, ANDROID_APPLICATION_ID, "%s",
-                            mOutStringStream.str().c_str());
+                            message.text.c_str());
     }
-    else if (sReportingLevel >= LogDebug) {
-        if (mMessageLevel == LogInfo)
+    else if (getReportingLevel() >= LogDebug) {
+        if (message.level == LogInfo)
             __android_log_print(ANDROID_LOG_INFO, ANDROID_APPLICATION_ID, "%s",
-                                mOutStringStream.str().c_str());
-        else if (mMessageLevel == LogWarning)
+                                message.text.c_str());
+        else if (message.level == LogWarning)
             __android_log_print(ANDROID_LOG_WARN, ANDROID_APPLICATION_ID, "%s",
-                                mOutStringStream.str().c_str());
+                                message.text.c_str());
         else
             __android_log_print(ANDROID_LOG_DEBUG, ANDROID_APPLICATION_ID, "%s",
-                                mOutStringStream.str().c_str());
+                                message.text.c_str());
     }
 #else
     // If it's an error or the --debug flag has been set, then print to the console as well.
-    if (mMessageLevel == LogError || sReportingLevel >= LogDebug)
-        std::cerr << mOutStringStream.str();
+    if (message.level == LogError || getReportingLevel() >= LogDebug)
+        std::cerr << message.text;
 #endif
 }
+
+void Log::writerThread()
+{
+    Message message;
+    std::string batch;
+    bool exit {false};
+
+    while (true) {
+        // Write everything that has been queued so far with a single flush.
+        while (popMessage(message)) {
+            batch.append(message.text);
+            writeToConsole(message);
+        }
+
+        const unsigned int droppedMessages {sDroppedMessages.exchange(0)};
+        if (droppedMessages > 0) {
+            batch.append("Warning: The log queue was full, ")
+                .append(std::to_string(droppedMessages))
+                .append(" messages were dropped\n");
+        }
+
+        if (!batch.empty()) {
+            sFile << batch;
+            sFile.flush();
+            batch.clear();
+        }
+
+        // Only now have the messages actually been written to the file.
+        sWrittenPosition = sDequeuePosition.load();
+
+        std::unique_lock<std::mutex> lock {sWriterMutex};
+        sFlushedEvent.notify_all();
+
+        if (exit)
+            break;
+
+        // The wakeup flag is set without holding the mutex so a notification may occasionally
+        // be missed, in which case the messages are written once the interval has passed.
+        sWriterEvent.wait_for(lock, WRITE_INTERVAL,
+                              [] { return sWriterExit || sFlushRequested || sWriterWakeup; });
+        sFlushRequested = false;
+        sWriterWakeup = false;
+        // Make one more pass to write the remaining messages before exiting.
+        exit = sWriterExit;
+    }
+
+    std::unique_lock<std::mutex> lock {sWriterMutex};
+    sWriterRunning = false;
+    sFlushedEvent.notify_all();
+}
@@ -4,7 +4,8 @@
 //  Log.h
 //
 //  Log output.
-//  This class is thread safe.
+//  This class is thread safe. Messages are added to a lock-free queue and written to disk
+//  by a background thread so logging never blocks on file I/O.
 //
 
 #ifndef ES_CORE_LOG_H
@@ -12,12 +13,17 @@
 
 #include "utils/FileSystemUtil.h"
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <sstream>
+#include <thread>
 
 #if defined(__ANDROID__)
 #include <android/log.h>
@@ -43,13 +49,14 @@ public:
 
     std::ostringstream& get(LogLevel level = LogInfo);
 
-    static LogLevel getReportingLevel();
-    static void setReportingLevel(LogLevel level);
+    static LogLevel getReportingLevel() { return sReportingLevel.load(std::memory_order_relaxed); }
+    static void setReportingLevel(LogLevel level) { sReportingLevel = level; }
 
     // These functions are not thread safe.
     static void init();
     static void open();
 
+    // Blocks until all queued messages have been written to the log file.
     static void flush();
     static void close();
 
@@ -57,14 +64,48 @@ protected:
     std::ostringstream mOutStringStream;
 
 private:
-    std::map<LogLevel, std::string> mLogLevelMap {// Log level indicators.
-                                                  {LogError, "Error"},
-                                                  {LogWarning, "Warn"},
-                                                  {LogInfo, "Info"},
-                                                  {LogDebug, "Debug"}};
+    struct Message {
+        std::string text;
+        LogLevel level;
+    };
+
+    struct QueueSlot {
+        std::atomic<size_t> sequence;
+        Message message;
+    };
+
+    // Returns false if the queue is full.
+    static bool pushMessage(std::string&& text, const LogLevel level);
+    // Only called from the writer thread.
+    static bool popMessage(Message& message);
+    static void writeToConsole(const Message& message);
+    static void writerThread();
+
+    // Must be a power of two.
+    static inline const size_t QUEUE_SIZE {16384};
+    // How often the writer thread wakes up to write the queued messages.
+    static inline const std::chrono::milliseconds WRITE_INTERVAL {100};
+
+    static constexpr const char* LEVEL_NAMES[] {"Error", "Warn", "Info", "Debug"};
+
+    static inline std::unique_ptr<QueueSlot[]> sQueue;
+    static inline std::atomic<size_t> sEnqueuePosition {0};
+    static inline std::atomic<size_t> sDequeuePosition {0};
+    // Position up to which the messages have been written and flushed to the log file.
+    static inline std::atomic<size_t> sWrittenPosition {0};
+    static inline std::atomic<unsigned int> sDroppedMessages {0};
+
+    static inline std::thread sWriterThread;
+    static inline std::mutex sWriterMutex;
+    static inline std::condition_variable sWriterEvent;
+    static inline std::condition_variable sFlushedEvent;
+    static inline std::atomic<bool> sWriterRunning {false};
+    static inline bool sWriterExit {false};
+    static inline bool sFlushRequested {false};
+    static inline std::atomic<bool> sWriterWakeup {false};
+
     static inline std::ofstream sFile;
-    static inline LogLevel sReportingLevel = LogInfo;
-    static inline std::mutex sLogMutex;
+    static inline std::atomic<LogLevel> sReportingLevel {LogInfo};
     static inline std::string sLogPath;
     LogLevel mMessageLevel;
 };
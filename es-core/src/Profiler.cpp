@@ -0,0 +1,183 @@
+//  SPDX-License-Identifier: MIT
+//
+//  ES-DE
+//  Profiler.cpp
+//
+//  Opt-in timing of the main loop phases and some subsystems, enabled using the --profile
+//  command line option. The statistics are shown in the GPU statistics overlay and all
+//  events are exported as a Chrome trace file on shutdown.
+//  This class is thread safe.
+//
+
+#include "Profiler.h"
+
+#include "Log.h"
+#include "Settings.h"
+#include "utils/FileSystemUtil.h"
+#include "utils/StringUtil.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace
+{
+    const char* counterNames[] {"Texture queue", "Video frame queue", "Audio frame queue",
+                                "HTTP requests", "Glyph rasterizations"};
+} // namespace
+
+Profiler::Profiler()
+    : mStartTime {std::chrono::steady_clock::now()}
+    , mCounters {}
+    , mLastGlyphCount {0}
+    , mTraceFull {false}
+{
+}
+
+Profiler& Profiler::getInstance()
+{
+    static Profiler instance;
+    return instance;
+}
+
+void Profiler::setEnabled(const bool state)
+{
+    // Make sure the main thread is assigned the first thread index.
+    getThreadIndex();
+    mStartTime = std::chrono::steady_clock::now();
+    sEnabled = state;
+}
+
+void Profiler::addEvent(const char* name,
+                        const std::chrono::steady_clock::time_point startTime,
+                        const std::chrono::steady_clock::time_point endTime)
+{
+    const long long start {getMicroseconds(startTime)};
+    const long long duration {getMicroseconds(endTime) - start};
+    const unsigned int thread {getThreadIndex()};
+
+    std::unique_lock<std::mutex> lock {mMutex};
+
+    auto totals = std::find_if(mEventTotals.begin(), mEventTotals.end(),
+                               [name](const EventTotals& entry) { return entry.name == name; });
+    if (totals == mEventTotals.end())
+        mEventTotals.emplace_back(EventTotals {name, duration, 1});
+    else {
+        totals->duration += duration;
+        ++totals->count;
+    }
+
+    if (mEvents.size() + mCounterSamples.size() < MAX_TRACE_EVENTS)
+        mEvents.emplace_back(Event {name, start, duration, thread});
+    else
+        mTraceFull = true;
+}
+
+void Profiler::endFrame()
+{
+    if (!getEnabled())
+        return;
+
+    CounterSample sample {getMicroseconds(std::chrono::steady_clock::now()), {}};
+    for (size_t i {0}; i < COUNTER_COUNT; ++i)
+        sample.values[i] = mCounters[i].load(std::memory_order_relaxed);
+
+    std::unique_lock<std::mutex> lock {mMutex};
+
+    // Only record the counters when they have changed to keep the trace size down.
+    if (!mCounterSamples.empty() && mCounterSamples.back().values == sample.values)
+        return;
+
+    if (mEvents.size() + mCounterSamples.size() < MAX_TRACE_EVENTS)
+        mCounterSamples.emplace_back(sample);
+    else
+        mTraceFull = true;
+}
+
+std::string Profiler::getStatistics()
+{
+    std::stringstream ss;
+    std::unique_lock<std::mutex> lock {mMutex};
+
+    ss << std::fixed << std::setprecision(2);
+
+    // Durations are averaged per event rather than per frame as the subsystem events don't
+    // occur on every frame.
+    for (auto& totals : mEventTotals) {
+        ss << "\n"
+           << totals.name << ": "
+           << static_cast<float>(totals.duration) / static_cast<float>(totals.count) / 1000.0f
+           << " ms (" << totals.count << ")";
+    }
+
+    const int glyphCount {mCounters[GLYPH_RASTERIZATIONS].load(std::memory_order_relaxed)};
+    ss << "\n"
+       << counterNames[TEXTURE_QUEUE] << ": " << mCounters[TEXTURE_QUEUE] << "\n"
+       << counterNames[VIDEO_FRAME_QUEUE] << ": " << mCounters[VIDEO_FRAME_QUEUE] << " video, "
+       << mCounters[AUDIO_FRAME_QUEUE] << " audio\n"
+       << counterNames[HTTP_REQUESTS] << ": " << mCounters[HTTP_REQUESTS] << "\n"
+       << counterNames[GLYPH_RASTERIZATIONS] << ": " << glyphCount - mLastGlyphCount;
+
+    mEventTotals.clear();
+    mLastGlyphCount = glyphCount;
+
+    return ss.str();
+}
+
+void Profiler::writeTrace()
+{
+    std::string tracePath;
+
+    if (Settings::getInstance()->getBool("LegacyAppDataDirectory"))
+        tracePath = Utils::FileSystem::getAppDataDirectory() + "/es_trace.json";
+    else
+        tracePath = Utils::FileSystem::getAppDataDirectory() + "/logs/es_trace.json";
+
+#if defined(_WIN64)
+    std::ofstream traceFile {Utils::String::stringToWideString(tracePath).c_str(),
+                             std::ios::out | std::ios::trunc};
+#else
+    std::ofstream traceFile {tracePath, std::ios::out | std::ios::trunc};
+#endif
+
+    if (!traceFile.good()) {
+        LOG(LogError) << "Couldn't write profiling trace file \"" << tracePath << "\"";
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock {mMutex};
+
+    traceFile << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    traceFile << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,"
+                 "\"args\":{\"name\":\"Main\"}}";
+
+    for (auto& event : mEvents) {
+        traceFile << ",\n{\"name\":\"" << event.name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":"
+                  << event.thread << ",\"ts\":" << event.startTime
+                  << ",\"dur\":" << event.duration << "}";
+    }
+
+    for (auto& sample : mCounterSamples) {
+        for (size_t i {0}; i < COUNTER_COUNT; ++i) {
+            traceFile << ",\n{\"name\":\"" << counterNames[i]
+                      << "\",\"ph\":\"C\",\"pid\":1,\"ts\":" << sample.time
+                      << ",\"args\":{\"value\":" << sample.values[i] << "}}";
+        }
+    }
+
+    traceFile << "\n]}\n";
+    traceFile.close();
+
+    LOG(LogInfo) << "Wrote " << mEvents.size() << " profiling events to \"" << tracePath << "\"";
+    if (mTraceFull) {
+        LOG(LogWarning) << "The profiling trace reached its maximum size of " << MAX_TRACE_EVENTS
+                        << " events, later events were not recorded";
+    }
+}
+
+unsigned int Profiler::getThreadIndex()
+{
+    thread_local const unsigned int threadIndex {sThreadCount++};
+    return threadIndex;
+}
@@ -0,0 +1,141 @@
+//  SPDX-License-Identifier: MIT
+//
+//  ES-DE
+//  Profiler.h
+//
+//  Opt-in timing of the main loop phases and some subsystems, enabled using the --profile
+//  command line option. The statistics are shown in the GPU statistics overlay and all
+//  events are exported as a Chrome trace file on shutdown.
+//  This class is thread safe.
+//
+
+#ifndef ES_CORE_PROFILER_H
+#define ES_CORE_PROFILER_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class Profiler
+{
+public:
+    enum Counter {
+        TEXTURE_QUEUE,
+        VIDEO_FRAME_QUEUE,
+        AUDIO_FRAME_QUEUE,
+        HTTP_REQUESTS,
+        GLYPH_RASTERIZATIONS,
+        COUNTER_COUNT
+    };
+
+    // Times the scope it's declared in. The name has to be a string literal as only the
+    // pointer is stored. Does nothing if the profiler is disabled.
+    class ScopedTimer
+    {
+    public:
+        ScopedTimer(const char* name)
+            : mName {Profiler::getEnabled() ? name : nullptr}
+        {
+            if (mName != nullptr)
+                mStartTime = std::chrono::steady_clock::now();
+        }
+        ~ScopedTimer() { stop(); }
+
+        // Ends the current event and starts timing a new one.
+        void restart(const char* name)
+        {
+            stop();
+            mName = (Profiler::getEnabled() ? name : nullptr);
+            mStartTime = std::chrono::steady_clock::now();
+        }
+
+        void stop()
+        {
+            if (mName != nullptr)
+                Profiler::getInstance().addEvent(mName, mStartTime,
+                                                 std::chrono::steady_clock::now());
+            mName = nullptr;
+        }
+
+    private:
+        const char* mName;
+        std::chrono::steady_clock::time_point mStartTime;
+    };
+
+    static Profiler& getInstance();
+
+    // Has to be called from the main thread before any other thread uses the profiler.
+    void setEnabled(const bool state);
+    static const bool getEnabled() { return sEnabled.load(std::memory_order_relaxed); }
+
+    void addEvent(const char* name,
+                  const std::chrono::steady_clock::time_point startTime,
+                  const std::chrono::steady_clock::time_point endTime);
+
+    static void setCounter(const Counter counter, const int value)
+    {
+        if (getEnabled())
+            getInstance().mCounters[counter].store(value, std::memory_order_relaxed);
+    }
+    static void incrementCounter(const Counter counter)
+    {
+        if (getEnabled())
+            getInstance().mCounters[counter].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Called once per frame by the main loop to sample the counters.
+    void endFrame();
+
+    // Averages since the previous call, formatted for the statistics overlay.
+    std::string getStatistics();
+
+    // Write the Chrome trace event file, can be opened in chrome://tracing or in Perfetto.
+    void writeTrace();
+
+private:
+    Profiler();
+
+    struct Event {
+        const char* name;
+        long long startTime;
+        long long duration;
+        unsigned int thread;
+    };
+
+    struct CounterSample {
+        long long time;
+        std::array<int, COUNTER_COUNT> values;
+    };
+
+    struct EventTotals {
+        const char* name;
+        long long duration;
+        unsigned int count;
+    };
+
+    long long getMicroseconds(const std::chrono::steady_clock::time_point time)
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(time - mStartTime).count();
+    }
+    static unsigned int getThreadIndex();
+
+    std::mutex mMutex;
+    std::chrono::steady_clock::time_point mStartTime;
+    std::vector<Event> mEvents;
+    std::vector<CounterSample> mCounterSamples;
+    // Totals per event name since the last getStatistics() call.
+    std::vector<EventTotals> mEventTotals;
+    std::array<std::atomic<int>, COUNTER_COUNT> mCounters;
+    int mLastGlyphCount;
+    bool mTraceFull;
+
+    static inline std::atomic<bool> sEnabled {false};
+    static inline std::atomic<unsigned int> sThreadCount {0};
+    // Around 32 MiB, which is several minutes of a busy session.
+    static inline const size_t MAX_TRACE_EVENTS {1000000};
+};
+
+#endif // ES_CORE_PROFILER_H
@@ -5,7 +5,7 @@
 //
 //  Functions to read from and write to the configuration file es_settings.xml.
 //  The default values for the application settings are defined here as well.
-//  This class is not thread safe.
+//  This class is not thread safe, apart from the getters for the indexed settings.
 //
 
 #include "Settings.h"
@@ -57,6 +57,27 @@ namespace
         // clang-format on
     };
 
+    // Names of the indexed settings, in the same order as Settings::BoolID and Settings::IntID.
+    const std::array<std::string, static_cast<size_t>(Settings::BoolID::COUNT)> boolIDNames {
+        "CacheDecodedImages",
+        "Debug",
+        "DebugGrid",
+        "DebugImage",
+        "DebugText",
+        "DisplayGPUStatistics",
+        "FavoritesFirst",
+        "FoldersOnTop",
+        "ShowHiddenFiles",
+        "ShowHiddenGames",
+    };
+
+    const std::array<std::string, static_cast<size_t>(Settings::IntID::COUNT)> intIDNames {
+        "CacheDecodedImagesSize",
+        "MaxVRAM",
+        "SoundVolumeNavigation",
+        "SoundVolumeVideos",
+    };
+
     template <typename K, typename V>
     void saveMap(pugi::xml_document& doc, std::map<K, V>& map, const std::string& type)
     {
@@ -75,12 +96,20 @@ namespace
 } // namespace
 
 Settings::Settings()
+    : mBoolValues {}
+    , mIntValues {}
 {
     mWasChanged = false;
     setDefaults();
     if (Utils::FileSystem::getFileName(Utils::FileSystem::getAppDataDirectory()) ==
         ".emulationstation")
         mBoolMap["LegacyAppDataDirectory"] = std::make_pair(true, true);
+
+    for (auto& name : boolIDNames)
+        updateIndexedValue(name);
+    for (auto& name : intIDNames)
+        updateIndexedValue(name);
+
     loadFile();
 }
 
@@ -142,11 +171,13 @@ void Settings::setDefaults()
     mBoolMap["MiximageIncludeBox"] = {true, true};
     mBoolMap["MiximageCoverFallback"] = {true, true};
     mBoolMap["MiximageIncludePhysicalMedia"] = {true, true};
+    mBoolMap["MiximageOfflineMultithreaded"] = {true, true};
 
     mStringMap["ScraperRegion"] = {"eu", "eu"};
     mStringMap["ScraperLanguage"] = {"en", "en"};
     mIntMap["ScraperRetryOnErrorCount"] = {3, 3};
     mIntMap["ScraperRetryOnErrorTimer"] = {3, 3};
+    mIntMap["ScraperConcurrentGames"] = {1, 1};
     mIntMap["ScraperSearchFileHashMaxSize"] = {384, 384};
     mBoolMap["ScraperOverwriteData"] = {true, true};
     mBoolMap["ScraperIgnoreHTTP404Errors"] = {true, true};
@@ -295,11 +326,15 @@ void Settings::setDefaults()
 #else
     mBoolMap["VideoUpscaleFrameRate"] = {false, false};
 #endif
+    mBoolMap["VideoDecodeAtDisplaySize"] = {true, true};
+    mBoolMap["VideoShaderColorConversion"] = {false, false};
     mBoolMap["AlternativeEmulatorPerGame"] = {true, true};
     mBoolMap["ShowHiddenFiles"] = {true, true};
     mBoolMap["ShowHiddenGames"] = {true, true};
     mBoolMap["CustomEventScripts"] = {false, false};
     mBoolMap["ParseGamelistOnly"] = {false, false};
+    mBoolMap["CacheROMDirectories"] = {true, true};
+    mBoolMap["CacheDecodedImages"] = {false, false};
     mBoolMap["MAMENameStripExtraInfo"] = {true, true};
 #if defined(__unix__) && !defined(__ANDROID__)
     mBoolMap["DisableComposition"] = {false, false};
@@ -352,10 +387,12 @@ void Settings::setDefaults()
 #if !defined(__ANDROID__)
     mStringMap["UserThemeDirectory"] = {"", ""};
 #endif
+    mIntMap["CacheDecodedImagesSize"] = {1024, 1024};
     mIntMap["LottieMaxFileCache"] = {150, 150};
     mIntMap["LottieMaxTotalCache"] = {1024, 1024};
     mIntMap["ScraperConnectionTimeout"] = {30, 30};
     mIntMap["ScraperTransferTimeout"] = {120, 120};
+    mIntMap["TextureLoaderThreads"] = {0, 0};
 
     //
     // Hardcoded or program-internal settings.
@@ -472,6 +509,7 @@ void Settings::loadFile()
     {                                                                                              \
         if (mapName.count(name) == 0 || mapName[name].second != value) {                           \
             mapName[name].second = value;                                                          \
+            updateIndexedValue(name);                                                              \
                                                                                                    \
             if (std::find(settingsSkipSaving.cbegin(), settingsSkipSaving.cend(), name) ==         \
                 settingsSkipSaving.cend())                                                         \
@@ -487,3 +525,34 @@ SETTINGS_GETSET(bool, mBoolMap, getBool, getDefaultBool, setBool)
 SETTINGS_GETSET(int, mIntMap, getInt, getDefaultInt, setInt)
 SETTINGS_GETSET(float, mFloatMap, getFloat, getDefaultFloat, setFloat)
 SETTINGS_GETSET(const std::string&, mStringMap, getString, getDefaultString, setString)
+
+bool Settings::setBool(const BoolID id, bool value)
+{
+    return setBool(boolIDNames[static_cast<size_t>(id)], value);
+}
+
+bool Settings::setInt(const IntID id, int value)
+{
+    return setInt(intIDNames[static_cast<size_t>(id)], value);
+}
+
+void Settings::updateIndexedValue(const std::string& name)
+{
+    for (size_t i {0}; i < boolIDNames.size(); ++i) {
+        if (boolIDNames[i] == name) {
+            auto it = mBoolMap.find(name);
+            if (it != mBoolMap.cend())
+                mBoolValues[i].store(it->second.second, std::memory_order_relaxed);
+            return;
+        }
+    }
+
+    for (size_t i {0}; i < intIDNames.size(); ++i) {
+        if (intIDNames[i] == name) {
+            auto it = mIntMap.find(name);
+            if (it != mIntMap.cend())
+                mIntValues[i].store(it->second.second, std::memory_order_relaxed);
+            return;
+        }
+    }
+}
@@ -5,12 +5,14 @@
 //
 //  Functions to read from and write to the configuration file es_settings.xml.
 //  The default values for the application settings are defined here as well.
-//  This class is not thread safe.
+//  This class is not thread safe, apart from the getters for the indexed settings.
 //
 
 #ifndef ES_CORE_SETTINGS_H
 #define ES_CORE_SETTINGS_H
 
+#include <array>
+#include <atomic>
 #include <map>
 #include <memory>
 #include <string>
@@ -19,6 +21,31 @@
 class Settings
 {
 public:
+    // Settings that are read in performance critical code or by other threads than the main
+    // thread. These can be read by index without a map lookup, and as the current values are
+    // mirrored in atomics they can safely be read from any thread.
+    enum class BoolID {
+        CACHE_DECODED_IMAGES,
+        DEBUG,
+        DEBUG_GRID,
+        DEBUG_IMAGE,
+        DEBUG_TEXT,
+        DISPLAY_GPU_STATISTICS,
+        FAVORITES_FIRST,
+        FOLDERS_ON_TOP,
+        SHOW_HIDDEN_FILES,
+        SHOW_HIDDEN_GAMES,
+        COUNT
+    };
+
+    enum class IntID {
+        CACHE_DECODED_IMAGES_SIZE,
+        MAX_VRAM,
+        SOUND_VOLUME_NAVIGATION,
+        SOUND_VOLUME_VIDEOS,
+        COUNT
+    };
+
     static Settings* getInstance();
 
     void loadFile();
@@ -26,8 +53,16 @@ public:
 
     //	You will get a warning if you try a get on a key that is not already present.
     bool getBool(const std::string& name);
+    bool getBool(const BoolID id) const
+    {
+        return mBoolValues[static_cast<size_t>(id)].load(std::memory_order_relaxed);
+    }
     bool getDefaultBool(const std::string& name);
     int getInt(const std::string& name);
+    int getInt(const IntID id) const
+    {
+        return mIntValues[static_cast<size_t>(id)].load(std::memory_order_relaxed);
+    }
     int getDefaultInt(const std::string& name);
     float getFloat(const std::string& name);
     float getDefaultFloat(const std::string& name);
@@ -38,12 +73,16 @@ public:
     bool setInt(const std::string& name, int value);
     bool setFloat(const std::string& name, float value);
     bool setString(const std::string& name, const std::string& value);
+    bool setBool(const BoolID id, bool value);
+    bool setInt(const IntID id, int value);
 
 private:
     Settings();
 
     //	Clear everything and load default values.
     void setDefaults();
+    // Update the atomic copy of the value if it's an indexed setting.
+    void updateIndexedValue(const std::string& name);
 
     bool mWasChanged;
 
@@ -52,6 +91,9 @@ private:
     std::map<std::string, std::pair<int, int>> mIntMap;
     std::map<std::string, std::pair<float, float>> mFloatMap;
     std::map<std::string, std::pair<std::string, std::string>> mStringMap;
+
+    std::array<std::atomic<bool>, static_cast<size_t>(BoolID::COUNT)> mBoolValues;
+    std::array<std::atomic<int>, static_cast<size_t>(IntID::COUNT)> mIntValues;
 };
 
 #endif // ES_CORE_SETTINGS_H
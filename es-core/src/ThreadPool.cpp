@@ -0,0 +1,169 @@
+//  SPDX-License-Identifier: MIT
+//
+//  ES-DE
+//  ThreadPool.cpp
+//
+//  Work-stealing thread pool. Every worker has its own task queue, tasks submitted from
+//  inside a worker are placed on that worker's queue and idle workers steal from the
+//  other queues. Tasks may wait for their own subtasks using runPendingUntil() which
+//  keeps processing queued tasks instead of blocking the worker thread.
+//
+
+#include "ThreadPool.h"
+
+#include <chrono>
+
+namespace
+{
+    // Used to find out whether a task is submitted from one of the pool's own workers.
+    thread_local ThreadPool* sCurrentPool {nullptr};
+    thread_local unsigned int sWorkerIndex {0};
+} // namespace
+
+ThreadPool::ThreadPool(unsigned int threadCount)
+    : mQueuedTasks {0}
+    , mActiveTasks {0}
+    , mCompletedTasks {0}
+    , mNextWorker {0}
+    , mStopRequested {false}
+    , mExit {false}
+{
+    if (threadCount == 0)
+        threadCount = std::thread::hardware_concurrency();
+    if (threadCount == 0)
+        threadCount = 1;
+
+    for (unsigned int i {0}; i < threadCount; ++i)
+        mWorkers.emplace_back(std::make_unique<Worker>());
+
+    // The queues must all exist before any worker starts stealing from them.
+    for (unsigned int i {0}; i < threadCount; ++i)
+        mWorkers[i]->thread = std::thread(&ThreadPool::threadProc, this, i);
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::unique_lock<std::mutex> lock {mMutex};
+        mExit = true;
+    }
+    mTaskEvent.notify_all();
+
+    for (auto& worker : mWorkers) {
+        if (worker->thread.joinable())
+            worker->thread.join();
+    }
+}
+
+void ThreadPool::submit(Task task)
+{
+    unsigned int index {0};
+
+    if (sCurrentPool == this)
+        index = sWorkerIndex;
+    else
+        index = mNextWorker++ % static_cast<unsigned int>(mWorkers.size());
+
+    ++mActiveTasks;
+    {
+        // The counter is updated while holding the mutex so that a worker which has just
+        // found the queues empty can't miss the notification below. It's also incremented
+        // before the task is published as another worker could otherwise run the task and
+        // decrement the counter first, making it wrap around.
+        std::unique_lock<std::mutex> lock {mMutex};
+        ++mQueuedTasks;
+    }
+    {
+        std::unique_lock<std::mutex> lock {mWorkers[index]->mutex};
+        mWorkers[index]->tasks.emplace_back(std::move(task));
+    }
+    mTaskEvent.notify_one();
+}
+
+bool ThreadPool::wait(int timeMs)
+{
+    std::unique_lock<std::mutex> lock {mMutex};
+
+    if (timeMs < 0) {
+        mDoneEvent.wait(lock, [this] { return mActiveTasks == 0; });
+        return true;
+    }
+
+    return mDoneEvent.wait_for(lock, std::chrono::milliseconds(timeMs),
+                               [this] { return mActiveTasks == 0; });
+}
+
+void ThreadPool::runPendingUntil(const std::function<bool()>& predicate)
+{
+    const unsigned int index {sCurrentPool == this ? sWorkerIndex : 0};
+    Task task;
+
+    while (!predicate()) {
+        if (popTask(index, task)) {
+            runTask(task);
+            continue;
+        }
+        // Nothing to help out with, so wait until some other task has finished.
+        std::unique_lock<std::mutex> lock {mMutex};
+        mDoneEvent.wait_for(lock, std::chrono::milliseconds(5));
+    }
+}
+
+void ThreadPool::threadProc(unsigned int index)
+{
+    sCurrentPool = this;
+    sWorkerIndex = index;
+
+    Task task;
+
+    while (true) {
+        if (popTask(index, task)) {
+            runTask(task);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock {mMutex};
+        mTaskEvent.wait(lock, [this] { return mExit || mQueuedTasks > 0; });
+        if (mExit && mQueuedTasks == 0)
+            break;
+    }
+}
+
+bool ThreadPool::popTask(unsigned int index, Task& task)
+{
+    const unsigned int workerCount {static_cast<unsigned int>(mWorkers.size())};
+
+    // Take the most recently added task from our own queue as that is most likely a subtask
+    // of the task we just ran, and steal the oldest task from the other queues.
+    for (unsigned int i {0}; i < workerCount; ++i) {
+        Worker* worker {mWorkers[(index + i) % workerCount].get()};
+        std::unique_lock<std::mutex> lock {worker->mutex};
+        if (worker->tasks.empty())
+            continue;
+        if (i == 0) {
+            task = std::move(worker->tasks.back());
+            worker->tasks.pop_back();
+        }
+        else {
+            task = std::move(worker->tasks.front());
+            worker->tasks.pop_front();
+        }
+        --mQueuedTasks;
+        return true;
+    }
+
+    return false;
+}
+
+void ThreadPool::runTask(Task& task)
+{
+    task();
+    task = nullptr;
+
+    ++mCompletedTasks;
+    {
+        std::unique_lock<std::mutex> lock {mMutex};
+        --mActiveTasks;
+    }
+    mDoneEvent.notify_all();
+}
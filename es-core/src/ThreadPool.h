@@ -0,0 +1,78 @@
+//  SPDX-License-Identifier: MIT
+//
+//  ES-DE
+//  ThreadPool.h
+//
+//  Work-stealing thread pool. Every worker has its own task queue, tasks submitted from
+//  inside a worker are placed on that worker's queue and idle workers steal from the
+//  other queues. Tasks may wait for their own subtasks using runPendingUntil() which
+//  keeps processing queued tasks instead of blocking the worker thread.
+//
+
+#ifndef ES_CORE_THREAD_POOL_H
+#define ES_CORE_THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ThreadPool
+{
+public:
+    using Task = std::function<void()>;
+
+    // If threadCount is zero then the number of hardware threads will be used.
+    ThreadPool(unsigned int threadCount = 0);
+    ~ThreadPool();
+
+    // Queue a task for execution.
+    void submit(Task task);
+
+    // Wait up to timeMs milliseconds for all queued and running tasks to complete.
+    // Returns true if there is no more work left. A negative value waits indefinitely.
+    bool wait(int timeMs = -1);
+
+    // Process queued tasks on the calling thread until the predicate returns true.
+    // This is intended for tasks that need to wait for subtasks they have submitted.
+    void runPendingUntil(const std::function<bool()>& predicate);
+
+    // Signal that tasks should finish as soon as possible, checked by the tasks themselves.
+    void requestStop() { mStopRequested = true; }
+    const bool stopRequested() const { return mStopRequested; }
+
+    const unsigned int getThreadCount() const
+    {
+        return static_cast<unsigned int>(mWorkers.size());
+    }
+    const unsigned int getCompletedTasks() const { return mCompletedTasks; }
+
+private:
+    struct Worker {
+        std::deque<Task> tasks;
+        std::mutex mutex;
+        std::thread thread;
+    };
+
+    void threadProc(unsigned int index);
+    bool popTask(unsigned int index, Task& task);
+    void runTask(Task& task);
+
+    std::vector<std::unique_ptr<Worker>> mWorkers;
+    std::mutex mMutex;
+    std::condition_variable mTaskEvent;
+    std::condition_variable mDoneEvent;
+
+    std::atomic<unsigned int> mQueuedTasks;
+    std::atomic<unsigned int> mActiveTasks;
+    std::atomic<unsigned int> mCompletedTasks;
+    std::atomic<unsigned int> mNextWorker;
+    std::atomic<bool> mStopRequested;
+    std::atomic<bool> mExit;
+};
+
+#endif // ES_CORE_THREAD_POOL_H
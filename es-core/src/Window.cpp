@@ -11,6 +11,7 @@
 
 #include "InputManager.h"
 #include "Log.h"
+#include "Profiler.h"
 #include "Scripting.h"
 #include "Sound.h"
 #include "components/HelpComponent.h"
@@ -372,7 +373,8 @@ void Window::update(int deltaTime)
     if (mFrameTimeElapsed > 500) {
         mAverageDeltaTime = mFrameTimeElapsed / mFrameCountElapsed;
 
-        if (Settings::getInstance()->getBool("DisplayGPUStatistics")) {
+        if (Settings::getInstance()->getBool(Settings::BoolID::DISPLAY_GPU_STATISTICS) ||
+            Profiler::getEnabled()) {
             std::stringstream ss;
 
             // FPS.
@@ -395,6 +397,9 @@ void Window::update(int deltaTime)
             ss << "\nFont VRAM: " << fontVramUsageMiB
                << " MiB\nTexture VRAM: " << textureVramUsageMiB
                << " MiB\nMax Texture VRAM: " << textureTotalUsageMiB << " MiB";
+
+            if (Profiler::getEnabled())
+                ss << Profiler::getInstance().getStatistics();
             mFrameDataText = std::unique_ptr<TextCache>(mDefaultFonts.at(0)->buildTextCache(
                 ss.str(), mRenderer->getScreenWidth() * 0.02f, mRenderer->getScreenHeight() * 0.02f,
                 0xFF00FFFF, 1.3f));
@@ -676,7 +681,9 @@ void Window::render()
         InputOverlay::getInstance().render(mRenderer->getIdentity());
 #endif
 
-    if (Settings::getInstance()->getBool("DisplayGPUStatistics") && mFrameDataText) {
+    if ((Settings::getInstance()->getBool(Settings::BoolID::DISPLAY_GPU_STATISTICS) ||
+         Profiler::getEnabled()) &&
+        mFrameDataText) {
         mRenderer->setMatrix(mRenderer->getIdentity());
         mDefaultFonts.at(1)->renderTextCache(mFrameDataText.get());
     }
@@ -141,7 +141,7 @@ void ButtonComponent::render(const glm::mat4& parentTrans)
                                 (mSize.y - mTextCache->metrics.size.y) / 2.0f, 0.0f};
         trans = glm::translate(trans, glm::round(centerOffset));
 
-        if (Settings::getInstance()->getBool("DebugText")) {
+        if (Settings::getInstance()->getBool(Settings::BoolID::DEBUG_TEXT)) {
             mRenderer->drawRect(centerOffset.x, 0.0f, mTextCache->metrics.size.x, mSize.y,
                                 0x00000033, 0x00000033);
             mRenderer->drawRect(mBox.getPosition().x, 0.0f, mBox.getSize().x, mSize.y, 0x0000FF33,
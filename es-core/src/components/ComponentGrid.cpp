@@ -163,7 +163,7 @@ void ComponentGrid::updateSeparators()
 {
     mSeparators.clear();
 
-    bool drawAll {Settings::getInstance()->getBool("DebugGrid")};
+    bool drawAll {Settings::getInstance()->getBool(Settings::BoolID::DEBUG_GRID)};
 
     glm::vec2 pos;
     glm::vec2 size;
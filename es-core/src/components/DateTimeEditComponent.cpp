@@ -184,7 +184,7 @@ void DateTimeEditComponent::render(const glm::mat4& parentTrans)
 
         mRenderer->setMatrix(trans);
 
-        if (Settings::getInstance()->getBool("DebugText")) {
+        if (Settings::getInstance()->getBool(Settings::BoolID::DEBUG_TEXT)) {
             mRenderer->setMatrix(trans);
             if (mTextCache->metrics.size.x > 0.0f) {
                 mRenderer->drawRect(0.0f, 0.0f - off.y, mSize.x - off.x, mSize.y, 0x0000FF33,
@@ -43,7 +43,7 @@ void FlexboxComponent::render(const glm::mat4& parentTrans)
     glm::mat4 trans {parentTrans * getTransform()};
     mRenderer->setMatrix(trans);
 
-    if (Settings::getInstance()->getBool("DebugImage"))
+    if (Settings::getInstance()->getBool(Settings::BoolID::DEBUG_IMAGE))
         mRenderer->drawRect(0.0f, 0.0f, ceilf(mSize.x), ceilf(mSize.y), 0xFF000033, 0xFF000033);
 
     for (auto& item : mItems) {
@@ -568,7 +568,7 @@ void GIFAnimComponent::render(const glm::mat4& parentTrans)
 
     mRenderer->setMatrix(trans);
 
-    if (Settings::getInstance()->getBool("DebugImage")) {
+    if (Settings::getInstance()->getBool(Settings::BoolID::DEBUG_IMAGE)) {
         if (mTargetIsMax) {
             const glm::vec2 targetSizePos {
                 glm::round((mTargetSize - mSize) * mOrigin * glm::vec2 {-1.0f})};
@@ -594,19 +594,20 @@ void GIFAnimComponent::render(const glm::mat4& parentTrans)
         for (int i {0}; i < 4; ++i)
             vertices[i].position = glm::round(vertices[i].position);
 
-        vertices->brightness = mBrightness;
-        vertices->saturation = mSaturation * mThemeSaturation;
-        vertices->opacity = mOpacity * mThemeOpacity;
-        vertices->dimming = mDimming;
-        vertices->shaderFlags = Renderer::ShaderFlags::PREMULTIPLIED;
+        Renderer::DrawParams params;
+        params.brightness = mBrightness;
+        params.saturation = mSaturation * mThemeSaturation;
+        params.opacity = mOpacity * mThemeOpacity;
+        params.dimming = mDimming;
+        params.shaderFlags = Renderer::ShaderFlags::PREMULTIPLIED;
 
         if (mCornerRadius > 0.0f) {
-            vertices->cornerRadius = mCornerRadius;
-            vertices->shaderFlags = vertices->shaderFlags | Renderer::ShaderFlags::ROUNDED_CORNERS;
+            params.cornerRadius = mCornerRadius;
+            params.shaderFlags |= Renderer::ShaderFlags::ROUNDED_CORNERS;
         }
 
         // Render it.
-        mRenderer->drawTriangleStrips(&vertices[0], 4);
+        mRenderer->drawTriangleStrips(&vertices[0], 4, params);
     }
 
     mHoldFrame = true;
@@ -19,6 +19,7 @@
 ImageComponent::ImageComponent(bool forceLoad, bool dynamic)
     : mRenderer {Renderer::getInstance()}
     , mTargetSize {0.0f, 0.0f}
+    , mMaxTextureSize {0.0f, 0.0f}
     , mFlipX {false}
     , mFlipY {false}
     , mTargetIsMax {false}
@@ -104,8 +105,10 @@ void ImageComponent::setImage(const std::string& path, bool tile)
             }
         }
         else {
-            mTexture = TextureResource::get(path, tile, mForceLoad, mDynamic, mLinearInterpolation,
-                                            mMipmapping, 0, 0, mTileWidth, mTileHeight);
+            mTexture = TextureResource::get(
+                path, tile, mForceLoad, mDynamic, mLinearInterpolation, mMipmapping,
+                static_cast<size_t>(mMaxTextureSize.x), static_cast<size_t>(mMaxTextureSize.y),
+                mTileWidth, mTileHeight);
             if (tile && (mTileWidth == 0.0f || mTileHeight == 0.0f))
                 setTileAxes();
             resize(true);
@@ -355,34 +358,6 @@ void ImageComponent::setDimming(float dimming)
     mDimming = dimming;
 }
 
-void ImageComponent::setClipRegion(const glm::vec4& clipRegionArg)
-{
-    if (mVertices[0].clipRegion == clipRegionArg)
-        return;
-
-    mClipRegion = clipRegionArg;
-
-    if (mClipRegion == glm::vec4 {0.0f, 0.0f, 0.0f, 0.0f}) {
-        if (mVertices[0].shaderFlags & Renderer::ShaderFlags::CLIPPING) {
-            mVertices[0].shaderFlags ^= Renderer::ShaderFlags::CLIPPING;
-            mVertices[1].shaderFlags ^= Renderer::ShaderFlags::CLIPPING;
-            mVertices[2].shaderFlags ^= Renderer::ShaderFlags::CLIPPING;
-            mVertices[3].shaderFlags ^= Renderer::ShaderFlags::CLIPPING;
-        }
-    }
-    else {
-        mVertices[0].shaderFlags |= Renderer::ShaderFlags::CLIPPING;
-        mVertices[1].shaderFlags |= Renderer::ShaderFlags::CLIPPING;
-        mVertices[2].shaderFlags |= Renderer::ShaderFlags::CLIPPING;
-        mVertices[3].shaderFlags |= Renderer::ShaderFlags::CLIPPING;
-    }
-
-    mVertices[0].clipRegion = mClipRegion;
-    mVertices[1].clipRegion = mClipRegion;
-    mVertices[2].clipRegion = mClipRegion;
-    mVertices[3].clipRegion = mClipRegion;
-}
-
 void ImageComponent::setFlipX(bool state)
 {
     mFlipX = state;
@@ -418,7 +393,7 @@ void ImageComponent::render(const glm::mat4& parentTrans)
     mRenderer->setMatrix(trans);
 
     if (mTexture && mOpacity > 0.0f) {
-        if (Settings::getInstance()->getBool("DebugImage")) {
+        if (Settings::getInstance()->getBool(Settings::BoolID::DEBUG_IMAGE)) {
             if (mTargetIsMax) {
                 const glm::vec2 targetSizePos {(mTargetSize - mSize) * mOrigin * glm::vec2 {-1.0f}};
                 mRenderer->drawRect(targetSizePos.x, targetSizePos.y, mTargetSize.x, mTargetSize.y,
@@ -443,35 +418,36 @@ void ImageComponent::render(const glm::mat4& parentTrans)
             else
                 fadeIn(mTexture->bind(0));
 
-            mVertices->brightness = mBrightness;
-            mVertices->opacity = mThemeOpacity;
-            mVertices->saturation = mSaturation * mThemeSaturation;
-            mVertices->dimming = mDimming;
-            mVertices->reflectionsFalloff = mReflectionsFalloff;
+            Renderer::DrawParams params;
+            params.brightness = mBrightness;
+            params.opacity = mThemeOpacity;
+            params.saturation = mSaturation * mThemeSaturation;
+            params.dimming = mDimming;
+            params.reflectionsFalloff = mReflectionsFalloff;
+
+            if (mClipRegion != glm::vec4 {0.0f, 0.0f, 0.0f, 0.0f}) {
+                params.clipRegion = mClipRegion;
+                params.shaderFlags |= Renderer::ShaderFlags::CLIPPING;
+            }
 
             if (mCornerRadius > 0.0f) {
-                mVertices->cornerRadius = mCornerRadius;
-                if (mCornerAntiAliasing) {
-                    mVertices->shaderFlags =
-                        mVertices->shaderFlags | Renderer::ShaderFlags::ROUNDED_CORNERS;
-                }
-                else {
-                    mVertices->shaderFlags =
-                        mVertices->shaderFlags | Renderer::ShaderFlags::ROUNDED_CORNERS_NO_AA;
-                }
+                params.cornerRadius = mCornerRadius;
+                if (mCornerAntiAliasing)
+                    params.shaderFlags |= Renderer::ShaderFlags::ROUNDED_CORNERS;
+                else
+                    params.shaderFlags |= Renderer::ShaderFlags::ROUNDED_CORNERS_NO_AA;
             }
 
-            mVertices->shaderFlags = mVertices->shaderFlags | Renderer::ShaderFlags::PREMULTIPLIED;
+            params.shaderFlags |= Renderer::ShaderFlags::PREMULTIPLIED;
 
 #if defined(USE_OPENGLES)
             // This is required as not all mobile GPUs support mipmapping when using the BGRA
             // pixel format.
             if (mMipmapping)
-                mVertices->shaderFlags =
-                    mVertices->shaderFlags | Renderer::ShaderFlags::CONVERT_PIXEL_FORMAT;
+                params.shaderFlags |= Renderer::ShaderFlags::CONVERT_PIXEL_FORMAT;
 #endif
 
-            mRenderer->drawTriangleStrips(&mVertices[0], 4);
+            mRenderer->drawTriangleStrips(&mVertices[0], 4, params);
         }
         else {
             if (!mTexture) {
@@ -906,8 +882,6 @@ void ImageComponent::updateVertices()
         for (int i {0}; i < 4; ++i)
             mVertices[i].texcoord[1] = py - mVertices[i].texcoord[1];
     }
-
-    setClipRegion(mClipRegion);
 }
 
 void ImageComponent::updateColors()
@@ -88,7 +88,7 @@ public:
     void setOpacity(float opacity) override;
     void setSaturation(float saturation) override;
     void setDimming(float dimming) override;
-    void setClipRegion(const glm::vec4& clipRegionArg);
+    void setClipRegion(const glm::vec4& clipRegionArg) { mClipRegion = clipRegionArg; }
     void setCornerRadius(float radius) { mCornerRadius = radius; }
     void setCornerAntiAliasing(bool state) { mCornerAntiAliasing = state; }
 
@@ -102,6 +102,9 @@ public:
     void setLinearInterpolation(bool state) { mLinearInterpolation = state; }
     // Whether to use mipmapping and trilinear filtering.
     void setMipmapping(bool state) { mMipmapping = state; }
+    // Raster images larger than this are scaled down when loaded, which saves memory when
+    // images are displayed at a small size. Needs to be set before calling setImage().
+    void setMaxTextureSize(const glm::vec2& size) { mMaxTextureSize = size; }
 
     // Returns the size of the current texture, or (0, 0) if none is loaded.
     // This may be different than the rendered size so use getSize() for that.
@@ -123,6 +126,7 @@ public:
 private:
     Renderer* mRenderer;
     glm::vec2 mTargetSize;
+    glm::vec2 mMaxTextureSize;
 
     bool mFlipX;
     bool mFlipY;
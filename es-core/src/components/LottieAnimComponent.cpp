@@ -109,7 +109,7 @@ void LottieAnimComponent::setAnimation(const std::string& path)
 
     // If in debug mode, then disable the rlottie caching so that animations can be replaced on
     // the fly using Ctrl+r reloads.
-    if (Settings::getInstance()->getBool("Debug")) {
+    if (Settings::getInstance()->getBool(Settings::BoolID::DEBUG)) {
         mAnimation = rlottie::Animation::loadFromData(
             std::string(reinterpret_cast<char*>(animData.ptr.get()), animData.length), cache, "",
             false);
@@ -574,7 +574,7 @@ void LottieAnimComponent::render(const glm::mat4& parentTrans)
 
     mRenderer->setMatrix(trans);
 
-    if (Settings::getInstance()->getBool("DebugImage")) {
+    if (Settings::getInstance()->getBool(Settings::BoolID::DEBUG_IMAGE)) {
 
         if (mTargetIsMax) {
             const glm::vec2 targetSizePos {
@@ -601,19 +601,20 @@ void LottieAnimComponent::render(const glm::mat4& parentTrans)
         for (int i {0}; i < 4; ++i)
             vertices[i].position = glm::round(vertices[i].position);
 
-        vertices->brightness = mBrightness;
-        vertices->saturation = mSaturation * mThemeSaturation;
-        vertices->opacity = mOpacity * mThemeOpacity;
-        vertices->dimming = mDimming;
-        vertices->shaderFlags = Renderer::ShaderFlags::PREMULTIPLIED;
+        Renderer::DrawParams params;
+        params.brightness = mBrightness;
+        params.saturation = mSaturation * mThemeSaturation;
+        params.opacity = mOpacity * mThemeOpacity;
+        params.dimming = mDimming;
+        params.shaderFlags = Renderer::ShaderFlags::PREMULTIPLIED;
 
         if (mCornerRadius > 0.0f) {
-            vertices->cornerRadius = mCornerRadius;
-            vertices->shaderFlags = vertices->shaderFlags | Renderer::ShaderFlags::ROUNDED_CORNERS;
+            params.cornerRadius = mCornerRadius;
+            params.shaderFlags |= Renderer::ShaderFlags::ROUNDED_CORNERS;
         }
 
         // Render it.
-        mRenderer->drawTriangleStrips(&vertices[0], 4);
+        mRenderer->drawTriangleStrips(&vertices[0], 4, params);
     }
 
     mHoldFrame = true;
@@ -33,10 +33,11 @@ void NinePatchComponent::render(const glm::mat4& parentTrans)
 
     if (mTexture && mVertices != nullptr) {
         mRenderer->setMatrix(trans);
-        (*mVertices)[0].opacity = mOpacity;
-        (*mVertices)[0].shaderFlags = Renderer::ShaderFlags::PREMULTIPLIED;
+        Renderer::DrawParams params;
+        params.opacity = mOpacity;
+        params.shaderFlags = Renderer::ShaderFlags::PREMULTIPLIED;
         mTexture->bind(0);
-        mRenderer->drawTriangleStrips(&mVertices->at(0), 6 * 9);
+        mRenderer->drawTriangleStrips(&mVertices->at(0), 6 * 9, params);
     }
 
     renderChildren(trans);
@@ -92,7 +92,7 @@ void SliderComponent::render(const glm::mat4& parentTrans)
     glm::mat4 trans {parentTrans * getTransform()};
     mRenderer->setMatrix(trans);
 
-    if (Settings::getInstance()->getBool("DebugText")) {
+    if (Settings::getInstance()->getBool(Settings::BoolID::DEBUG_TEXT)) {
         mRenderer->drawRect(
             mSize.x - mTextCache->metrics.size.x, (mSize.y - mTextCache->metrics.size.y) / 2.0f,
             mTextCache->metrics.size.x, mTextCache->metrics.size.y, 0x0000FF33, 0x0000FF33);
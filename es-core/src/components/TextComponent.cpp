@@ -283,7 +283,7 @@ void TextComponent::render(const glm::mat4& parentTrans)
 
             // Draw the overall textbox area. If we're inside a vertical scrollable container then
             // this area is rendered inside that component instead of here.
-            if (!secondPass && Settings::getInstance()->getBool("DebugText")) {
+            if (!secondPass && Settings::getInstance()->getBool(Settings::BoolID::DEBUG_TEXT)) {
                 if (!mParent || !mParent->isScrollable())
                     mRenderer->drawRect(0.0f, 0.0f, mSize.x, mSize.y, 0x0000FF33, 0x0000FF33);
             }
@@ -291,7 +291,7 @@ void TextComponent::render(const glm::mat4& parentTrans)
             trans = glm::translate(trans, glm::vec3 {0.0f, std::round(yOff), 0.0f});
             mRenderer->setMatrix(trans);
 
-            if (Settings::getInstance()->getBool("DebugText")) {
+            if (Settings::getInstance()->getBool(Settings::BoolID::DEBUG_TEXT)) {
                 const float relativeScaleOffset {(mSize.x - (mSize.x * mRelativeScale)) / 2.0f};
                 if (mHorizontalScrolling && !secondPass) {
                     if (mScrollOffset1 <= mTextCache->metrics.size.x) {
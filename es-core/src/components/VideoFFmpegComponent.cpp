@@ -9,6 +9,7 @@
 #include "components/VideoFFmpegComponent.h"
 
 #include "AudioManager.h"
+#include "Profiler.h"
 #include "Settings.h"
 #include "Window.h"
 #include "resources/TextureResource.h"
@@ -31,7 +32,9 @@
 
 VideoFFmpegComponent::VideoFFmpegComponent()
     : mBlackFrameOffset {0.0f, 0.0f}
+    , mDecodeSize {0, 0}
     , mFrameProcessingThread {nullptr}
+    , mDecodeWakeup {false}
     , mFormatContext {nullptr}
     , mVideoStream {nullptr}
     , mAudioStream {nullptr}
@@ -41,6 +44,7 @@ VideoFFmpegComponent::VideoFFmpegComponent()
     , mHwContext {nullptr}
     , mVideoCodecContext {nullptr}
     , mAudioCodecContext {nullptr}
+    , mOutputPicture {}
     , mVBufferSrcContext {nullptr}
     , mVBufferSinkContext {nullptr}
     , mVFilterGraph {nullptr}
@@ -55,10 +59,12 @@ VideoFFmpegComponent::VideoFFmpegComponent()
     , mAudioTargetQueueSize {0}
     , mVideoTimeBase {0.0l}
     , mAccumulatedTime {0.0l}
+    , mNextFrameTime {std::numeric_limits<double>::max()}
     , mStartTimeAccumulation {false}
     , mDecodedFrame {false}
     , mReadAllFrames {false}
     , mEndOfVideo {false}
+    , mDecodeYUV {false}
 {
 }
 
@@ -175,8 +181,9 @@ void VideoFFmpegComponent::render(const glm::mat4& parentTrans)
 
     if (mIsPlaying && mFormatContext) {
         Renderer::Vertex vertices[4];
+        Renderer::DrawParams params;
 
-        if (Settings::getInstance()->getBool("DebugImage")) {
+        if (Settings::getInstance()->getBool(Settings::BoolID::DEBUG_IMAGE)) {
             mRenderer->setMatrix(trans);
             const glm::vec2 targetSizePos {(mTargetSize - mSize) * mOrigin * glm::vec2 {-1.0f}};
             mRenderer->drawRect(targetSizePos.x, targetSizePos.y, std::round(mTargetSize.x),
@@ -217,11 +224,11 @@ void VideoFFmpegComponent::render(const glm::mat4& parentTrans)
             vertices[i].position = glm::round(vertices[i].position);
 
         if (mFadeIn < 1.0f || mThemeOpacity < 1.0f)
-            vertices->opacity = mOpacity * mThemeOpacity;
+            params.opacity = mOpacity * mThemeOpacity;
 
-        vertices->brightness = mBrightness;
-        vertices->saturation = mSaturation * mThemeSaturation;
-        vertices->dimming = mDimming;
+        params.brightness = mBrightness;
+        params.saturation = mSaturation * mThemeSaturation;
+        params.dimming = mDimming;
 
         if (mVideoCornerRadius > 0.0f) {
             // Don't round the corners for the video frame if pillarboxes are enabled.
@@ -237,46 +244,45 @@ void VideoFFmpegComponent::render(const glm::mat4& parentTrans)
                     renderVideoCorners = false;
             }
             if (renderVideoCorners) {
-                vertices->cornerRadius = mVideoCornerRadius;
+                params.cornerRadius = mVideoCornerRadius;
                 // We don't want to apply anti-aliasing to rounded corners as the black frame is
                 // rendered behind the video and that would generate ugly edge artifacts for any
                 // videos with lighter content.
-                vertices->shaderFlags =
-                    vertices->shaderFlags | Renderer::ShaderFlags::ROUNDED_CORNERS_NO_AA;
+                params.shaderFlags |= Renderer::ShaderFlags::ROUNDED_CORNERS_NO_AA;
             }
         }
 
         std::unique_lock<std::mutex> pictureLock {mPictureMutex};
 
-        if (!mOutputPicture.hasBeenRendered) {
-            // Move the contents of mOutputPicture to a temporary vector in order to call
-            // initFromPixels() only after the mutex unlock. This significantly reduces the
-            // lock waits in outputFrames().
-            size_t pictureSize {mOutputPicture.pictureRGBA.size()};
-            std::vector<uint8_t> tempPictureRGBA;
-            int pictureWidth {0};
-            int pictureHeight {0};
+        if (!mOutputPicture.hasBeenRendered && mOutputPicture.frame != nullptr) {
+            // Take the frame from mOutputPicture in order to upload it only after the mutex
+            // unlock. This significantly reduces the lock waits in outputFrames().
+            AVFrame* pictureFrame {mOutputPicture.frame};
+            const int pictureWidth {mOutputPicture.width};
+            const int pictureHeight {mOutputPicture.height};
 
-            if (pictureSize > 0) {
-                tempPictureRGBA.insert(tempPictureRGBA.begin(),
-                                       std::make_move_iterator(mOutputPicture.pictureRGBA.begin()),
-                                       std::make_move_iterator(mOutputPicture.pictureRGBA.end()));
-
-                mOutputPicture.pictureRGBA.erase(mOutputPicture.pictureRGBA.begin(),
-                                                 mOutputPicture.pictureRGBA.end());
-
-                pictureWidth = mOutputPicture.width;
-                pictureHeight = mOutputPicture.height;
-
-                mOutputPicture.hasBeenRendered = true;
-            }
+            mOutputPicture.frame = nullptr;
+            mOutputPicture.hasBeenRendered = true;
 
             pictureLock.unlock();
 
-            if (pictureSize > 0) {
-                // Build a texture for the video frame.
-                mTexture->initFromPixels(&tempPictureRGBA.at(0), pictureWidth, pictureHeight);
+            // Upload the video frame directly from the decoded frame buffer.
+            if (mDecodeYUV) {
+                mTexture->updateFromPixels(pictureFrame->data[0], pictureWidth, pictureHeight,
+                                           Renderer::TextureType::RED);
+                for (int i {0}; i < 2; ++i) {
+                    mChromaTextures[i]->updateFromPixels(
+                        pictureFrame->data[i + 1], pictureFrame->linesize[i + 1],
+                        (pictureHeight + 1) / 2, Renderer::TextureType::RED);
+                }
+            }
+            else {
+                mTexture->updateFromPixels(pictureFrame->data[0], pictureWidth, pictureHeight);
             }
+            releaseVideoFrame(pictureFrame);
+
+            // The next frame can now be output.
+            notifyFrameProcessing();
         }
         else {
             pictureLock.unlock();
@@ -285,19 +291,25 @@ void VideoFFmpegComponent::render(const glm::mat4& parentTrans)
         if (mTexture != nullptr)
             mTexture->bind(0);
 
+        if (mDecodeYUV) {
+            mChromaTextures[0]->bind(1);
+            mChromaTextures[1]->bind(2);
+            params.shaderFlags |= Renderer::ShaderFlags::CONVERT_YUV;
+        }
+
         // Render scanlines if this option is enabled. However, if this is the media viewer
         // or the video screensaver, then skip this as the scanline rendering is then handled
         // in those modules as a post-processing step.
         if (!mScreensaverMode && !mMediaViewerMode) {
-            vertices[0].opacity = mFadeIn * mOpacity * mThemeOpacity;
+            params.opacity = mFadeIn * mOpacity * mThemeOpacity;
             if (mRenderScanlines)
-                vertices[0].shaders = Renderer::Shader::SCANLINES;
+                params.shaders = Renderer::Shader::SCANLINES;
         }
         else {
-            vertices[0].opacity = mFadeIn;
+            params.opacity = mFadeIn;
         }
 
-        mRenderer->drawTriangleStrips(&vertices[0], 4, Renderer::BlendFactor::SRC_ALPHA,
+        mRenderer->drawTriangleStrips(&vertices[0], 4, params, Renderer::BlendFactor::SRC_ALPHA,
                                       Renderer::BlendFactor::ONE_MINUS_SRC_ALPHA);
     }
     else {
@@ -328,8 +340,10 @@ void VideoFFmpegComponent::updatePlayer()
         mTimeReference = std::chrono::high_resolution_clock::now();
         while (mAudioFrameQueue.size() > 1 && mVideoFrameQueue.size() > 1 &&
                mAudioFrameQueue.front().pts > mVideoFrameQueue.front().pts) {
+            releaseVideoFrame(mVideoFrameQueue.front().frame);
             mVideoFrameQueue.pop();
         }
+        notifyFrameProcessing();
         return;
     }
 
@@ -348,6 +362,9 @@ void VideoFFmpegComponent::updatePlayer()
 
     audioLock.unlock();
 
+    if (mAccumulatedTime >= mNextFrameTime)
+        notifyFrameProcessing();
+
     if (!mFrameProcessingThread) {
         AudioManager::getInstance().unmuteStream();
         mFrameProcessingThread =
@@ -368,7 +385,14 @@ void VideoFFmpegComponent::frameProcessing()
         audioFilter = setupAudioFilters();
 
     while (mIsPlaying && !mPaused && videoFilter && (!mAudioCodecContext || audioFilter)) {
-        readFrames();
+        {
+            Profiler::ScopedTimer timer {"Video decode"};
+            readFrames();
+        }
+        Profiler::setCounter(Profiler::VIDEO_FRAME_QUEUE,
+                             static_cast<int>(mVideoFrameQueue.size()));
+        Profiler::setCounter(Profiler::AUDIO_FRAME_QUEUE,
+                             static_cast<int>(mAudioFrameQueue.size()));
         if (!mIsPlaying)
             break;
 
@@ -377,9 +401,7 @@ void VideoFFmpegComponent::frameProcessing()
             break;
 
         outputFrames();
-
-        // This 1 ms wait makes sure that the thread does not consume all available CPU cycles.
-        SDL_Delay(1);
+        waitForNextFrame();
     }
 
     if (videoFilter) {
@@ -493,12 +515,38 @@ bool VideoFFmpegComponent::setupVideoFilters()
     mVFilterOutputs->pad_idx = 0;
     mVFilterOutputs->next = nullptr;
 
+    // Scale the frames in the filter graph if they will be displayed at a smaller size than the
+    // video resolution. The texture width is derived from the line size of the frames so the
+    // width is also aligned, for planar YUV this alignment needs to apply to the U and V planes
+    // as well. These are always converted to BT.601 limited range as expected by the shader.
+    const int widthAlignment {mDecodeYUV ? 128 : 16};
+    int outputWidth {mDecodeSize.x > 0 ? mDecodeSize.x : width};
+    int outputHeight {mDecodeSize.y > 0 ? mDecodeSize.y : height};
+
+    if (outputWidth % widthAlignment > 0)
+        outputWidth += widthAlignment - outputWidth % widthAlignment;
+    if (mDecodeYUV && outputHeight % 2 > 0)
+        ++outputHeight;
+
+    const bool scaleFrames {mDecodeYUV || outputWidth != width || outputHeight != height};
+
     std::string filterDescription;
 
+    if (scaleFrames) {
+        filterDescription.append("scale=width=")
+            .append(std::to_string(outputWidth))
+            .append(":height=")
+            .append(std::to_string(outputHeight))
+            .append(":flags=bilinear");
+        if (mDecodeYUV)
+            filterDescription.append(":out_color_matrix=bt601:out_range=tv");
+        filterDescription.append(",");
+    }
+
     // Whether to upscale the frame rate to 60 FPS.
     if (Settings::getInstance()->getBool("VideoUpscaleFrameRate")) {
 
-        if (modulo > 0) {
+        if (modulo > 0 && !scaleFrames) {
             filterDescription.append("scale=width=")
                 .append(std::to_string(width))
                 .append(":height=")
@@ -525,7 +573,8 @@ bool VideoFFmpegComponent::setupVideoFilters()
     }
 
     filterDescription.append("format=pix_fmts=")
-        .append(std::string(av_get_pix_fmt_name(AV_PIX_FMT_BGRA)));
+        .append(std::string(
+            av_get_pix_fmt_name(mDecodeYUV ? AV_PIX_FMT_YUV420P : AV_PIX_FMT_BGRA)));
 
     returnValue = avfilter_graph_parse_ptr(mVFilterGraph, filterDescription.c_str(),
                                            &mVFilterInputs, &mVFilterOutputs, nullptr);
@@ -832,7 +881,7 @@ void VideoFFmpegComponent::getProcessedFrames()
         // This is likely unnecessary as AV_PIX_FMT_RGBA always uses 4 bytes per pixel.
         // const int bytesPerPixel {
         //    av_get_padded_bits_per_pixel(av_pix_fmt_desc_get(AV_PIX_FMT_RGBA)) / 8};
-        const int bytesPerPixel {4};
+        const int bytesPerPixel {mDecodeYUV ? 1 : 4};
         const int width {mVideoFrameResampled->linesize[0] / bytesPerPixel};
 
         currFrame.width = width;
@@ -859,14 +908,11 @@ void VideoFFmpegComponent::getProcessedFrames()
         currFrame.pts = pts;
         currFrame.frameDuration = frameDuration;
 
-        const int bufferSize {width * mVideoFrameResampled->height * 4};
-
-        currFrame.frameRGBA.insert(
-            currFrame.frameRGBA.begin(), std::make_move_iterator(&mVideoFrameResampled->data[0][0]),
-            std::make_move_iterator(&mVideoFrameResampled->data[0][bufferSize]));
+        // Keep a reference to the frame buffer instead of copying the picture.
+        currFrame.frame = acquireVideoFrame();
+        av_frame_move_ref(currFrame.frame, mVideoFrameResampled);
 
         mVideoFrameQueue.emplace(std::move(currFrame));
-        av_frame_unref(mVideoFrameResampled);
     }
 
     // Audio frames.
@@ -1010,12 +1056,11 @@ void VideoFFmpegComponent::outputFrames()
                 }
             }
 
-            mOutputPicture.pictureRGBA.clear();
-            mOutputPicture.pictureRGBA.insert(
-                mOutputPicture.pictureRGBA.begin(),
-                std::make_move_iterator(mVideoFrameQueue.front().frameRGBA.begin()),
-                std::make_move_iterator(mVideoFrameQueue.front().frameRGBA.end()));
+            // Release any frame that was skipped without being rendered.
+            if (mOutputPicture.frame != nullptr)
+                releaseVideoFrame(mOutputPicture.frame);
 
+            mOutputPicture.frame = mVideoFrameQueue.front().frame;
             mOutputPicture.width = mVideoFrameQueue.front().width;
             mOutputPicture.height = mVideoFrameQueue.front().height;
             mOutputPicture.hasBeenRendered = false;
@@ -1036,6 +1081,84 @@ void VideoFFmpegComponent::outputFrames()
         mEndOfVideo = true;
 }
 
+AVFrame* VideoFFmpegComponent::acquireVideoFrame()
+{
+    std::unique_lock<std::mutex> poolLock {mVideoFramePoolMutex};
+
+    if (mVideoFramePool.empty())
+        return av_frame_alloc();
+
+    AVFrame* frame {mVideoFramePool.back()};
+    mVideoFramePool.pop_back();
+    return frame;
+}
+
+void VideoFFmpegComponent::releaseVideoFrame(AVFrame*& frame)
+{
+    // This returns the frame buffer to the buffer pool of the filter graph.
+    av_frame_unref(frame);
+
+    std::unique_lock<std::mutex> poolLock {mVideoFramePoolMutex};
+    mVideoFramePool.emplace_back(frame);
+    frame = nullptr;
+}
+
+void VideoFFmpegComponent::clearVideoFrameQueue()
+{
+    while (!mVideoFrameQueue.empty()) {
+        releaseVideoFrame(mVideoFrameQueue.front().frame);
+        mVideoFrameQueue.pop();
+    }
+}
+
+void VideoFFmpegComponent::waitForNextFrame()
+{
+    // Keep reading frames without waiting for as long as the queues are not filled.
+    if (!mReadAllFrames && (static_cast<int>(mVideoFrameQueue.size()) < mVideoTargetQueueSize ||
+                            (mAudioStreamIndex >= 0 && static_cast<int>(mAudioFrameQueue.size()) <
+                                                           mAudioTargetQueueSize))) {
+        return;
+    }
+
+    double nextFrameTime {std::numeric_limits<double>::max()};
+
+    if (!mAudioFrameQueue.empty())
+        nextFrameTime = mAudioFrameQueue.front().pts - AUDIO_BUFFER;
+    if (!mVideoFrameQueue.empty())
+        nextFrameTime = std::min(nextFrameTime, mVideoFrameQueue.front().pts);
+
+    bool pictureWaiting {false};
+    {
+        std::unique_lock<std::mutex> pictureLock {mPictureMutex};
+        pictureWaiting = mDecodedFrame && !mOutputPicture.hasBeenRendered;
+    }
+
+    std::unique_lock<std::mutex> decodeLock {mDecodeMutex};
+
+    // If the next frame is already due and it's not held back waiting for the previous frame to
+    // be rendered, then process it straight away.
+    if (mStartTimeAccumulation && !pictureWaiting && mAccumulatedTime >= nextFrameTime)
+        return;
+
+    // The main thread notifies when the presentation clock reaches this time.
+    mNextFrameTime = nextFrameTime;
+
+    mDecodeCondition.wait_for(decodeLock, std::chrono::milliseconds(DECODE_WAIT_TIMEOUT),
+                              [this] { return mDecodeWakeup || !mIsPlaying || mPaused; });
+
+    mDecodeWakeup = false;
+    mNextFrameTime = std::numeric_limits<double>::max();
+}
+
+void VideoFFmpegComponent::notifyFrameProcessing()
+{
+    {
+        std::unique_lock<std::mutex> decodeLock {mDecodeMutex};
+        mDecodeWakeup = true;
+    }
+    mDecodeCondition.notify_one();
+}
+
 void VideoFFmpegComponent::calculateBlackFrame()
 {
     // Calculate the position and size for the black frame image that will be rendered behind
@@ -1397,6 +1520,8 @@ void VideoFFmpegComponent::startVideoStream()
         mVideoWidth = 0;
         mVideoHeight = 0;
         mAccumulatedTime = 0;
+        mNextFrameTime = std::numeric_limits<double>::max();
+        mDecodeWakeup = false;
         mStartTimeAccumulation = false;
         mSWDecoder = true;
         mDecodedFrame = false;
@@ -1406,17 +1531,31 @@ void VideoFFmpegComponent::startVideoStream()
         mAudioFrameCount = 0;
         mVideoFrameReadCount = 0;
         mVideoFrameDroppedCount = 0;
+        if (mOutputPicture.frame != nullptr)
+            releaseVideoFrame(mOutputPicture.frame);
         mOutputPicture = {};
 
         // Get an empty texture for rendering the video.
         mTexture = TextureResource::get("");
         mTexture->setLinearMagnify(mLinearInterpolation);
 
+        // The scanline shader doesn't support planar YUV, but the media viewer and the video
+        // screensaver apply the scanlines as a post-processing step.
+        mDecodeYUV = Settings::getInstance()->getBool("VideoShaderColorConversion") &&
+                     (!mRenderScanlines || mScreensaverMode || mMediaViewerMode);
+
+        if (mDecodeYUV) {
+            for (auto& texture : mChromaTextures) {
+                texture = TextureResource::get("");
+                texture->setLinearMagnify(true);
+            }
+        }
+
         // This is used for the audio and video synchronization.
         mTimeReference = std::chrono::high_resolution_clock::now();
 
         // Clear the video and audio frame queues.
-        std::queue<VideoFrame>().swap(mVideoFrameQueue);
+        clearVideoFrameQueue();
         std::queue<AudioFrame>().swap(mAudioFrameQueue);
 
         std::string filePath {"file:" + mVideoPath};
@@ -1604,6 +1743,22 @@ void VideoFFmpegComponent::startVideoStream()
         // the video screeensaver.
         resize();
 
+        // Decode at the displayed size if it's smaller than the video resolution. Cropped
+        // videos are displayed larger than the component size.
+        mDecodeSize = {0, 0};
+        if (Settings::getInstance()->getBool("VideoDecodeAtDisplaySize")) {
+            const glm::vec2 cropRange {mBottomRightCrop - mTopLeftCrop};
+            const glm::ivec2 displaySize {
+                static_cast<int>(std::round(mSize.x / std::max(cropRange.x, 0.01f))),
+                static_cast<int>(std::round(mSize.y / std::max(cropRange.y, 0.01f)))};
+            const glm::ivec2 videoSize {static_cast<int>(mVideoWidth),
+                                        static_cast<int>(mVideoHeight)};
+
+            if (displaySize.x > 0 && displaySize.y > 0 &&
+                (displaySize.x < videoSize.x || displaySize.y < videoSize.y))
+                mDecodeSize = glm::min(displaySize, videoSize);
+        }
+
         calculateBlackFrame();
 
         mFadeIn = 0.0f;
@@ -1621,6 +1776,8 @@ void VideoFFmpegComponent::stopVideoPlayer(bool muteAudio)
     mReadAllFrames = false;
     mEndOfVideo = false;
     mTexture.reset();
+    mChromaTextures = {};
+    notifyFrameProcessing();
 
     if (mFrameProcessingThread) {
         if (mWindow->getVideoPlayerCount() == 0)
@@ -1632,9 +1789,19 @@ void VideoFFmpegComponent::stopVideoPlayer(bool muteAudio)
     }
 
     // Clear the video and audio frame queues.
-    std::queue<VideoFrame>().swap(mVideoFrameQueue);
+    clearVideoFrameQueue();
     std::queue<AudioFrame>().swap(mAudioFrameQueue);
 
+    if (mOutputPicture.frame != nullptr)
+        releaseVideoFrame(mOutputPicture.frame);
+
+    {
+        std::unique_lock<std::mutex> poolLock {mVideoFramePoolMutex};
+        for (AVFrame*& frame : mVideoFramePool)
+            av_frame_free(&frame);
+        mVideoFramePool.clear();
+    }
+
     // Clear the audio buffer.
     if (AudioManager::sAudioDevice != 0)
         AudioManager::getInstance().clearStream();
@@ -1661,6 +1828,7 @@ void VideoFFmpegComponent::pauseVideoPlayer()
 {
     muteVideoPlayer();
     mPaused = true;
+    notifyFrameProcessing();
 }
 
 void VideoFFmpegComponent::handleLooping()
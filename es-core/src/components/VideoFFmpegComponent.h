@@ -11,6 +11,8 @@
 
 // Audio buffer in seconds.
 #define AUDIO_BUFFER 0.1
+// Maximum time in milliseconds that the frame processing thread waits without being notified.
+#define DECODE_WAIT_TIMEOUT 100
 
 #include "VideoComponent.h"
 
@@ -24,8 +26,11 @@ extern "C" {
 #include <libavutil/imgutils.h>
 }
 
+#include <array>
 #include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <limits>
 #include <mutex>
 #include <queue>
 #include <thread>
@@ -81,6 +86,17 @@ private:
     void getProcessedFrames();
     // Output frames to AudioManager and to the video surface (via the main thread).
     void outputFrames();
+    // Block the frame processing thread while the queues are filled until the next audio or
+    // video frame is due according to the presentation clock, or until the player state changes.
+    void waitForNextFrame();
+    void notifyFrameProcessing();
+
+    // The decoded video frames reference the buffers of the filter graph rather than copying
+    // them, the AVFrame structs are recycled and the buffers are returned to FFmpeg's buffer
+    // pool when the frames are released.
+    AVFrame* acquireVideoFrame();
+    void releaseVideoFrame(AVFrame*& frame);
+    void clearVideoFrameQueue();
 
     // Calculate the black frame that is rendered behind all videos and which may also be
     // adding pillarboxes/letterboxes.
@@ -98,11 +114,20 @@ private:
     static inline std::vector<std::string> sHWDecodedVideos;
 
     std::shared_ptr<TextureResource> mTexture;
+    // The U and V planes when the YUV to RGB conversion is done by the shader, in which case
+    // mTexture contains the Y plane.
+    std::array<std::shared_ptr<TextureResource>, 2> mChromaTextures;
     glm::vec2 mBlackFrameOffset;
+    // Size that the frames are scaled to by the filter graph, or zero to keep the video size.
+    glm::ivec2 mDecodeSize;
 
     std::unique_ptr<std::thread> mFrameProcessingThread;
     std::mutex mPictureMutex;
     std::mutex mAudioMutex;
+    std::mutex mVideoFramePoolMutex;
+    std::mutex mDecodeMutex;
+    std::condition_variable mDecodeCondition;
+    bool mDecodeWakeup;
 
     AVFormatContext* mFormatContext;
     AVStream* mVideoStream;
@@ -123,7 +148,7 @@ private:
     AVFrame* mAudioFrameResampled;
 
     struct VideoFrame {
-        std::vector<uint8_t> frameRGBA;
+        AVFrame* frame;
         int width;
         int height;
         double pts;
@@ -136,7 +161,7 @@ private:
     };
 
     struct OutputPicture {
-        std::vector<uint8_t> pictureRGBA;
+        AVFrame* frame;
         bool hasBeenRendered;
         int width;
         int height;
@@ -144,6 +169,7 @@ private:
 
     std::queue<VideoFrame> mVideoFrameQueue;
     std::queue<AudioFrame> mAudioFrameQueue;
+    std::vector<AVFrame*> mVideoFramePool;
     OutputPicture mOutputPicture;
     std::vector<uint8_t> mOutputAudio;
 
@@ -172,11 +198,14 @@ private:
     int mVideoFrameDroppedCount;
 
     std::atomic<double> mAccumulatedTime;
+    // Presentation time when the frame processing thread should be woken up.
+    std::atomic<double> mNextFrameTime;
     std::atomic<bool> mStartTimeAccumulation;
     std::atomic<bool> mDecodedFrame;
     std::atomic<bool> mReadAllFrames;
     std::atomic<bool> mEndOfVideo;
     bool mSWDecoder;
+    bool mDecodeYUV;
 };
 
 #endif // ES_CORE_COMPONENTS_VIDEO_FFMPEG_COMPONENT_H
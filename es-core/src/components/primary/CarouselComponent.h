@@ -312,6 +312,7 @@ void CarouselComponent<T>::addEntry(Entry& entry, const std::shared_ptr<ThemeDat
         else if (mImagefit == ImageFit::COVER)
             item->setCroppedSize(glm::round(mItemSize * (mItemScale >= 1.0f ? mItemScale : 1.0f)));
         item->setCornerRadius(mImageCornerRadius);
+        item->setMaxTextureSize(glm::round(mItemSize * (mItemScale >= 1.0f ? mItemScale : 1.0f)));
         item->setImage(entry.data.imagePath);
         if (mImageBrightness != 0.0)
             item->setBrightness(mImageBrightness);
@@ -342,6 +343,8 @@ void CarouselComponent<T>::addEntry(Entry& entry, const std::shared_ptr<ThemeDat
                 mDefaultImage->setCroppedSize(
                     glm::round(mItemSize * (mItemScale >= 1.0f ? mItemScale : 1.0f)));
             mDefaultImage->setCornerRadius(mImageCornerRadius);
+            mDefaultImage->setMaxTextureSize(
+                glm::round(mItemSize * (mItemScale >= 1.0f ? mItemScale : 1.0f)));
             mDefaultImage->setImage(entry.data.defaultImagePath);
             if (mImageBrightness != 0.0)
                 mDefaultImage->setBrightness(mImageBrightness);
@@ -416,6 +419,7 @@ void CarouselComponent<T>::updateEntry(Entry& entry, const std::shared_ptr<Theme
         else if (mImagefit == ImageFit::COVER)
             item->setCroppedSize(glm::round(mItemSize * (mItemScale >= 1.0f ? mItemScale : 1.0f)));
         item->setCornerRadius(mImageCornerRadius);
+        item->setMaxTextureSize(glm::round(mItemSize * (mItemScale >= 1.0f ? mItemScale : 1.0f)));
         item->setImage(entry.data.imagePath);
         if (mImageBrightness != 0.0)
             item->setBrightness(mImageBrightness);
@@ -708,7 +712,7 @@ template <typename T> void CarouselComponent<T>::render(const glm::mat4& parentT
     mRenderer->setMatrix(carouselTrans);
 
     // In image debug mode, draw a green rectangle covering the entire carousel area.
-    if (Settings::getInstance()->getBool("DebugImage"))
+    if (Settings::getInstance()->getBool(Settings::BoolID::DEBUG_IMAGE))
         mRenderer->drawRect(0.0f, 0.0f, mSize.x, mSize.y, 0x00FF0033, 0x00FF0033);
 
     // Background box behind the items.
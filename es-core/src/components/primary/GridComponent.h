@@ -288,7 +288,7 @@ template <typename T> GridComponent<T>::~GridComponent()
     // when running in debug mode, otherwise a complete system view reload would be needed to
     // get these images updated. This is useful during theme development when using the Ctrl-r
     // keyboard combination to reload the theme configuration.
-    if (Settings::getInstance()->getBool("Debug")) {
+    if (Settings::getInstance()->getBool(Settings::BoolID::DEBUG)) {
         TextureResource::manualUnload(mBackgroundImagePath, false);
         TextureResource::manualUnload(mSelectorImagePath, false);
     }
@@ -311,6 +311,8 @@ void GridComponent<T>::addEntry(Entry& entry, const std::shared_ptr<ThemeData>&
         else if (mImagefit == ImageFit::COVER)
             item->setCroppedSize(glm::round(mItemSize * mImageRelativeScale));
         item->setCornerRadius(mImageCornerRadius);
+        item->setMaxTextureSize(
+            glm::round(mItemSize * mImageRelativeScale * std::max(mItemScale, 1.0f)));
         item->setImage(entry.data.imagePath);
         if (mImageBrightness != 0.0)
             item->setBrightness(mImageBrightness);
@@ -343,6 +345,8 @@ void GridComponent<T>::addEntry(Entry& entry, const std::shared_ptr<ThemeData>&
             else if (mImagefit == ImageFit::COVER)
                 mDefaultImage->setCroppedSize(glm::round(mItemSize * mImageRelativeScale));
             mDefaultImage->setCornerRadius(mImageCornerRadius);
+            mDefaultImage->setMaxTextureSize(
+                glm::round(mItemSize * mImageRelativeScale * std::max(mItemScale, 1.0f)));
             mDefaultImage->setImage(entry.data.defaultImagePath);
             if (mImageBrightness != 0.0)
                 mDefaultImage->setBrightness(mImageBrightness);
@@ -400,6 +404,8 @@ void GridComponent<T>::updateEntry(Entry& entry, const std::shared_ptr<ThemeData
         else if (mImagefit == ImageFit::COVER)
             item->setCroppedSize(glm::round(mItemSize * mImageRelativeScale));
         item->setCornerRadius(mImageCornerRadius);
+        item->setMaxTextureSize(
+            glm::round(mItemSize * mImageRelativeScale * std::max(mItemScale, 1.0f)));
         item->setImage(entry.data.imagePath);
         if (mImageBrightness != 0.0)
             item->setBrightness(mImageBrightness);
@@ -647,7 +653,7 @@ template <typename T> void GridComponent<T>::render(const glm::mat4& parentTrans
     mRenderer->setMatrix(trans);
 
     // In image debug mode, draw a green rectangle covering the entire grid area.
-    if (Settings::getInstance()->getBool("DebugImage"))
+    if (Settings::getInstance()->getBool(Settings::BoolID::DEBUG_IMAGE))
         mRenderer->drawRect(0.0f, 0.0f, mSize.x, mSize.y, 0x00FF0033, 0x00FF0033);
 
     // Clip to element boundaries.
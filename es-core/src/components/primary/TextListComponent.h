@@ -337,7 +337,7 @@ template <typename T> void TextListComponent<T>::render(const glm::mat4& parentT
         }
     }
 
-    if (Settings::getInstance()->getBool("DebugText")) {
+    if (Settings::getInstance()->getBool(Settings::BoolID::DEBUG_TEXT)) {
         mRenderer->setMatrix(trans);
         mRenderer->drawRect(mHorizontalMargin, 0.0f, mSize.x - mHorizontalMargin * 2.0f, mSize.y,
                             0x00000033, 0x00000033);
@@ -11,6 +11,7 @@
 #include "ImageIO.h"
 #include "Log.h"
 #include "Settings.h"
+#include "renderers/RendererNull.h"
 #include "renderers/RendererOpenGL.h"
 #include "renderers/ShaderOpenGL.h"
 #include "resources/ResourceManager.h"
@@ -21,6 +22,9 @@
 
 Renderer* Renderer::getInstance()
 {
+    if (sHeadless)
+        return RendererNull::getInstance();
+
     static RendererOpenGL instance;
     return &instance;
 }
@@ -58,6 +62,10 @@ bool Renderer::createWindow()
 {
     LOG(LogInfo) << "Creating window...";
 
+    // Use the SDL dummy video driver when running headless so no display or GPU is required.
+    if (sHeadless)
+        SDL_SetHint(SDL_HINT_VIDEODRIVER, "dummy");
+
     if (SDL_InitSubSystem(SDL_INIT_VIDEO) != 0) {
         LOG(LogError) << "Couldn't initialize SDL: " << SDL_GetError();
         return false;
@@ -221,6 +229,9 @@ bool Renderer::createWindow()
         windowFlags = SDL_WINDOW_OPENGL;
 #endif
 
+    if (sHeadless)
+        windowFlags &= ~static_cast<unsigned int>(SDL_WINDOW_OPENGL);
+
     if ((mSDLWindow = SDL_CreateWindow("ES-DE", SDL_WINDOWPOS_UNDEFINED_DISPLAY(displayIndex),
                                        SDL_WINDOWPOS_UNDEFINED_DISPLAY(displayIndex), mWindowWidth,
                                        mWindowHeight, windowFlags)) == nullptr) {
@@ -491,9 +502,10 @@ void Renderer::drawRect(const float x,
     for (int i {0}; i < 4; ++i)
         vertices[i].position = glm::round(vertices[i].position);
 
-    vertices->opacity = opacity;
-    vertices->dimming = dimming;
+    DrawParams params;
+    params.opacity = opacity;
+    params.dimming = dimming;
 
     bindTexture(0, 0);
-    drawTriangleStrips(vertices, 4, srcBlendFactor, dstBlendFactor);
+    drawTriangleStrips(vertices, 4, params, srcBlendFactor, dstBlendFactor);
 }
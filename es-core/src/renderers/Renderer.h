@@ -56,39 +56,22 @@ public:
         ROTATED               = 0x00000010, // Screen rotated 90 or 270 degrees.
         ROUNDED_CORNERS       = 0x00000020,
         ROUNDED_CORNERS_NO_AA = 0x00000040,
-        CONVERT_PIXEL_FORMAT  = 0x00000080
+        CONVERT_PIXEL_FORMAT  = 0x00000080,
+        CONVERT_YUV           = 0x00000100  // Planar YUV in texture units 0, 1 and 2.
     };
     // clang-format on
 
+    // Only the attributes that actually differ between vertices are stored here, this keeps
+    // the vertex at 20 bytes which matters for large text caches.
     struct Vertex {
         glm::vec2 position;
         glm::vec2 texcoord;
         unsigned int color;
-        glm::vec4 clipRegion;
-        float brightness;
-        float opacity;
-        float saturation;
-        float dimming;
-        float cornerRadius;
-        float reflectionsFalloff;
-        float blurStrength;
-        unsigned int shaders;
-        unsigned int shaderFlags;
 
         Vertex()
             : position {0.0f, 0.0f}
             , texcoord {0.0f, 0.0f}
             , color {0x00000000}
-            , clipRegion {0.0f, 0.0f, 0.0f, 0.0f}
-            , brightness {0.0f}
-            , opacity {1.0f}
-            , saturation {1.0f}
-            , dimming {1.0f}
-            , cornerRadius {0.0f}
-            , reflectionsFalloff {0.0f}
-            , blurStrength {0.0f}
-            , shaders {0}
-            , shaderFlags {0}
         {
         }
 
@@ -98,7 +81,25 @@ public:
             : position {positionArg}
             , texcoord {texcoordArg}
             , color {colorArg}
-            , clipRegion {0.0f, 0.0f, 0.0f, 0.0f}
+        {
+        }
+    };
+
+    // Shader parameters that apply to all vertices of a draw call.
+    struct DrawParams {
+        glm::vec4 clipRegion;
+        float brightness;
+        float opacity;
+        float saturation;
+        float dimming;
+        float cornerRadius;
+        float reflectionsFalloff;
+        float blurStrength;
+        unsigned int shaders;
+        unsigned int shaderFlags;
+
+        DrawParams()
+            : clipRegion {0.0f, 0.0f, 0.0f, 0.0f}
             , brightness {0.0f}
             , opacity {1.0f}
             , saturation {1.0f}
@@ -155,6 +156,9 @@ public:
     };
 
     static Renderer* getInstance();
+    // Select the null renderer instead of OpenGL, has to be set before getInstance() is called.
+    static void setHeadless(const bool state) { sHeadless = state; }
+    static const bool getHeadless() { return sHeadless; }
 
     void setIcon();
     bool createWindow();
@@ -219,6 +223,7 @@ public:
     virtual void drawTriangleStrips(
         const Vertex* vertices,
         const unsigned int numVertices,
+        const DrawParams& params,
         const BlendFactor srcBlendFactor = BlendFactor::ONE,
         const BlendFactor dstBlendFactor = BlendFactor::ONE_MINUS_SRC_ALPHA) = 0;
     virtual void shaderPostprocessing(
@@ -230,8 +235,14 @@ public:
     virtual void setScissor(const Rect& scissor) = 0;
     virtual void setSwapInterval() = 0;
     virtual void swapBuffers() = 0;
+    // Clears the color and depth buffers, any batched draws are flushed first.
+    virtual void clearScreen() = 0;
 
 protected:
+    // Maximum number of draws combined into a single batch, limited by the smallest uniform
+    // block size that OpenGL and OpenGL ES implementations are required to support.
+    static inline const unsigned int BATCH_MAX_DRAWS {256};
+
     Rect mViewport;
     int mWindowWidth {0};
     int mWindowHeight {0};
@@ -246,6 +257,7 @@ private:
     glm::mat4 mProjectionMatrix {};
     glm::mat4 mProjectionMatrixNormal {};
 
+    static inline bool sHeadless {false};
     static inline int sScreenWidth {0};
     static inline int sScreenHeight {0};
     int mScreenRotation {0};
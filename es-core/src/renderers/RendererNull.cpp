@@ -0,0 +1,166 @@
+//  SPDX-License-Identifier: MIT
+//
+//  ES-DE
+//  RendererNull.cpp
+//
+//  Headless renderer that records draw calls, texture uploads and state changes
+//  without rendering anything. Used for benchmarking on machines without a GPU.
+//
+
+#include "renderers/RendererNull.h"
+
+#include <cstring>
+
+RendererNull::RendererNull() noexcept
+    : mLastTexture {0}
+    , mBoundTexture {0}
+    , mBatchSrcBlendFactor {BlendFactor::ONE}
+    , mBatchDstBlendFactor {BlendFactor::ONE_MINUS_SRC_ALPHA}
+    , mBatchDraws {0}
+    , mBatchOpen {false}
+{
+}
+
+RendererNull* RendererNull::getInstance()
+{
+    static RendererNull instance;
+    return &instance;
+}
+
+bool RendererNull::createContext()
+{
+    LOG(LogInfo) << "Application renderer: null (headless)";
+    return true;
+}
+
+void RendererNull::setMatrix(const glm::mat4& matrix)
+{
+    // The matrix is unused but the calculation is kept so the CPU cost is comparable.
+    mTrans = getProjectionMatrix() * matrix;
+}
+
+void RendererNull::setViewport(const Rect& viewport)
+{
+    ++mStatistics.stateChanges;
+    mBatchOpen = false;
+}
+
+void RendererNull::setScissor(const Rect& scissor)
+{
+    ++mStatistics.stateChanges;
+    mBatchOpen = false;
+}
+
+void RendererNull::swapBuffers() { mBatchOpen = false; }
+
+void RendererNull::clearScreen() { mBatchOpen = false; }
+
+unsigned int RendererNull::createTexture(const unsigned int texUnit,
+                                         const TextureType type,
+                                         const bool linearMinify,
+                                         const bool linearMagnify,
+                                         const bool mipmapping,
+                                         const bool repeat,
+                                         const unsigned int width,
+                                         const unsigned int height,
+                                         void* data)
+{
+    if (data != nullptr)
+        addTextureUpload(type, width, height);
+
+    // Creating a texture also binds it.
+    if (texUnit == 0)
+        mBoundTexture = mLastTexture + 1;
+
+    mBatchOpen = false;
+    return ++mLastTexture;
+}
+
+void RendererNull::destroyTexture(const unsigned int texture)
+{
+    if (texture == mBoundTexture)
+        mBoundTexture = 0;
+
+    mBatchOpen = false;
+}
+
+void RendererNull::updateTexture(const unsigned int texture,
+                                 const unsigned int texUnit,
+                                 const TextureType type,
+                                 const unsigned int x,
+                                 const unsigned int y,
+                                 const unsigned int width,
+                                 const unsigned int height,
+                                 void* data)
+{
+    addTextureUpload(type, width, height);
+
+    if (texUnit == 0)
+        mBoundTexture = 0;
+
+    mBatchOpen = false;
+}
+
+void RendererNull::bindTexture(const unsigned int texture, const unsigned int texUnit)
+{
+    if (texUnit == 0 && texture == mBoundTexture)
+        return;
+
+    ++mStatistics.textureBinds;
+
+    if (texUnit == 0)
+        mBoundTexture = texture;
+
+    mBatchOpen = false;
+}
+
+void RendererNull::drawTriangleStrips(const Vertex* vertices,
+                                      const unsigned int numVertices,
+                                      const DrawParams& params,
+                                      const BlendFactor srcBlendFactor,
+                                      const BlendFactor dstBlendFactor)
+{
+    ++mStatistics.drawCalls;
+    mStatistics.vertices += numVertices;
+
+    // Mirror the batching done by the OpenGL renderer where only core shader draws with the
+    // same texture and blend factors are combined, up to BATCH_MAX_DRAWS draws per batch.
+    if (params.shaders == 0 || params.shaders & Shader::CORE) {
+        if (!mBatchOpen || srcBlendFactor != mBatchSrcBlendFactor ||
+            dstBlendFactor != mBatchDstBlendFactor || mBatchDraws == BATCH_MAX_DRAWS) {
+            ++mStatistics.batches;
+            mBatchSrcBlendFactor = srcBlendFactor;
+            mBatchDstBlendFactor = dstBlendFactor;
+            mBatchOpen = true;
+            mBatchDraws = 0;
+        }
+        ++mBatchDraws;
+    }
+    else {
+        ++mStatistics.batches;
+        mBatchOpen = false;
+    }
+}
+
+void RendererNull::shaderPostprocessing(const unsigned int shaders,
+                                        const Renderer::postProcessingParams& parameters,
+                                        unsigned char* textureRGBA)
+{
+    ++mStatistics.postProcessingPasses;
+    mBatchOpen = false;
+
+    // There are no screen contents to read back so return a black texture.
+    if (textureRGBA != nullptr)
+        std::memset(textureRGBA, 0,
+                    static_cast<size_t>(getScreenWidth()) *
+                        static_cast<size_t>(getScreenHeight()) * 4);
+}
+
+void RendererNull::addTextureUpload(const TextureType type,
+                                    const unsigned int width,
+                                    const unsigned int height)
+{
+    ++mStatistics.textureUploads;
+    mStatistics.textureUploadBytes += static_cast<size_t>(width) * static_cast<size_t>(height) *
+                                      (type == TextureType::RED ? 1 : 4);
+}
@@ -0,0 +1,110 @@
+//  SPDX-License-Identifier: MIT
+//
+//  ES-DE
+//  RendererNull.h
+//
+//  Headless renderer that records draw calls, texture uploads and state changes
+//  without rendering anything. Used for benchmarking on machines without a GPU.
+//
+
+#ifndef ES_CORE_RENDERER_RENDERER_NULL_H
+#define ES_CORE_RENDERER_RENDERER_NULL_H
+
+#include "renderers/Renderer.h"
+
+class RendererNull : public Renderer
+{
+public:
+    struct Statistics {
+        // Calls to drawTriangleStrips().
+        unsigned int drawCalls;
+        // The number of draw calls the OpenGL renderer would issue after batching.
+        unsigned int batches;
+        unsigned int vertices;
+        unsigned int textureBinds;
+        unsigned int textureUploads;
+        size_t textureUploadBytes;
+        // Viewport and scissor changes.
+        unsigned int stateChanges;
+        unsigned int postProcessingPasses;
+
+        Statistics()
+            : drawCalls {0}
+            , batches {0}
+            , vertices {0}
+            , textureBinds {0}
+            , textureUploads {0}
+            , textureUploadBytes {0}
+            , stateChanges {0}
+            , postProcessingPasses {0}
+        {
+        }
+    };
+
+    static RendererNull* getInstance();
+
+    const Statistics& getStatistics() { return mStatistics; }
+    void resetStatistics() { mStatistics = Statistics(); }
+
+    bool loadShaders() override { return true; }
+
+    void setup() override {}
+    bool createContext() override;
+    void destroyContext() override {}
+
+    void setMatrix(const glm::mat4& matrix) override;
+    void setViewport(const Rect& viewport) override;
+    void setScissor(const Rect& scissor) override;
+    void setSwapInterval() override {}
+    void swapBuffers() override;
+    void clearScreen() override;
+
+    unsigned int createTexture(const unsigned int texUnit,
+                               const TextureType type,
+                               const bool linearMinify,
+                               const bool linearMagnify,
+                               const bool mipmapping,
+                               const bool repeat,
+                               const unsigned int width,
+                               const unsigned int height,
+                               void* data) override;
+    void destroyTexture(const unsigned int texture) override;
+    void updateTexture(const unsigned int texture,
+                       const unsigned int texUnit,
+                       const TextureType type,
+                       const unsigned int x,
+                       const unsigned int y,
+                       const unsigned int width,
+                       const unsigned int height,
+                       void* data) override;
+    void bindTexture(const unsigned int texture, const unsigned int texUnit) override;
+    void drawTriangleStrips(
+        const Vertex* vertices,
+        const unsigned int numVertices,
+        const DrawParams& params,
+        const BlendFactor srcBlendFactor = BlendFactor::ONE,
+        const BlendFactor dstBlendFactor = BlendFactor::ONE_MINUS_SRC_ALPHA) override;
+    void shaderPostprocessing(
+        const unsigned int shaders,
+        const Renderer::postProcessingParams& parameters = postProcessingParams(),
+        unsigned char* textureRGBA = nullptr) override;
+
+private:
+    RendererNull() noexcept;
+
+    void addTextureUpload(const TextureType type,
+                          const unsigned int width,
+                          const unsigned int height);
+
+    Statistics mStatistics;
+    unsigned int mLastTexture;
+    unsigned int mBoundTexture;
+    BlendFactor mBatchSrcBlendFactor;
+    BlendFactor mBatchDstBlendFactor;
+    // Number of draws in the current batch.
+    unsigned int mBatchDraws;
+    // Whether the next core shader draw could be added to the previous batch.
+    bool mBatchOpen;
+};
+
+#endif // ES_CORE_RENDERER_RENDERER_NULL_H
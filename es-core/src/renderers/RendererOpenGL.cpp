@@ -10,6 +10,10 @@
 
 #include "Settings.h"
 
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+
 #if defined(__APPLE__)
 #include <chrono>
 #endif
@@ -19,6 +23,15 @@ RendererOpenGL::RendererOpenGL() noexcept
     , mShaderFBO2 {0}
     , mVertexBuffer1 {0}
     , mVertexBuffer2 {0}
+    , mBatchVertexBuffer {0}
+    , mBatchDrawBuffer {0}
+    , mBatchVertexArray {0}
+    , mBatchBufferSize {0}
+    , mBatchBufferOffset {0}
+    , mBatchSrcBlendFactor {GL_ONE}
+    , mBatchDstBlendFactor {GL_ONE_MINUS_SRC_ALPHA}
+    , mBoundTexture {0}
+    , mBatchAttribPointersSet {false}
     , mSDLContext {nullptr}
     , mWhiteTexture {0}
     , mPostProcTexture1 {0}
@@ -277,6 +290,19 @@ bool RendererOpenGL::createContext()
     GL_CHECK_ERROR(glGenVertexArrays(1, &mVertexBuffer2));
     GL_CHECK_ERROR(glBindVertexArray(mVertexBuffer2));
 
+    // The core shader draws are batched using a separate streaming vertex buffer which is
+    // allocated on the first flush, see flushBatch(). The parameters for each draw are read
+    // by the shader from a uniform buffer which stays bound to binding point 0.
+    GL_CHECK_ERROR(glGenBuffers(1, &mBatchVertexBuffer));
+    GL_CHECK_ERROR(glGenVertexArrays(1, &mBatchVertexArray));
+    GL_CHECK_ERROR(glGenBuffers(1, &mBatchDrawBuffer));
+    GL_CHECK_ERROR(glBindBuffer(GL_UNIFORM_BUFFER, mBatchDrawBuffer));
+    GL_CHECK_ERROR(glBufferData(GL_UNIFORM_BUFFER, sizeof(BatchDraw) * BATCH_MAX_DRAWS, nullptr,
+                                GL_STREAM_DRAW));
+    GL_CHECK_ERROR(glBindBufferBase(GL_UNIFORM_BUFFER, 0, mBatchDrawBuffer));
+    mBatchVertices.reserve(BATCH_BUFFER_MIN_SIZE);
+    mBatchDraws.reserve(BATCH_MAX_DRAWS);
+
     uint8_t data[4] {255, 255, 255, 255};
     mWhiteTexture = createTexture(0, TextureType::BGRA, false, false, false, true, 1, 1, data);
 
@@ -313,6 +339,18 @@ bool RendererOpenGL::createContext()
 
 void RendererOpenGL::destroyContext()
 {
+    mBatchVertices.clear();
+    mBatchDraws.clear();
+    GL_CHECK_ERROR(glDeleteBuffers(1, &mBatchVertexBuffer));
+    GL_CHECK_ERROR(glDeleteBuffers(1, &mBatchDrawBuffer));
+    GL_CHECK_ERROR(glDeleteVertexArrays(1, &mBatchVertexArray));
+    mBatchVertexBuffer = 0;
+    mBatchDrawBuffer = 0;
+    mBatchVertexArray = 0;
+    mBatchBufferSize = 0;
+    mBatchBufferOffset = 0;
+    mBatchAttribPointersSet = false;
+
     GL_CHECK_ERROR(glDeleteFramebuffers(1, &mShaderFBO1));
     GL_CHECK_ERROR(glDeleteFramebuffers(1, &mShaderFBO2));
     destroyTexture(mPostProcTexture1);
@@ -326,6 +364,7 @@ void RendererOpenGL::destroyContext()
     mBlurVerticalShader.reset();
     mScanlinelShader.reset();
     mLastShader.reset();
+    mBoundTexture = 0;
 
     SDL_GL_DeleteContext(mSDLContext);
     mSDLContext = nullptr;
@@ -339,6 +378,7 @@ void RendererOpenGL::setMatrix(const glm::mat4& matrix)
 
 void RendererOpenGL::setViewport(const Rect& viewport)
 {
+    flushBatch();
     // glViewport starts at the bottom left of the window.
     GL_CHECK_ERROR(
         glViewport(viewport.x, mWindowHeight - viewport.y - viewport.h, viewport.w, viewport.h));
@@ -346,6 +386,8 @@ void RendererOpenGL::setViewport(const Rect& viewport)
 
 void RendererOpenGL::setScissor(const Rect& scissor)
 {
+    flushBatch();
+
     if ((scissor.x == 0) && (scissor.y == 0) && (scissor.w == 0) && (scissor.h == 0)) {
         GL_CHECK_ERROR(glDisable(GL_SCISSOR_TEST));
     }
@@ -379,6 +421,8 @@ void RendererOpenGL::setSwapInterval()
 
 void RendererOpenGL::swapBuffers()
 {
+    flushBatch();
+
 #if defined(__APPLE__)
     // On macOS when running in the background, the OpenGL driver apparently does not swap
     // the frames which leads to a very fast swap time. This makes ES-DE use a lot of CPU
@@ -398,6 +442,12 @@ void RendererOpenGL::swapBuffers()
     GL_CHECK_ERROR(glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT));
 }
 
+void RendererOpenGL::clearScreen()
+{
+    flushBatch();
+    GL_CHECK_ERROR(glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT));
+}
+
 unsigned int RendererOpenGL::createTexture(const unsigned int texUnit,
                                            const TextureType type,
                                            const bool linearMinify,
@@ -413,10 +463,15 @@ unsigned int RendererOpenGL::createTexture(const unsigned int texUnit,
     const GLenum textureType {convertTextureType(type)};
     unsigned int texture;
 
+    flushBatch();
+
     GL_CHECK_ERROR(glActiveTexture(GL_TEXTURE0 + texUnit));
     GL_CHECK_ERROR(glGenTextures(1, &texture));
     GL_CHECK_ERROR(glBindTexture(GL_TEXTURE_2D, texture));
 
+    if (texUnit == 0)
+        mBoundTexture = texture;
+
     GL_CHECK_ERROR(glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S,
                                    repeat ? static_cast<GLfloat>(GL_REPEAT) :
                                             static_cast<GLfloat>(GL_CLAMP_TO_EDGE)));
@@ -460,7 +515,11 @@ unsigned int RendererOpenGL::createTexture(const unsigned int texUnit,
 
 void RendererOpenGL::destroyTexture(const unsigned int texture)
 {
+    flushBatch();
     GL_CHECK_ERROR(glDeleteTextures(1, &texture));
+
+    if (texture == mBoundTexture)
+        mBoundTexture = 0;
 }
 
 void RendererOpenGL::updateTexture(const unsigned int texture,
@@ -475,67 +534,70 @@ void RendererOpenGL::updateTexture(const unsigned int texture,
     assert(texUnit < 32);
 
     const GLenum textureType {convertTextureType(type)};
+
+    // Any pending draws may be using the texture contents that are about to be replaced.
+    flushBatch();
+
     GL_CHECK_ERROR(glActiveTexture(GL_TEXTURE0 + texUnit));
     GL_CHECK_ERROR(glBindTexture(GL_TEXTURE_2D, texture));
     GL_CHECK_ERROR(glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, textureType,
                                    GL_UNSIGNED_BYTE, data));
 
     GL_CHECK_ERROR(glBindTexture(GL_TEXTURE_2D, mWhiteTexture));
+
+    if (texUnit == 0)
+        mBoundTexture = mWhiteTexture;
 }
 
 void RendererOpenGL::bindTexture(const unsigned int texture, const unsigned int texUnit)
 {
     assert(texUnit < 32);
 
+    const GLuint textureID {texture == 0 ? mWhiteTexture : texture};
+
+    // Rebinding the same texture would needlessly break up the current batch.
+    if (texUnit == 0 && textureID == mBoundTexture)
+        return;
+
+    flushBatch();
+
     GL_CHECK_ERROR(glActiveTexture(GL_TEXTURE0 + texUnit));
+    GL_CHECK_ERROR(glBindTexture(GL_TEXTURE_2D, textureID));
 
-    if (texture == 0)
-        GL_CHECK_ERROR(glBindTexture(GL_TEXTURE_2D, mWhiteTexture));
-    else
-        GL_CHECK_ERROR(glBindTexture(GL_TEXTURE_2D, texture));
+    if (texUnit == 0)
+        mBoundTexture = textureID;
 }
 
 void RendererOpenGL::drawTriangleStrips(const Vertex* vertices,
                                         const unsigned int numVertices,
+                                        const DrawParams& params,
                                         const BlendFactor srcBlendFactor,
                                         const BlendFactor dstBlendFactor)
 {
     const float width {vertices[3].position[0]};
     const float height {vertices[3].position[1]};
 
+    if (params.shaders == 0 || params.shaders & Shader::CORE) {
+        if (mCoreShader == nullptr)
+            mCoreShader = getShaderProgram(Shader::CORE);
+        if (mCoreShader)
+            addToBatch(vertices, numVertices, params, convertBlendFactor(srcBlendFactor),
+                       convertBlendFactor(dstBlendFactor));
+        return;
+    }
+
+    flushBatch();
+
     GL_CHECK_ERROR(
         glBlendFunc(convertBlendFactor(srcBlendFactor), convertBlendFactor(dstBlendFactor)));
 
-    if (vertices->shaders == 0 || vertices->shaders & Shader::CORE) {
-        if (mCoreShader == nullptr)
-            mCoreShader = getShaderProgram(Shader::CORE);
-        if (mCoreShader) {
-            if (mLastShader != mCoreShader)
-                mCoreShader->activateShaders();
-            mCoreShader->setModelViewProjectionMatrix(mTrans);
-            if (mLastShader != mCoreShader)
-                mCoreShader->setAttribPointers();
-            GL_CHECK_ERROR(glBufferData(GL_ARRAY_BUFFER, sizeof(Vertex) * numVertices, vertices,
-                                        GL_DYNAMIC_DRAW));
-            mCoreShader->setTextureSamplers();
-            mCoreShader->setTextureSize({width, height});
-            mCoreShader->setClipRegion(vertices->clipRegion);
-            mCoreShader->setBrightness(vertices->brightness);
-            mCoreShader->setOpacity(vertices->opacity);
-            mCoreShader->setSaturation(vertices->saturation);
-            mCoreShader->setDimming(vertices->dimming);
-            if (vertices->shaderFlags & ShaderFlags::ROUNDED_CORNERS ||
-                vertices->shaderFlags & ShaderFlags::ROUNDED_CORNERS_NO_AA) {
-                mCoreShader->setTextureSize({width, height});
-                mCoreShader->setCornerRadius(vertices->cornerRadius);
-            }
-            mCoreShader->setReflectionsFalloff(vertices->reflectionsFalloff);
-            mCoreShader->setFlags(vertices->shaderFlags);
-            GL_CHECK_ERROR(glDrawArrays(GL_TRIANGLE_STRIP, 0, numVertices));
-            mLastShader = mCoreShader;
-        }
+    // The batched core shader draws use their own vertex array and vertex buffer.
+    if (mLastShader != nullptr && mLastShader == mCoreShader) {
+        GL_CHECK_ERROR(glBindVertexArray(mVertexBuffer2));
+        GL_CHECK_ERROR(glBindBuffer(GL_ARRAY_BUFFER, mVertexBuffer1));
     }
-    else if (vertices->shaders & Shader::BLUR_HORIZONTAL) {
+
+    if (params.shaders & Shader::BLUR_HORIZONTAL) {
         if (mBlurHorizontalShader == nullptr)
             mBlurHorizontalShader = getShaderProgram(Shader::BLUR_HORIZONTAL);
         if (mBlurHorizontalShader) {
@@ -546,15 +608,15 @@ void RendererOpenGL::drawTriangleStrips(const Vertex* vertices,
                 mBlurHorizontalShader->setAttribPointers();
             GL_CHECK_ERROR(glBufferData(GL_ARRAY_BUFFER, sizeof(Vertex) * numVertices, vertices,
                                         GL_DYNAMIC_DRAW));
-            mBlurHorizontalShader->setBlurStrength((vertices->blurStrength / getScreenWidth()) *
+            mBlurHorizontalShader->setBlurStrength((params.blurStrength / getScreenWidth()) *
                                                    getScreenResolutionModifier());
-            mBlurHorizontalShader->setFlags(vertices->shaderFlags);
+            mBlurHorizontalShader->setFlags(params.shaderFlags);
             GL_CHECK_ERROR(glDrawArrays(GL_TRIANGLE_STRIP, 0, numVertices));
             mLastShader = mBlurHorizontalShader;
         }
         return;
     }
-    else if (vertices->shaders & Shader::BLUR_VERTICAL) {
+    else if (params.shaders & Shader::BLUR_VERTICAL) {
         if (mBlurVerticalShader == nullptr)
             mBlurVerticalShader = getShaderProgram(Shader::BLUR_VERTICAL);
         if (mBlurVerticalShader) {
@@ -565,15 +627,15 @@ void RendererOpenGL::drawTriangleStrips(const Vertex* vertices,
                 mBlurVerticalShader->setAttribPointers();
             GL_CHECK_ERROR(glBufferData(GL_ARRAY_BUFFER, sizeof(Vertex) * numVertices, vertices,
                                         GL_DYNAMIC_DRAW));
-            mBlurVerticalShader->setBlurStrength((vertices->blurStrength / getScreenHeight()) *
+            mBlurVerticalShader->setBlurStrength((params.blurStrength / getScreenHeight()) *
                                                  getScreenResolutionModifier());
-            mBlurVerticalShader->setFlags(vertices->shaderFlags);
+            mBlurVerticalShader->setFlags(params.shaderFlags);
             GL_CHECK_ERROR(glDrawArrays(GL_TRIANGLE_STRIP, 0, numVertices));
             mLastShader = mBlurVerticalShader;
         }
         return;
     }
-    else if (vertices->shaders & Shader::SCANLINES) {
+    else if (params.shaders & Shader::SCANLINES) {
         if (mScanlinelShader == nullptr)
             mScanlinelShader = getShaderProgram(Shader::SCANLINES);
         float shaderWidth {width * 1.2f};
@@ -603,22 +665,136 @@ void RendererOpenGL::drawTriangleStrips(const Vertex* vertices,
                 mScanlinelShader->setAttribPointers();
             GL_CHECK_ERROR(glBufferData(GL_ARRAY_BUFFER, sizeof(Vertex) * numVertices, vertices,
                                         GL_DYNAMIC_DRAW));
-            mScanlinelShader->setOpacity(vertices->opacity);
-            mScanlinelShader->setBrightness(vertices->brightness);
-            mScanlinelShader->setSaturation(vertices->saturation);
+            mScanlinelShader->setOpacity(params.opacity);
+            mScanlinelShader->setBrightness(params.brightness);
+            mScanlinelShader->setSaturation(params.saturation);
             mScanlinelShader->setTextureSize({shaderWidth, shaderHeight});
-            mScanlinelShader->setFlags(vertices->shaderFlags);
+            mScanlinelShader->setFlags(params.shaderFlags);
             GL_CHECK_ERROR(glDrawArrays(GL_TRIANGLE_STRIP, 0, numVertices));
             mLastShader = mScanlinelShader;
         }
     }
 }
 
+void RendererOpenGL::addToBatch(const Vertex* vertices,
+                                const unsigned int numVertices,
+                                const DrawParams& params,
+                                const GLenum srcBlendFactor,
+                                const GLenum dstBlendFactor)
+{
+    if (numVertices == 0)
+        return;
+
+    if (!mBatchVertices.empty() &&
+        (srcBlendFactor != mBatchSrcBlendFactor || dstBlendFactor != mBatchDstBlendFactor ||
+         mBatchDraws.size() == BATCH_MAX_DRAWS))
+        flushBatch();
+
+    mBatchSrcBlendFactor = srcBlendFactor;
+    mBatchDstBlendFactor = dstBlendFactor;
+
+    const unsigned int drawIndex {static_cast<unsigned int>(mBatchDraws.size())};
+    mBatchDraws.emplace_back(BatchDraw {
+        params.clipRegion,
+        {params.brightness, params.opacity, params.saturation, params.dimming},
+        {vertices[3].position.x, vertices[3].position.y, params.cornerRadius,
+         params.reflectionsFalloff},
+        params.shaderFlags,
+        {0, 0, 0}});
+
+    auto batchVertex = [&](const Vertex& vertex) {
+        return BatchVertex {mTrans * glm::vec4 {vertex.position.x, vertex.position.y, 0.0f, 1.0f},
+                            vertex.position, vertex.texcoord, vertex.color, drawIndex};
+    };
+
+    if (!mBatchVertices.empty()) {
+        // Join the triangle strips using two degenerate triangles.
+        const BatchVertex lastVertex {mBatchVertices.back()};
+        mBatchVertices.emplace_back(lastVertex);
+        mBatchVertices.emplace_back(batchVertex(vertices[0]));
+    }
+
+    for (unsigned int i {0}; i < numVertices; ++i)
+        mBatchVertices.emplace_back(batchVertex(vertices[i]));
+}
+
+void RendererOpenGL::flushBatch()
+{
+    if (mBatchVertices.empty())
+        return;
+
+    if (mLastShader != mCoreShader) {
+        mCoreShader->activateShaders();
+        mCoreShader->setTextureSamplers();
+        mCoreShader->setBatchDrawsBinding(0);
+        GL_CHECK_ERROR(glBindVertexArray(mBatchVertexArray));
+        GL_CHECK_ERROR(glBindBuffer(GL_ARRAY_BUFFER, mBatchVertexBuffer));
+        mLastShader = mCoreShader;
+    }
+
+    if (!mBatchAttribPointersSet) {
+        mCoreShader->setBatchAttribPointers(
+            sizeof(BatchVertex), offsetof(BatchVertex, clipPosition),
+            offsetof(BatchVertex, position), offsetof(BatchVertex, texcoord),
+            offsetof(BatchVertex, color), offsetof(BatchVertex, drawIndex));
+        mBatchAttribPointersSet = true;
+    }
+
+    const size_t numVertices {mBatchVertices.size()};
+
+    // The buffer is written sequentially and is orphaned when full, so the driver allocates
+    // new storage instead of waiting for the GPU to finish with the previous contents.
+    if (mBatchBufferOffset + numVertices > mBatchBufferSize) {
+        mBatchBufferSize = std::max(mBatchBufferSize, BATCH_BUFFER_MIN_SIZE);
+        while (mBatchBufferSize < numVertices)
+            mBatchBufferSize *= 2;
+        GL_CHECK_ERROR(glBufferData(GL_ARRAY_BUFFER, sizeof(BatchVertex) * mBatchBufferSize,
+                                    nullptr, GL_STREAM_DRAW));
+        mBatchBufferOffset = 0;
+    }
+
+    // As the written range is never in use by a pending draw it's safe to map it unsynchronized.
+    void* bufferData {glMapBufferRange(
+        GL_ARRAY_BUFFER, sizeof(BatchVertex) * mBatchBufferOffset,
+        sizeof(BatchVertex) * numVertices,
+        GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT)};
+
+    if (bufferData != nullptr) {
+        std::memcpy(bufferData, mBatchVertices.data(), sizeof(BatchVertex) * numVertices);
+        GL_CHECK_ERROR(glUnmapBuffer(GL_ARRAY_BUFFER));
+    }
+    else {
+        GL_CHECK_ERROR(glBufferSubData(GL_ARRAY_BUFFER, sizeof(BatchVertex) * mBatchBufferOffset,
+                                       sizeof(BatchVertex) * numVertices,
+                                       mBatchVertices.data()));
+    }
+
+    // The draw parameters are small enough that orphaning and rewriting the whole uniform
+    // buffer for every batch is cheaper than synchronizing with the previous batch.
+    GL_CHECK_ERROR(glBindBuffer(GL_UNIFORM_BUFFER, mBatchDrawBuffer));
+    GL_CHECK_ERROR(glBufferData(GL_UNIFORM_BUFFER, sizeof(BatchDraw) * BATCH_MAX_DRAWS, nullptr,
+                                GL_STREAM_DRAW));
+    GL_CHECK_ERROR(glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(BatchDraw) * mBatchDraws.size(),
+                                   mBatchDraws.data()));
+
+    GL_CHECK_ERROR(glBlendFunc(mBatchSrcBlendFactor, mBatchDstBlendFactor));
+    GL_CHECK_ERROR(glDrawArrays(GL_TRIANGLE_STRIP, static_cast<GLint>(mBatchBufferOffset),
+                                static_cast<GLsizei>(numVertices)));
+
+    mBatchBufferOffset += numVertices;
+    mBatchVertices.clear();
+    mBatchDraws.clear();
+}
+
 void RendererOpenGL::shaderPostprocessing(unsigned int shaders,
                                           const Renderer::postProcessingParams& parameters,
                                           unsigned char* textureRGBA)
 {
+    // The screen contents are read back below so everything drawn so far is needed.
+    flushBatch();
+
     Vertex vertices[4];
+    DrawParams params;
     std::vector<unsigned int> shaderList;
     float widthf {getScreenWidth()};
     float heightf {getScreenHeight()};
@@ -644,21 +820,21 @@ void RendererOpenGL::shaderPostprocessing(unsigned int shaders,
     vertices[3] = {{widthf, heightf}, {1.0f, 0.0f}, 0xFFFFFFFF};
     // clang-format on
 
-    vertices->opacity = parameters.opacity;
-    vertices->saturation = parameters.saturation;
-    vertices->dimming = parameters.dimming;
-    vertices->blurStrength = parameters.blurStrength;
-    vertices->shaderFlags = ShaderFlags::POST_PROCESSING | ShaderFlags::PREMULTIPLIED;
+    params.opacity = parameters.opacity;
+    params.saturation = parameters.saturation;
+    params.dimming = parameters.dimming;
+    params.blurStrength = parameters.blurStrength;
+    params.shaderFlags = ShaderFlags::POST_PROCESSING | ShaderFlags::PREMULTIPLIED;
 
 #if defined(USE_OPENGLES)
     // This is required as not all mobile GPUs support the glReadPixels() function when using
     // the BGRA pixel format.
     if (textureRGBA)
-        vertices->shaderFlags |= ShaderFlags::CONVERT_PIXEL_FORMAT;
+        params.shaderFlags |= ShaderFlags::CONVERT_PIXEL_FORMAT;
 #endif
 
     if (screenRotation == 90 || screenRotation == 270)
-        vertices->shaderFlags |= ShaderFlags::ROTATED;
+        params.shaderFlags |= ShaderFlags::ROTATED;
 
     if (shaders & Shader::CORE)
         shaderList.push_back(Shader::CORE);
@@ -732,7 +908,7 @@ void RendererOpenGL::shaderPostprocessing(unsigned int shaders,
     bool firstFBO {true};
 
     for (size_t i {0}; i < shaderList.size(); ++i) {
-        vertices->shaders = shaderList[i];
+        params.shaders = shaderList[i];
         int shaderPasses {1};
         // For the blur shaders there is an optional variable to set the number of passes
         // to execute, which proportionally affects the blur amount.
@@ -746,13 +922,15 @@ void RendererOpenGL::shaderPostprocessing(unsigned int shaders,
                 GL_CHECK_ERROR(glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0));
                 if (offsetOrPadding)
                     setViewport(mViewport);
-                drawTriangleStrips(vertices, 4, BlendFactor::SRC_ALPHA,
+                drawTriangleStrips(vertices, 4, params, BlendFactor::SRC_ALPHA,
                                    BlendFactor::ONE_MINUS_SRC_ALPHA);
+                flushBatch();
                 break;
             }
 
-            drawTriangleStrips(vertices, 4, BlendFactor::SRC_ALPHA,
+            drawTriangleStrips(vertices, 4, params, BlendFactor::SRC_ALPHA,
                                BlendFactor::ONE_MINUS_SRC_ALPHA);
+            flushBatch();
 
             if (shaderCalls == 1)
                 break;
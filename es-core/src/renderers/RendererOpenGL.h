@@ -21,6 +21,7 @@
 #endif
 
 #include <memory>
+#include <vector>
 
 class RendererOpenGL : public Renderer
 {
@@ -42,6 +43,7 @@ public:
     void setScissor(const Rect& scissor) override;
     void setSwapInterval() override;
     void swapBuffers() override;
+    void clearScreen() override;
 
     unsigned int createTexture(const unsigned int texUnit,
                                const TextureType type,
@@ -65,6 +67,7 @@ public:
     void drawTriangleStrips(
         const Vertex* vertices,
         const unsigned int numVertices,
+        const DrawParams& params,
         const BlendFactor srcBlendFactor = BlendFactor::ONE,
         const BlendFactor dstBlendFactor = BlendFactor::ONE_MINUS_SRC_ALPHA) override;
     void shaderPostprocessing(
@@ -75,12 +78,60 @@ public:
 private:
     RendererOpenGL() noexcept;
 
+    // Vertex format used by the core shader. The position is transformed on the CPU so that
+    // consecutive draws using the same texture and blend factors can be combined into a single
+    // draw call, and the draw index selects the parameters of the draw from mBatchDraws.
+    struct BatchVertex {
+        glm::vec4 clipPosition;
+        glm::vec2 position;
+        glm::vec2 texcoord;
+        unsigned int color;
+        unsigned int drawIndex;
+    };
+
+    // Parameters for each draw in the batch, this matches the std140 layout of the BatchDraw
+    // structure in the uniform block of the core shader.
+    struct BatchDraw {
+        glm::vec4 clipRegion;
+        // Brightness, opacity, saturation and dimming.
+        glm::vec4 params;
+        // Texture width and height, corner radius and reflections falloff.
+        glm::vec4 shape;
+        unsigned int shaderFlags;
+        unsigned int padding[3];
+    };
+
+    void addToBatch(const Vertex* vertices,
+                    const unsigned int numVertices,
+                    const DrawParams& params,
+                    const GLenum srcBlendFactor,
+                    const GLenum dstBlendFactor);
+    // Uploads the batched vertices to the streaming vertex buffer and draws them. This needs
+    // to be called before any OpenGL state used by the batched draws is changed.
+    void flushBatch();
+
     std::vector<std::shared_ptr<ShaderOpenGL>> mShaderProgramVector;
     GLuint mShaderFBO1;
     GLuint mShaderFBO2;
     GLuint mVertexBuffer1;
     GLuint mVertexBuffer2;
 
+    static inline const size_t BATCH_BUFFER_MIN_SIZE {16384};
+
+    std::vector<BatchVertex> mBatchVertices;
+    std::vector<BatchDraw> mBatchDraws;
+    GLuint mBatchVertexBuffer;
+    GLuint mBatchDrawBuffer;
+    GLuint mBatchVertexArray;
+    // Size of the streaming buffer and the position where the next batch will be written,
+    // both counted in vertices.
+    size_t mBatchBufferSize;
+    size_t mBatchBufferOffset;
+    GLenum mBatchSrcBlendFactor;
+    GLenum mBatchDstBlendFactor;
+    GLuint mBoundTexture;
+    bool mBatchAttribPointersSet;
+
     SDL_GLContext mSDLContext;
     GLuint mWhiteTexture;
     GLuint mPostProcTexture1;
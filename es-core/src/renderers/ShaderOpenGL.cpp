@@ -18,8 +18,12 @@ ShaderOpenGL::ShaderOpenGL()
     , mShaderPosition {0}
     , mShaderTextureCoord {0}
     , mShaderColor {0}
+    , mShaderClipPosition {0}
+    , mShaderDrawIndex {0}
+    , mShaderBatchDraws {GL_INVALID_INDEX}
     , mTextureSampler0 {0}
     , mTextureSampler1 {0}
+    , mTextureSampler2 {0}
     , mShaderTextureSize {0}
     , mShaderClipRegion {0}
     , mShaderBrightness {0}
@@ -105,15 +109,6 @@ bool ShaderOpenGL::createProgram()
 
     getVariableLocations(mProgramID);
 
-    if (mShaderPosition != -1)
-        GL_CHECK_ERROR(glEnableVertexAttribArray(mShaderPosition));
-
-    if (mShaderTextureCoord != -1)
-        GL_CHECK_ERROR(glEnableVertexAttribArray(mShaderTextureCoord));
-
-    if (mShaderColor != -1)
-        GL_CHECK_ERROR(glEnableVertexAttribArray(mShaderColor));
-
     return true;
 }
 
@@ -126,8 +121,12 @@ void ShaderOpenGL::getVariableLocations(GLuint programID)
     mShaderPosition = glGetAttribLocation(mProgramID, "positionVertex");
     mShaderTextureCoord = glGetAttribLocation(mProgramID, "texCoordVertex");
     mShaderColor = glGetAttribLocation(mProgramID, "colorVertex");
+    mShaderClipPosition = glGetAttribLocation(mProgramID, "clipPositionVertex");
+    mShaderDrawIndex = glGetAttribLocation(mProgramID, "drawIndexVertex");
+    mShaderBatchDraws = glGetUniformBlockIndex(mProgramID, "BatchDraws");
     mTextureSampler0 = glGetUniformLocation(mProgramID, "textureSampler0");
     mTextureSampler1 = glGetUniformLocation(mProgramID, "textureSampler1");
+    mTextureSampler2 = glGetUniformLocation(mProgramID, "textureSampler2");
     mShaderTextureSize = glGetUniformLocation(mProgramID, "texSize");
     mShaderClipRegion = glGetUniformLocation(mProgramID, "clipRegion");
     mShaderBrightness = glGetUniformLocation(mProgramID, "brightness");
@@ -149,19 +148,62 @@ void ShaderOpenGL::setModelViewProjectionMatrix(glm::mat4 mvpMatrix)
 
 void ShaderOpenGL::setAttribPointers()
 {
-    if (mShaderPosition != -1)
+    // The arrays are enabled together with their pointers as the vertex array object is shared
+    // by all shaders, so an enabled array never lacks a valid pointer.
+    if (mShaderPosition != -1) {
+        GL_CHECK_ERROR(glEnableVertexAttribArray(mShaderPosition));
         GL_CHECK_ERROR(glVertexAttribPointer(
             mShaderPosition, 2, GL_FLOAT, GL_FALSE, sizeof(Renderer::Vertex),
             reinterpret_cast<const void*>(offsetof(Renderer::Vertex, position))));
-    if (mShaderTextureCoord != -1)
+    }
+    if (mShaderTextureCoord != -1) {
+        GL_CHECK_ERROR(glEnableVertexAttribArray(mShaderTextureCoord));
         GL_CHECK_ERROR(glVertexAttribPointer(
             mShaderTextureCoord, 2, GL_FLOAT, GL_FALSE, sizeof(Renderer::Vertex),
             reinterpret_cast<const void*>(offsetof(Renderer::Vertex, texcoord))));
-
-    if (mShaderColor != -1)
+    }
+    if (mShaderColor != -1) {
+        GL_CHECK_ERROR(glEnableVertexAttribArray(mShaderColor));
         GL_CHECK_ERROR(glVertexAttribPointer(
             mShaderColor, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(Renderer::Vertex),
             reinterpret_cast<const void*>(offsetof(Renderer::Vertex, color))));
+    }
+}
+
+void ShaderOpenGL::setBatchAttribPointers(GLsizei stride,
+                                          size_t clipPositionOffset,
+                                          size_t positionOffset,
+                                          size_t texcoordOffset,
+                                          size_t colorOffset,
+                                          size_t drawIndexOffset)
+{
+    auto setFloatPointer = [stride](GLint location, GLint size, GLenum type, GLboolean normalized,
+                                    size_t offset) {
+        if (location == -1)
+            return;
+        GL_CHECK_ERROR(glEnableVertexAttribArray(location));
+        GL_CHECK_ERROR(glVertexAttribPointer(location, size, type, normalized, stride,
+                                             reinterpret_cast<const void*>(offset)));
+    };
+
+    setFloatPointer(mShaderClipPosition, 4, GL_FLOAT, GL_FALSE, clipPositionOffset);
+    setFloatPointer(mShaderPosition, 2, GL_FLOAT, GL_FALSE, positionOffset);
+    setFloatPointer(mShaderTextureCoord, 2, GL_FLOAT, GL_FALSE, texcoordOffset);
+    setFloatPointer(mShaderColor, 4, GL_UNSIGNED_BYTE, GL_TRUE, colorOffset);
+
+    // The draw index is used for indexing an array in the shader so it must not be converted
+    // to a float.
+    if (mShaderDrawIndex != -1) {
+        GL_CHECK_ERROR(glEnableVertexAttribArray(mShaderDrawIndex));
+        GL_CHECK_ERROR(glVertexAttribIPointer(mShaderDrawIndex, 1, GL_UNSIGNED_INT, stride,
+                                              reinterpret_cast<const void*>(drawIndexOffset)));
+    }
+}
+
+void ShaderOpenGL::setBatchDrawsBinding(GLuint bindingPoint)
+{
+    if (mShaderBatchDraws != GL_INVALID_INDEX)
+        GL_CHECK_ERROR(glUniformBlockBinding(mProgramID, mShaderBatchDraws, bindingPoint));
 }
 
 void ShaderOpenGL::setTextureSamplers()
@@ -170,6 +212,8 @@ void ShaderOpenGL::setTextureSamplers()
         GL_CHECK_ERROR(glUniform1i(mTextureSampler0, 0));
     if (mTextureSampler1 != -1)
         GL_CHECK_ERROR(glUniform1i(mTextureSampler1, 1));
+    if (mTextureSampler2 != -1)
+        GL_CHECK_ERROR(glUniform1i(mTextureSampler2, 2));
 }
 
 void ShaderOpenGL::setTextureSize(std::array<GLfloat, 2> shaderVec2)
@@ -67,6 +67,15 @@ public:
     void setModelViewProjectionMatrix(glm::mat4 mvpMatrix);
 
     void setAttribPointers();
+    // Used by the core shader which reads its vertices from RendererOpenGL::BatchVertex.
+    void setBatchAttribPointers(GLsizei stride,
+                                size_t clipPositionOffset,
+                                size_t positionOffset,
+                                size_t texcoordOffset,
+                                size_t colorOffset,
+                                size_t drawIndexOffset);
+    // Used by the core shader which reads the draw parameters from a uniform buffer.
+    void setBatchDrawsBinding(GLuint bindingPoint);
     void setTextureSamplers();
     void setTextureSize(std::array<GLfloat, 2> shaderVec2);
     void setClipRegion(glm::vec4 clipRegion);
@@ -97,8 +106,12 @@ private:
     GLint mShaderPosition;
     GLint mShaderTextureCoord;
     GLint mShaderColor;
+    GLint mShaderClipPosition;
+    GLint mShaderDrawIndex;
+    GLuint mShaderBatchDraws;
     GLint mTextureSampler0;
     GLint mTextureSampler1;
+    GLint mTextureSampler2;
     GLint mShaderTextureSize;
     GLint mShaderClipRegion;
     GLint mShaderBrightness;
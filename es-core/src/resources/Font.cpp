@@ -10,11 +10,15 @@
 #include "resources/Font.h"
 
 #include "Log.h"
+#include "Profiler.h"
 #include "renderers/Renderer.h"
 #include "utils/FileSystemUtil.h"
 #include "utils/PlatformUtil.h"
 #include "utils/StringUtil.h"
 
+#include <algorithm>
+#include <cstring>
+
 Font::Font(float size, const std::string& path)
     : mRenderer {Renderer::getInstance()}
     , mPath(path)
@@ -39,11 +43,24 @@ Font::Font(float size, const std::string& path)
         getGlyph(i);
 
     clearFaceCache();
+
+    if (!sPrewarmCharacters.empty())
+        queuePrewarmJob();
 }
 
 Font::~Font()
 {
-    unload(ResourceManager::getInstance());
+    // The textures are not unloaded here as the atlas pages may still be used by other fonts,
+    // they are released when the last font using them is deleted.
+    {
+        std::unique_lock<std::mutex> lock {sPrewarmMutex};
+        auto entry = sPrewarmedGlyphs.find(std::tuple<float, std::string>(mFontSize, mPath));
+        if (entry != sPrewarmedGlyphs.end()) {
+            for (auto& glyph : entry->second)
+                sPrewarmedSize -= glyph.second.bitmap.size();
+            sPrewarmedGlyphs.erase(entry);
+        }
+    }
 
     auto fontEntry = sFontMap.find(std::tuple<float, std::string>(mFontSize, mPath));
 
@@ -217,7 +234,6 @@ TextCache* Font::buildTextCache(const std::string& text,
     cache->vertexLists.resize(vertMap.size());
     cache->metrics.size = {sizeText(text, lineSpacing)};
     cache->metrics.maxGlyphHeight = mMaxGlyphHeight;
-    cache->clipRegion = {0.0f, 0.0f, 0.0f, 0.0f};
 
     size_t i {0};
     for (auto it = vertMap.cbegin(); it != vertMap.cend(); ++it) {
@@ -238,22 +254,20 @@ void Font::renderTextCache(TextCache* cache)
         return;
     }
 
-    const bool clipRegion {cache->clipRegion != glm::vec4 {0.0f, 0.0f, 0.0f, 0.0f}};
+    Renderer::DrawParams params {cache->params};
+    params.shaderFlags = Renderer::ShaderFlags::FONT_TEXTURE;
+
+    if (params.clipRegion != glm::vec4 {0.0f, 0.0f, 0.0f, 0.0f})
+        params.shaderFlags |= Renderer::ShaderFlags::CLIPPING;
 
     for (auto it = cache->vertexLists.begin(); it != cache->vertexLists.end(); ++it) {
         assert(*it->textureIdPtr != 0);
 
-        it->verts[0].shaderFlags = Renderer::ShaderFlags::FONT_TEXTURE;
-
-        if (clipRegion) {
-            it->verts[0].shaderFlags |= Renderer::ShaderFlags::CLIPPING;
-            it->verts[0].clipRegion = cache->clipRegion;
-        }
-
         mRenderer->bindTexture(*it->textureIdPtr, 0);
-        mRenderer->drawTriangleStrips(
-            &it->verts[0], static_cast<const unsigned int>(it->verts.size()),
-            Renderer::BlendFactor::SRC_ALPHA, Renderer::BlendFactor::ONE_MINUS_SRC_ALPHA);
+        mRenderer->drawTriangleStrips(&it->verts[0],
+                                      static_cast<const unsigned int>(it->verts.size()), params,
+                                      Renderer::BlendFactor::SRC_ALPHA,
+                                      Renderer::BlendFactor::ONE_MINUS_SRC_ALPHA);
     }
 }
 
@@ -486,6 +500,12 @@ size_t Font::getTotalMemUsage()
 {
     size_t total {0};
 
+    // Count the shared atlas pages only once.
+    for (auto it = sTextures.cbegin(); it != sTextures.cend(); ++it) {
+        if (std::shared_ptr<FontTexture> texture {it->lock()})
+            total += texture->textureSize.x * texture->textureSize.y * 4;
+    }
+
     auto it = sFontMap.cbegin();
     while (it != sFontMap.cend()) {
         if (it->second.expired()) {
@@ -493,13 +513,211 @@ size_t Font::getTotalMemUsage()
             continue;
         }
 
-        total += it->second.lock()->getMemUsage();
+        const std::shared_ptr<Font> font {it->second.lock()};
+        for (auto it2 = font->mFaceCache.cbegin(); it2 != font->mFaceCache.cend(); ++it2)
+            total += it2->second->data.length;
         ++it;
     }
 
     return total;
 }
 
+void Font::addPrewarmCharacters(const std::string& text)
+{
+    for (size_t i {0}; i < text.length();) {
+        const unsigned int character {Utils::String::chars2Unicode(text, i)}; // Advances i.
+        if (character >= 127)
+            sPrewarmCharacters.insert(character);
+    }
+}
+
+void Font::prewarmGlyphs()
+{
+    if (sPrewarmCharacters.empty())
+        return;
+
+    LOG(LogDebug) << "Font::prewarmGlyphs(): Rasterizing " << sPrewarmCharacters.size()
+                  << " characters in the background";
+
+    for (auto it = sFontMap.cbegin(); it != sFontMap.cend(); ++it) {
+        if (std::shared_ptr<Font> font {it->second.lock()})
+            font->queuePrewarmJob();
+    }
+}
+
+void Font::stopPrewarming()
+{
+    sPrewarmExit = true;
+
+    if (sPrewarmThread.thread.joinable())
+        sPrewarmThread.thread.join();
+
+    std::unique_lock<std::mutex> lock {sPrewarmMutex};
+    sPrewarmJobs.clear();
+    sPrewarmedGlyphs.clear();
+    sPrewarmedSize = 0;
+}
+
+void Font::queuePrewarmJob()
+{
+    static const std::vector<std::string> fallbackFonts {getFallbackFontPaths()};
+
+    PrewarmJob job;
+    job.font = std::tuple<float, std::string>(mFontSize, mPath);
+    job.paths.emplace_back(mPath);
+    job.paths.insert(job.paths.end(), fallbackFonts.cbegin(), fallbackFonts.cend());
+
+    for (unsigned int character : sPrewarmCharacters) {
+        if (mGlyphMap.find(character) == mGlyphMap.cend())
+            job.characters.emplace_back(character);
+    }
+
+    if (job.characters.empty() || sPrewarmExit)
+        return;
+
+    std::unique_lock<std::mutex> lock {sPrewarmMutex};
+    // Creating the entry marks the font as alive so the rasterized glyphs will be kept.
+    sPrewarmedGlyphs[job.font];
+    sPrewarmJobs.emplace_back(std::move(job));
+
+    // The thread exits when there are no more jobs, so start a new one if needed.
+    if (!sPrewarmThreadRunning) {
+        if (sPrewarmThread.thread.joinable())
+            sPrewarmThread.thread.join();
+        sPrewarmThreadRunning = true;
+        sPrewarmThread.thread = std::thread(&Font::prewarmThread);
+    }
+}
+
+void Font::prewarmThread()
+{
+    // FreeType faces can't be used from multiple threads, so a separate library instance with
+    // its own faces is used for rasterizing the glyphs in the background.
+    FT_Library library {nullptr};
+    if (FT_Init_FreeType(&library)) {
+        LOG(LogError) << "Couldn't initialize FreeType for glyph prewarming";
+        std::unique_lock<std::mutex> lock {sPrewarmMutex};
+        sPrewarmJobs.clear();
+        sPrewarmThreadRunning = false;
+        return;
+    }
+
+    // The font file data has to be kept for as long as the faces created from it.
+    std::map<std::string, ResourceData> fontData;
+
+    while (!sPrewarmExit) {
+        PrewarmJob job;
+        size_t prewarmedSize {0};
+        {
+            std::unique_lock<std::mutex> lock {sPrewarmMutex};
+            // Skip jobs for fonts that have been deleted since they were queued.
+            while (!sPrewarmJobs.empty() &&
+                   sPrewarmedGlyphs.find(sPrewarmJobs.front().font) == sPrewarmedGlyphs.cend())
+                sPrewarmJobs.pop_front();
+
+            // The remaining characters will be rasterized on demand instead.
+            if (!sPrewarmJobs.empty() && sPrewarmedSize >= PREWARM_CACHE_SIZE) {
+                LOG(LogDebug) << "Font::prewarmThread(): Prewarm cache is full, skipping "
+                              << sPrewarmJobs.size() << " remaining font(s)";
+                sPrewarmJobs.clear();
+            }
+
+            if (sPrewarmJobs.empty()) {
+                sPrewarmThreadRunning = false;
+                break;
+            }
+            job = std::move(sPrewarmJobs.front());
+            sPrewarmJobs.pop_front();
+            prewarmedSize = sPrewarmedSize;
+        }
+
+        Profiler::ScopedTimer timer {"Glyph prewarming"};
+
+        // The faces are only loaded when they are actually needed for a character.
+        std::vector<FT_Face> faces(job.paths.size(), nullptr);
+        auto getFace = [&](size_t index) -> FT_Face {
+            if (faces[index] != nullptr)
+                return faces[index];
+
+            auto dataIt = fontData.find(job.paths[index]);
+            if (dataIt == fontData.end()) {
+                dataIt = fontData
+                             .emplace(job.paths[index],
+                                      ResourceManager::getInstance().getFileData(job.paths[index]))
+                             .first;
+            }
+
+            const ResourceData& data {dataIt->second};
+            if (data.ptr == nullptr ||
+                FT_New_Memory_Face(library, data.ptr.get(), static_cast<FT_Long>(data.length), 0,
+                                   &faces[index]) != 0) {
+                faces[index] = nullptr;
+                return nullptr;
+            }
+
+            FT_Set_Char_Size(faces[index], static_cast<FT_F26Dot6>(0.0f),
+                             static_cast<FT_F26Dot6>(std::get<0>(job.font) * 64.0f), 0, 0);
+            return faces[index];
+        };
+
+        std::map<unsigned int, PrewarmedGlyph> glyphs;
+        size_t glyphsSize {0};
+
+        for (unsigned int character : job.characters) {
+            if (sPrewarmExit || prewarmedSize + glyphsSize >= PREWARM_CACHE_SIZE)
+                break;
+
+            // Same face selection as getFaceForChar().
+            FT_Face face {nullptr};
+            for (size_t i {0}; i < job.paths.size(); ++i) {
+                FT_Face candidate {getFace(i)};
+                if (candidate != nullptr && FT_Get_Char_Index(candidate, character) != 0) {
+                    face = candidate;
+                    break;
+                }
+            }
+            if (face == nullptr)
+                face = getFace(0);
+
+            if (face == nullptr || FT_Load_Char(face, character, FT_LOAD_RENDER))
+                continue;
+
+            const FT_GlyphSlot glyphSlot {face->glyph};
+            PrewarmedGlyph& glyph {glyphs[character]};
+            glyph.size = {glyphSlot->bitmap.width, glyphSlot->bitmap.rows};
+            glyph.advance = {glyphSlot->metrics.horiAdvance >> 6,
+                             glyphSlot->metrics.vertAdvance >> 6};
+            glyph.bearing = {glyphSlot->metrics.horiBearingX >> 6,
+                             glyphSlot->metrics.horiBearingY >> 6};
+            glyph.bitmap.resize(glyph.size.x * glyph.size.y);
+
+            for (int row {0}; row < glyph.size.y; ++row) {
+                std::memcpy(&glyph.bitmap[row * glyph.size.x],
+                            glyphSlot->bitmap.buffer + row * glyphSlot->bitmap.pitch,
+                            glyph.size.x);
+            }
+            glyphsSize += glyph.bitmap.size();
+        }
+
+        for (FT_Face face : faces) {
+            if (face != nullptr)
+                FT_Done_Face(face);
+        }
+
+        std::unique_lock<std::mutex> lock {sPrewarmMutex};
+        auto entry = sPrewarmedGlyphs.find(job.font);
+        if (entry != sPrewarmedGlyphs.end()) {
+            entry->second.merge(glyphs);
+            // Any glyphs left over were already present and have not been added.
+            for (auto& glyph : glyphs)
+                glyphsSize -= glyph.second.bitmap.size();
+            sPrewarmedSize += glyphsSize;
+        }
+    }
+
+    FT_Done_FreeType(library);
+}
+
 std::vector<std::string> Font::getFallbackFontPaths()
 {
     std::vector<std::string> fontPaths;
@@ -530,15 +748,11 @@ std::vector<std::string> Font::getFallbackFontPaths()
     return fontPaths;
 }
 
-Font::FontTexture::FontTexture(const int mFontSize)
+Font::FontTexture::FontTexture(const glm::ivec2& size)
 {
     textureId = 0;
-    rowHeight = 0;
-    writePos = glm::ivec2 {1, 1};
-
-    // Set the texture atlas to a reasonable size, if we run out of space for adding glyphs then
-    // more textures will be created dynamically.
-    textureSize = glm::ivec2 {mFontSize * 6, mFontSize * 6};
+    textureSize = size;
+    nextShelfPosY = 1;
 }
 
 Font::FontTexture::~FontTexture()
@@ -549,38 +763,57 @@ Font::FontTexture::~FontTexture()
 
 bool Font::FontTexture::findEmpty(const glm::ivec2& size, glm::ivec2& cursorOut)
 {
-    if (size.x > textureSize.x || size.y > textureSize.y)
+    if (size.x + 2 > textureSize.x || size.y + 2 > textureSize.y)
         return false;
 
-    if (writePos.x + size.x + 1 > textureSize.x &&
-        writePos.y + rowHeight + size.y + 1 < textureSize.y) {
-        // Row is full, but the glyph should fit on the next row so move the cursor there.
-        // Leave 1 pixel of space between glyphs so that pixels from adjacent glyphs will not
-        // get sampled during scaling and interpolation, which would lead to edge artifacts.
-        writePos = glm::ivec2 {1, writePos.y + rowHeight + 1};
-        rowHeight = 0;
+    // Empty glyphs such as spaces don't need any space in the texture.
+    if (size.x == 0 || size.y == 0) {
+        cursorOut = glm::ivec2 {0, 0};
+        return true;
     }
 
-    if (writePos.x + size.x + 1 > textureSize.x || writePos.y + size.y + 1 > textureSize.y)
-        return false; // No it still won't fit.
+    const int shelfHeight {(size.y + SHELF_HEIGHT_ALIGNMENT - 1) / SHELF_HEIGHT_ALIGNMENT *
+                           SHELF_HEIGHT_ALIGNMENT};
+
+    // Find the lowest shelf with enough space left for the glyph.
+    Shelf* bestShelf {nullptr};
+    for (auto& shelf : shelves) {
+        if (shelf.height < size.y || shelf.writePosX + size.x + 1 > textureSize.x)
+            continue;
+        if (bestShelf == nullptr || shelf.height < bestShelf->height)
+            bestShelf = &shelf;
+    }
 
-    cursorOut = writePos;
-    // Leave 1 pixel of space between glyphs.
-    writePos.x += size.x + 1;
+    // Rather than wasting space by placing the glyph on a taller shelf, open a new shelf if
+    // there is still room for it. Leave 1 pixel of space between the shelves and the glyphs so
+    // that pixels from adjacent glyphs will not get sampled during scaling and interpolation,
+    // which would lead to edge artifacts.
+    if ((bestShelf == nullptr || bestShelf->height > shelfHeight) &&
+        nextShelfPosY + shelfHeight + 1 <= textureSize.y) {
+        shelves.emplace_back(Shelf {nextShelfPosY, shelfHeight, 1});
+        nextShelfPosY += shelfHeight + 1;
+        bestShelf = &shelves.back();
+    }
+
+    if (bestShelf == nullptr)
+        return false;
 
-    if (size.y > rowHeight)
-        rowHeight = size.y;
+    cursorOut = glm::ivec2 {bestShelf->writePosX, bestShelf->posY};
+    bestShelf->writePosX += size.x + 1;
 
     return true;
 }
 
 void Font::FontTexture::initTexture()
 {
-    assert(textureId == 0);
+    // The atlas pages are shared, so another font may already have initialized this texture.
+    if (textureId != 0)
+        return;
+
     // Create a black texture with zero alpha value so that the single-pixel spaces between the
     // glyphs will not be visible. That would otherwise lead to edge artifacts as these pixels
     // would get sampled during scaling.
-    std::vector<uint8_t> texture(textureSize.x * textureSize.y * 4, 0);
+    std::vector<uint8_t> texture(textureSize.x * textureSize.y, 0);
     textureId =
         Renderer::getInstance()->createTexture(0, Renderer::TextureType::RED, true, true, false,
                                                false, textureSize.x, textureSize.y, &texture[0]);
@@ -627,7 +860,8 @@ void Font::initLibrary()
 
 void Font::rebuildTextures()
 {
-    // Recreate OpenGL textures.
+    // Recreate OpenGL textures. For the atlas pages that are shared with other fonts this is only
+    // done by the first font, but all fonts upload their own glyphs afterwards.
     for (auto it = mTextures.begin(); it != mTextures.end(); ++it)
         (*it)->initTexture();
 
@@ -665,16 +899,39 @@ void Font::getTextureForNewGlyph(const glm::ivec2& glyphSize,
                                  FontTexture*& texOut,
                                  glm::ivec2& cursorOut)
 {
-    if (mTextures.size()) {
-        // Check if the most recent texture has space available for the glyph.
-        texOut = mTextures.back().get();
+    // Check the pages already containing glyphs from this font first so these are kept together.
+    for (auto it = mTextures.cbegin(); it != mTextures.cend(); ++it) {
+        if ((*it)->findEmpty(glyphSize, cursorOut)) {
+            texOut = it->get();
+            return;
+        }
+    }
 
-        // Will this one work?
-        if (texOut->findEmpty(glyphSize, cursorOut))
-            return; // Yes.
+    // Then check the pages shared with other fonts.
+    for (auto it = sTextures.begin(); it != sTextures.end();) {
+        const std::shared_ptr<FontTexture> texture {it->lock()};
+        if (texture == nullptr) {
+            it = sTextures.erase(it);
+            continue;
+        }
+        ++it;
+
+        if (std::find(mTextures.cbegin(), mTextures.cend(), texture) != mTextures.cend())
+            continue;
+
+        if (texture->findEmpty(glyphSize, cursorOut)) {
+            mTextures.emplace_back(texture);
+            texOut = texture.get();
+            return;
+        }
     }
 
-    mTextures.emplace_back(std::make_unique<FontTexture>(static_cast<int>(std::round(mFontSize))));
+    // Glyphs that are too large for a regular page get a page of their own.
+    const glm::ivec2 pageSize {std::max(ATLAS_PAGE_SIZE, glyphSize.x + 2),
+                               std::max(ATLAS_PAGE_SIZE, glyphSize.y + 2)};
+
+    mTextures.emplace_back(std::make_shared<FontTexture>(pageSize));
+    sTextures.emplace_back(mTextures.back());
     texOut = mTextures.back().get();
     texOut->initTexture();
 
@@ -716,6 +973,29 @@ Font::Glyph* Font::getGlyph(const unsigned int id)
     if (it != mGlyphMap.cend())
         return &it->second;
 
+    // Use the glyph from the prewarm thread if it has already been rasterized.
+    if (!sPrewarmCharacters.empty()) {
+        PrewarmedGlyph prewarmed;
+        bool hasPrewarmed {false};
+        {
+            std::unique_lock<std::mutex> lock {sPrewarmMutex};
+            auto entry = sPrewarmedGlyphs.find(std::tuple<float, std::string>(mFontSize, mPath));
+            if (entry != sPrewarmedGlyphs.end()) {
+                auto glyphIt = entry->second.find(id);
+                if (glyphIt != entry->second.end()) {
+                    prewarmed = std::move(glyphIt->second);
+                    entry->second.erase(glyphIt);
+                    sPrewarmedSize -= prewarmed.bitmap.size();
+                    hasPrewarmed = true;
+                }
+            }
+        }
+        if (hasPrewarmed) {
+            return addGlyph(id, prewarmed.size, prewarmed.advance, prewarmed.bearing,
+                            prewarmed.bitmap.data());
+        }
+    }
+
     // We need to create a new entry.
     FT_Face face {getFaceForChar(id)};
     if (!face) {
@@ -724,6 +1004,9 @@ Font::Glyph* Font::getGlyph(const unsigned int id)
         return nullptr;
     }
 
+    Profiler::ScopedTimer timer {"Glyph rasterization"};
+    Profiler::incrementCounter(Profiler::GLYPH_RASTERIZATIONS);
+
     const FT_GlyphSlot glyphSlot {face->glyph};
 
     // If the font does not contain hinting information then force the use of the automatic
@@ -741,9 +1024,21 @@ Font::Glyph* Font::getGlyph(const unsigned int id)
         return nullptr;
     }
 
+    return addGlyph(
+        id, glm::ivec2 {glyphSlot->bitmap.width, glyphSlot->bitmap.rows},
+        glm::ivec2 {glyphSlot->metrics.horiAdvance >> 6, glyphSlot->metrics.vertAdvance >> 6},
+        glm::ivec2 {glyphSlot->metrics.horiBearingX >> 6, glyphSlot->metrics.horiBearingY >> 6},
+        glyphSlot->bitmap.buffer);
+}
+
+Font::Glyph* Font::addGlyph(const unsigned int id,
+                            const glm::ivec2& glyphSize,
+                            const glm::ivec2& advance,
+                            const glm::ivec2& bearing,
+                            unsigned char* bitmap)
+{
     FontTexture* tex {nullptr};
     glm::ivec2 cursor {0, 0};
-    const glm::ivec2 glyphSize {glyphSlot->bitmap.width, glyphSlot->bitmap.rows};
     getTextureForNewGlyph(glyphSize, tex, cursor);
 
     // This should (hopefully) never occur as size constraints are enforced earlier on.
@@ -765,14 +1060,14 @@ Font::Glyph* Font::getGlyph(const unsigned int id)
                     cursor.y / static_cast<float>(tex->textureSize.y)};
     glyph.texSize = {glyphSize.x / static_cast<float>(tex->textureSize.x),
                      glyphSize.y / static_cast<float>(tex->textureSize.y)};
-    glyph.advance = {glyphSlot->metrics.horiAdvance >> 6, glyphSlot->metrics.vertAdvance >> 6};
-    glyph.bearing = {glyphSlot->metrics.horiBearingX >> 6, glyphSlot->metrics.horiBearingY >> 6};
+    glyph.advance = advance;
+    glyph.bearing = bearing;
     glyph.rows = glyphSize.y;
 
     // Upload glyph bitmap to texture.
     if (glyphSize.x > 0 && glyphSize.y > 0) {
         mRenderer->updateTexture(tex->textureId, 0, Renderer::TextureType::RED, cursor.x, cursor.y,
-                                 glyphSize.x, glyphSize.y, glyphSlot->bitmap.buffer);
+                                 glyphSize.x, glyphSize.y, bitmap);
     }
 
     return &glyph;
@@ -817,26 +1112,8 @@ void TextCache::setColor(unsigned int color)
             it2->color = color;
 }
 
-void TextCache::setOpacity(float opacity)
-{
-    for (auto it = vertexLists.begin(); it != vertexLists.end(); ++it) {
-        for (auto it2 = it->verts.begin(); it2 != it->verts.end(); ++it2)
-            it2->opacity = opacity;
-    }
-}
+void TextCache::setOpacity(float opacity) { params.opacity = opacity; }
 
-void TextCache::setSaturation(float saturation)
-{
-    for (auto it = vertexLists.begin(); it != vertexLists.end(); ++it) {
-        for (auto it2 = it->verts.begin(); it2 != it->verts.end(); ++it2)
-            it2->saturation = saturation;
-    }
-}
+void TextCache::setSaturation(float saturation) { params.saturation = saturation; }
 
-void TextCache::setDimming(float dimming)
-{
-    for (auto it = vertexLists.begin(); it != vertexLists.end(); ++it) {
-        for (auto it2 = it->verts.begin(); it2 != it->verts.end(); ++it2)
-            it2->dimming = dimming;
-    }
-}
+void TextCache::setDimming(float dimming) { params.dimming = dimming; }
@@ -17,6 +17,11 @@
 
 #include <ft2build.h>
 #include FT_FREETYPE_H
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <set>
+#include <thread>
 #include <vector>
 
 class TextCache;
@@ -134,28 +139,48 @@ public:
                                               const float sizeMultiplier = 1.0f,
                                               const bool fontSizeDimmed = false);
 
-    // Returns an approximation of VRAM used by this font's texture (in bytes).
+    // Returns an approximation of VRAM used by this font's textures (in bytes). The texture
+    // atlas pages are shared between fonts so they may also be included for other fonts.
     size_t getMemUsage() const;
     // Returns an approximation of total VRAM used by font textures (in bytes).
     static size_t getTotalMemUsage();
 
+    // Adds the characters in the string to the set of characters that will be rasterized in the
+    // background for all fonts, ASCII characters are always loaded and are therefore skipped.
+    // Prewarming stops once PREWARM_CACHE_SIZE bytes of unused glyphs are held in memory.
+    static void addPrewarmCharacters(const std::string& text);
+    // Starts rasterizing the prewarm characters for all loaded fonts on a background thread,
+    // fonts created later on are queued automatically.
+    static void prewarmGlyphs();
+    // Must be called before shutdown if glyph prewarming has been started.
+    static void stopPrewarming();
+
 private:
     Font(float size, const std::string& path);
     static void initLibrary();
 
+    // Texture atlas page which is shared by all fonts regardless of size. The glyphs are packed
+    // on horizontal shelves with heights rounded up to SHELF_HEIGHT_ALIGNMENT, so glyphs of
+    // similar heights end up on the same shelves.
     struct FontTexture {
+        struct Shelf {
+            int posY;
+            int height;
+            int writePosX;
+        };
+
         unsigned int textureId;
         glm::ivec2 textureSize;
-        glm::ivec2 writePos;
-        int rowHeight;
+        std::vector<Shelf> shelves;
+        int nextShelfPosY;
 
-        FontTexture(const int mFontSize);
+        FontTexture(const glm::ivec2& size);
         ~FontTexture();
         bool findEmpty(const glm::ivec2& size, glm::ivec2& cursorOut);
 
         // You must call initTexture() after creating a FontTexture to get a textureId.
         // Initializes the OpenGL texture according to this FontTexture's settings,
-        // updating textureId.
+        // updating textureId. Does nothing if the texture has already been initialized.
         void initTexture();
 
         // Deinitializes any existing OpenGL textures, is automatically called in destructor.
@@ -179,6 +204,21 @@ private:
         int rows;
     };
 
+    // Glyph rasterized by the prewarm thread, waiting to be packed and uploaded.
+    struct PrewarmedGlyph {
+        std::vector<unsigned char> bitmap;
+        glm::ivec2 size;
+        glm::ivec2 advance;
+        glm::ivec2 bearing;
+    };
+
+    struct PrewarmJob {
+        std::tuple<float, std::string> font;
+        // The font path followed by the fallback font paths.
+        std::vector<std::string> paths;
+        std::vector<unsigned int> characters;
+    };
+
     // Completely recreate the texture data for all textures based on mGlyphs information.
     void rebuildTextures();
     void unloadTextures();
@@ -187,9 +227,17 @@ private:
                                FontTexture*& texOut,
                                glm::ivec2& cursorOut);
 
-    std::vector<std::string> getFallbackFontPaths();
+    static std::vector<std::string> getFallbackFontPaths();
     FT_Face getFaceForChar(unsigned int id);
     Glyph* getGlyph(const unsigned int id);
+    Glyph* addGlyph(const unsigned int id,
+                    const glm::ivec2& glyphSize,
+                    const glm::ivec2& advance,
+                    const glm::ivec2& bearing,
+                    unsigned char* bitmap);
+
+    void queuePrewarmJob();
+    static void prewarmThread();
 
     float getNewlineStartOffset(const std::string& text,
                                 const unsigned int& charStart,
@@ -200,9 +248,41 @@ private:
 
     static inline FT_Library sLibrary {nullptr};
     static inline std::map<std::tuple<float, std::string>, std::weak_ptr<Font>> sFontMap;
+    static inline std::vector<std::weak_ptr<FontTexture>> sTextures;
+
+    static inline std::set<unsigned int> sPrewarmCharacters;
+    static inline std::deque<PrewarmJob> sPrewarmJobs;
+    // Only fonts that are still alive have an entry, the glyphs are moved out when used.
+    static inline std::map<std::tuple<float, std::string>, std::map<unsigned int, PrewarmedGlyph>>
+        sPrewarmedGlyphs;
+    // Total size of the bitmaps in sPrewarmedGlyphs.
+    static inline size_t sPrewarmedSize {0};
+    static inline std::mutex sPrewarmMutex;
+    static inline bool sPrewarmThreadRunning {false};
+    static inline std::atomic<bool> sPrewarmExit {false};
+
+    // Joins the thread on exit, as exit() may be called without stopPrewarming() having run
+    // first, such as on emergency shutdowns and early returns from main().
+    struct PrewarmThread {
+        ~PrewarmThread()
+        {
+            sPrewarmExit = true;
+            if (thread.joinable())
+                thread.join();
+        }
+        std::thread thread;
+    };
+    static inline PrewarmThread sPrewarmThread;
+
+    static inline const int ATLAS_PAGE_SIZE {2048};
+    // Upper limit for the rasterized glyphs waiting to be used, as large game collections with
+    // CJK names could otherwise use an unbounded amount of memory for all font sizes.
+    static inline const size_t PREWARM_CACHE_SIZE {16 * 1024 * 1024};
+    static inline const int SHELF_HEIGHT_ALIGNMENT {8};
 
     Renderer* mRenderer;
-    std::vector<std::unique_ptr<FontTexture>> mTextures;
+    // The shared atlas pages containing glyphs from this font.
+    std::vector<std::shared_ptr<FontTexture>> mTextures;
     std::map<unsigned int, std::unique_ptr<FontFace>> mFaceCache;
     std::map<unsigned int, Glyph> mGlyphMap;
 
@@ -234,7 +314,7 @@ public:
     void setOpacity(float opacity);
     void setSaturation(float saturation);
     void setDimming(float dimming);
-    void setClipRegion(const glm::vec4& clip) { clipRegion = clip; }
+    void setClipRegion(const glm::vec4& clip) { params.clipRegion = clip; }
     const glm::vec2& getSize() { return metrics.size; }
 
     friend Font;
@@ -246,7 +326,8 @@ protected:
     };
 
     std::vector<VertexList> vertexLists;
-    glm::vec4 clipRegion;
+    // Shared by all vertex lists, the shader flags are set when rendering.
+    Renderer::DrawParams params;
 };
 
 #endif // ES_CORE_RESOURCES_FONT_H
@@ -11,6 +11,7 @@
 #include "ImageIO.h"
 #include "Log.h"
 #include "resources/ResourceManager.h"
+#include "resources/TextureDiskCache.h"
 #include "utils/StringUtil.h"
 
 #include "lunasvg.h"
@@ -21,12 +22,15 @@ TextureData::TextureData(bool tile)
     : mRenderer {Renderer::getInstance()}
     , mTile {tile}
     , mTextureID {0}
+    , mTextureType {Renderer::TextureType::BGRA}
     , mWidth {0}
     , mHeight {0}
     , mTileWidth {0.0f}
     , mTileHeight {0.0f}
     , mSourceWidth {0.0f}
     , mSourceHeight {0.0f}
+    , mMaxWidth {0}
+    , mMaxHeight {0}
     , mScalable {false}
     , mHasRGBAData {false}
     , mPendingRasterization {false}
@@ -134,9 +138,13 @@ bool TextureData::initImageFromMemory(const unsigned char* fileData, size_t leng
 
     size_t width;
     size_t height;
+    size_t sourceWidth;
+    size_t sourceHeight;
 
+    // Tiled images are repeated at their original size so these are never scaled down.
     std::vector<unsigned char> imageRGBA {ImageIO::loadFromMemoryRGBA32(
-        static_cast<const unsigned char*>(fileData), length, width, height)};
+        static_cast<const unsigned char*>(fileData), length, mTile ? 0 : mMaxWidth.load(),
+        mTile ? 0 : mMaxHeight.load(), width, height, sourceWidth, sourceHeight)};
 
     if (imageRGBA.size() == 0) {
         LOG(LogError) << "Couldn't initialize texture from memory, invalid data ("
@@ -146,8 +154,8 @@ bool TextureData::initImageFromMemory(const unsigned char* fileData, size_t leng
         return false;
     }
 
-    mSourceWidth = static_cast<float>(width);
-    mSourceHeight = static_cast<float>(height);
+    mSourceWidth = static_cast<float>(sourceWidth);
+    mSourceHeight = static_cast<float>(sourceHeight);
     mScalable = false;
 
     return initFromRGBA(imageRGBA.data(), width, height);
@@ -171,6 +179,40 @@ bool TextureData::initFromRGBA(const unsigned char* dataRGBA, size_t width, size
     return true;
 }
 
+void TextureData::updateFromPixels(unsigned char* data,
+                                   size_t width,
+                                   size_t height,
+                                   Renderer::TextureType type)
+{
+    std::unique_lock<std::mutex> lock {mMutex};
+
+    if (!mDataRGBA.empty()) {
+        std::vector<unsigned char> swapVector;
+        mDataRGBA.swap(swapVector);
+        mHasRGBAData = false;
+    }
+
+    if (mTextureID != 0 && (static_cast<size_t>(mWidth) != width ||
+                            static_cast<size_t>(mHeight) != height)) {
+        mRenderer->destroyTexture(mTextureID);
+        mTextureID = 0;
+    }
+
+    if (mTextureID == 0) {
+        mTextureID = mRenderer->createTexture(
+            0, type, true, mLinearMagnify, false, mTile, static_cast<const unsigned int>(width),
+            static_cast<const unsigned int>(height), data);
+    }
+    else {
+        mRenderer->updateTexture(mTextureID, 0, type, 0, 0, static_cast<const unsigned int>(width),
+                                 static_cast<const unsigned int>(height), data);
+    }
+
+    mTextureType = type;
+    mWidth = static_cast<int>(width);
+    mHeight = static_cast<int>(height);
+}
+
 bool TextureData::load()
 {
     if (mInvalidSVGFile)
@@ -180,9 +222,24 @@ bool TextureData::load()
 
     // Need to load. See if there is a file.
     if (!mPath.empty()) {
+        const bool isSVG {
+            Utils::String::toLower(mPath.substr(mPath.size() - 4, std::string::npos)) == ".svg"};
+        const bool diskCache {!isSVG && TextureDiskCache::getInstance().isCacheable(mPath)};
+
+        // Skip decoding altogether if there is already decoded data in the disk cache.
+        if (diskCache) {
+            TextureDiskCache::Image image {};
+            if (TextureDiskCache::getInstance().read(mPath, mMaxWidth, mMaxHeight, image)) {
+                mSourceWidth = image.sourceWidth;
+                mSourceHeight = image.sourceHeight;
+                mScalable = false;
+                return initFromRGBA(image.dataRGBA.data(), image.width, image.height);
+            }
+        }
+
         const ResourceData& data = ResourceManager::getInstance().getFileData(mPath);
         // Is it an SVG?
-        if (Utils::String::toLower(mPath.substr(mPath.size() - 4, std::string::npos)) == ".svg") {
+        if (isSVG) {
             mScalable = true;
             std::string dataString;
             dataString.assign(std::string(reinterpret_cast<char*>(data.ptr.get()), data.length));
@@ -191,6 +248,25 @@ bool TextureData::load()
         else {
             retval =
                 initImageFromMemory(static_cast<const unsigned char*>(data.ptr.get()), data.length);
+
+            if (retval && diskCache) {
+                // Copy the image data so the render thread isn't blocked by the file I/O.
+                std::vector<unsigned char> dataRGBA;
+                int width {0};
+                int height {0};
+                {
+                    std::unique_lock<std::mutex> lock {mMutex};
+                    if (mDataRGBA.size() == static_cast<size_t>(mWidth) * mHeight * 4) {
+                        dataRGBA = mDataRGBA;
+                        width = mWidth;
+                        height = mHeight;
+                    }
+                }
+                if (!dataRGBA.empty())
+                    TextureDiskCache::getInstance().write(mPath, mMaxWidth, mMaxHeight,
+                                                          dataRGBA.data(), width, height,
+                                                          mSourceWidth, mSourceHeight);
+            }
         }
     }
     return retval;
@@ -219,6 +295,7 @@ bool TextureData::uploadAndBind(const unsigned int texUnit)
             return false;
 
         // Upload texture.
+        mTextureType = Renderer::TextureType::BGRA;
         mTextureID =
             mRenderer->createTexture(texUnit, Renderer::TextureType::BGRA, true, mLinearMagnify,
                                      mMipmapping, mTile, static_cast<const unsigned int>(mWidth),
@@ -296,11 +373,14 @@ void TextureData::setSourceSize(float width, float height)
 size_t TextureData::getVRAMUsage()
 {
     if (mHasRGBAData || mTextureID != 0) {
+        // Single channel textures such as the video Y, U and V planes use one byte per pixel.
+        const size_t bytesPerPixel {mTextureType == Renderer::TextureType::RED ? 1u : 4u};
+        const size_t size {static_cast<size_t>(mWidth) * mHeight * bytesPerPixel};
         // The estimated increase in VRAM usage with mipmapping enabled is 33%
         if (mMipmapping)
-            return static_cast<size_t>(static_cast<float>(mWidth * mHeight * 4) * 1.33f);
+            return static_cast<size_t>(static_cast<float>(size) * 1.33f);
         else
-            return mWidth * mHeight * 4;
+            return size;
     }
     else {
         return 0;
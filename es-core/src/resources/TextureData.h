@@ -34,6 +34,14 @@ public:
     bool initImageFromMemory(const unsigned char* fileData, size_t length);
     bool initFromRGBA(const unsigned char* dataRGBA, size_t width, size_t height);
 
+    // Uploads the pixels directly to VRAM, reusing the texture if the size is unchanged. No copy
+    // is kept in RAM so this is intended for textures which are updated every frame.
+    // Must be called from the main thread.
+    void updateFromPixels(unsigned char* data,
+                          size_t width,
+                          size_t height,
+                          Renderer::TextureType type = Renderer::TextureType::BGRA);
+
     // Read the data into memory if necessary.
     bool load();
 
@@ -57,6 +65,12 @@ public:
     float sourceWidth();
     float sourceHeight();
     void setSourceSize(float width, float height);
+    // Raster images are scaled down when loaded if they are larger than this size.
+    void setMaxSize(size_t width, size_t height)
+    {
+        mMaxWidth = width;
+        mMaxHeight = height;
+    }
     void setTileSize(float tileWidth, float tileHeight)
     {
         mTileWidth = tileWidth;
@@ -85,6 +99,8 @@ private:
     bool mTile;
     std::string mPath;
     std::atomic<unsigned int> mTextureID;
+    // Pixel format of the texture in VRAM.
+    std::atomic<Renderer::TextureType> mTextureType;
     std::vector<unsigned char> mDataRGBA;
     std::atomic<int> mWidth;
     std::atomic<int> mHeight;
@@ -92,6 +108,8 @@ private:
     std::atomic<float> mTileHeight;
     std::atomic<float> mSourceWidth;
     std::atomic<float> mSourceHeight;
+    std::atomic<size_t> mMaxWidth;
+    std::atomic<size_t> mMaxHeight;
     std::atomic<bool> mScalable;
     std::atomic<bool> mHasRGBAData;
     std::atomic<bool> mPendingRasterization;
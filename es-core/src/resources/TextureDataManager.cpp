@@ -9,10 +9,21 @@
 #include "resources/TextureDataManager.h"
 
 #include "Log.h"
+#include "Profiler.h"
 #include "Settings.h"
 #include "resources/TextureData.h"
 #include "resources/TextureResource.h"
 
+#include <algorithm>
+
+namespace
+{
+    // Rendered textures are requested every frame, so if a high priority request hasn't been
+    // renewed within this time then the texture is no longer on screen (for instance because
+    // the user scrolled past it) and the request is cancelled.
+    const std::chrono::milliseconds staleRequestTime {250};
+} // namespace
+
 TextureDataManager::TextureDataManager()
 {
     // This blank texture will be used temporarily when there is not yet any data loaded for
@@ -45,7 +56,8 @@ void TextureDataManager::remove(const TextureResource* key)
     }
 }
 
-std::shared_ptr<TextureData> TextureDataManager::get(const TextureResource* key)
+std::shared_ptr<TextureData> TextureDataManager::get(const TextureResource* key,
+                                                     TextureLoader::Priority priority)
 {
     // If it's in the cache then we want to remove it from it's current location and
     // move it to the top.
@@ -61,14 +73,14 @@ std::shared_ptr<TextureData> TextureDataManager::get(const TextureResource* key)
         mTextureLookup[key] = mTextures.cbegin();
 
         // Make sure it's loaded or queued for loading.
-        load(tex);
+        load(tex, false, priority);
     }
     return tex;
 }
 
 bool TextureDataManager::bind(const TextureResource* key, const unsigned int texUnit)
 {
-    std::shared_ptr<TextureData> tex {get(key)};
+    std::shared_ptr<TextureData> tex {get(key, TextureLoader::Priority::HIGH)};
     bool bound {false};
     if (tex != nullptr)
         bound = tex->uploadAndBind(texUnit);
@@ -99,25 +111,28 @@ size_t TextureDataManager::getQueueSize()
     return mLoader->getQueueSize();
 }
 
-void TextureDataManager::load(std::shared_ptr<TextureData> tex, bool block)
+void TextureDataManager::load(std::shared_ptr<TextureData> tex,
+                              bool block,
+                              TextureLoader::Priority priority)
 {
     // See if it's already loaded.
     if (tex->isLoaded())
         return;
     // Not loaded. Make sure there is room.
     size_t size {TextureResource::getTotalMemUsage()};
-    size_t settingVRAM {static_cast<size_t>(Settings::getInstance()->getInt("MaxVRAM"))};
+    size_t settingVRAM {
+        static_cast<size_t>(Settings::getInstance()->getInt(Settings::IntID::MAX_VRAM))};
 
     if (settingVRAM < 128) {
         LOG(LogWarning) << "MaxVRAM is too low at " << settingVRAM
                         << " MiB, setting it to the minimum allowed value of 128 MiB";
-        Settings::getInstance()->setInt("MaxVRAM", 128);
+        Settings::getInstance()->setInt(Settings::IntID::MAX_VRAM, 128);
         settingVRAM = 128;
     }
     else if (settingVRAM > 2048) {
         LOG(LogWarning) << "MaxVRAM is too high at " << settingVRAM
                         << " MiB, setting it to the maximum allowed value of 2048 MiB";
-        Settings::getInstance()->setInt("MaxVRAM", 2048);
+        Settings::getInstance()->setInt(Settings::IntID::MAX_VRAM, 2048);
         settingVRAM = 1024;
     }
 
@@ -135,80 +150,73 @@ void TextureDataManager::load(std::shared_ptr<TextureData> tex, bool block)
     }
 
     if (!block)
-        mLoader->load(tex);
+        mLoader->load(tex, priority);
     else
         tex->load();
 }
 
 TextureLoader::TextureLoader()
-    : mExit(false)
+    : mExit {false}
 {
-    mThread = std::make_unique<std::thread>(&TextureLoader::threadProc, this);
+    // The threads are started on the first load request as the settings have not yet been
+    // read when the static texture data manager is constructed.
 }
 
 TextureLoader::~TextureLoader()
 {
-    // Just abort any waiting texture.
-    std::unique_lock<std::mutex> lock(mMutex);
-    mTextureDataQ.clear();
+    // Just abort any waiting textures.
+    std::unique_lock<std::mutex> lock {mMutex};
+    mHighPriorityQ.clear();
+    mLowPriorityQ.clear();
     mTextureDataLookup.clear();
     lock.unlock();
 
-    // Exit the thread.
-    mExit = true;
-
-    mEvent.notify_one();
-    mThread->join();
-    mThread.reset();
-}
-
-void TextureLoader::threadProc()
-{
-    while (!mExit) {
-        std::shared_ptr<TextureData> textureData;
-        {
-            // Wait for an event to say there is something in the queue.
-            std::unique_lock<std::mutex> lock {mMutex};
-            mEvent.wait(lock);
-            if (!mTextureDataQ.empty()) {
-                textureData = mTextureDataQ.front();
-                mTextureDataQ.pop_front();
-                mTextureDataLookup.erase(mTextureDataLookup.find(textureData.get()));
-            }
-        }
-        // Queue has been released here but we might have a texture to process.
-        while (!mExit && textureData) {
-            textureData->load();
+    setExit();
 
-            // See if there is another item in the queue.
-            textureData = nullptr;
-            std::unique_lock<std::mutex> lock {mMutex};
-            if (!mTextureDataQ.empty()) {
-                textureData = mTextureDataQ.front();
-                mTextureDataQ.pop_front();
-                mTextureDataLookup.erase(mTextureDataLookup.find(textureData.get()));
-            }
-        }
+    for (auto& thread : mThreads) {
+        if (thread.joinable())
+            thread.join();
     }
+    mThreads.clear();
 }
 
-void TextureLoader::load(std::shared_ptr<TextureData> textureData)
+void TextureLoader::load(std::shared_ptr<TextureData> textureData, Priority priority)
 {
     // Make sure it's not already loaded.
-    if (!textureData->isLoaded()) {
-        std::unique_lock<std::mutex> lock {mMutex};
-        // Remove it from the queue if it is already there.
-        auto td = mTextureDataLookup.find(textureData.get());
-        if (td != mTextureDataLookup.cend()) {
-            mTextureDataQ.erase((*td).second);
-            mTextureDataLookup.erase(td);
-        }
+    if (textureData->isLoaded())
+        return;
+
+    std::unique_lock<std::mutex> lock {mMutex};
+
+    if (mExit)
+        return;
+
+    if (mThreads.empty())
+        startThreads();
+
+    // It's already being loaded by one of the worker threads.
+    if (mLoadingTextures.find(textureData.get()) != mLoadingTextures.cend())
+        return;
 
-        // Put it on the start of the queue as we want the newly requested textures to load first.
-        mTextureDataQ.push_front(textureData);
-        mTextureDataLookup[textureData.get()] = mTextureDataQ.cbegin();
-        mEvent.notify_one();
+    // Remove it from the queue if it is already there. A low priority request doesn't demote
+    // a texture that is still waiting to be rendered.
+    auto td = mTextureDataLookup.find(textureData.get());
+    if (td != mTextureDataLookup.cend()) {
+        if ((*td).second->priority == Priority::HIGH && priority == Priority::LOW)
+            return;
+        getQueue((*td).second->priority).erase((*td).second);
+        mTextureDataLookup.erase(td);
     }
+
+    // Put it on the start of the queue as we want the newly requested textures to load first.
+    std::list<QueueEntry>& queue {getQueue(priority)};
+    queue.push_front(QueueEntry {textureData, priority, std::chrono::steady_clock::now()});
+    mTextureDataLookup[textureData.get()] = queue.begin();
+    Profiler::setCounter(Profiler::TEXTURE_QUEUE,
+                         static_cast<int>(mHighPriorityQ.size() + mLowPriorityQ.size()));
+    lock.unlock();
+
+    mEvent.notify_one();
 }
 
 void TextureLoader::remove(std::shared_ptr<TextureData> textureData)
@@ -217,19 +225,99 @@ void TextureLoader::remove(std::shared_ptr<TextureData> textureData)
     std::unique_lock<std::mutex> lock {mMutex};
     auto td = mTextureDataLookup.find(textureData.get());
     if (td != mTextureDataLookup.cend()) {
-        mTextureDataQ.erase((*td).second);
+        getQueue((*td).second->priority).erase((*td).second);
         mTextureDataLookup.erase(td);
     }
 }
 
+void TextureLoader::setExit()
+{
+    {
+        std::unique_lock<std::mutex> lock {mMutex};
+        mExit = true;
+    }
+    mEvent.notify_all();
+}
+
 size_t TextureLoader::getQueueSize()
 {
     // Get the amount of video memory that will be used once all textures in
     // the queue are loaded.
     size_t mem {0};
     std::unique_lock<std::mutex> lock {mMutex};
-    for (auto tex : mTextureDataQ)
-        mem += tex->width() * tex->height() * 4;
+    for (auto& entry : mHighPriorityQ)
+        mem += entry.textureData->width() * entry.textureData->height() * 4;
+    for (auto& entry : mLowPriorityQ)
+        mem += entry.textureData->width() * entry.textureData->height() * 4;
 
     return mem;
 }
+
+void TextureLoader::startThreads()
+{
+    // Keep one core free for the main thread which renders and uploads the textures.
+    int threadCount {std::clamp(Settings::getInstance()->getInt("TextureLoaderThreads"), 0, 16)};
+    if (threadCount == 0)
+        threadCount = std::clamp(static_cast<int>(std::thread::hardware_concurrency()) - 1, 1, 8);
+
+    LOG(LogDebug) << "TextureLoader::startThreads(): Using " << threadCount
+                  << " texture loading thread" << (threadCount == 1 ? "" : "s");
+
+    for (int i {0}; i < threadCount; ++i)
+        mThreads.emplace_back(&TextureLoader::threadProc, this);
+}
+
+void TextureLoader::threadProc()
+{
+    while (true) {
+        std::shared_ptr<TextureData> textureData;
+        {
+            // Wait for an event to say there is something in the queue.
+            std::unique_lock<std::mutex> lock {mMutex};
+            mEvent.wait(lock, [this] {
+                return mExit || !mHighPriorityQ.empty() || !mLowPriorityQ.empty();
+            });
+            if (mExit)
+                break;
+
+            textureData = popTextureData();
+            if (!textureData)
+                continue;
+
+            mLoadingTextures.insert(textureData.get());
+            Profiler::setCounter(Profiler::TEXTURE_QUEUE,
+                                 static_cast<int>(mHighPriorityQ.size() + mLowPriorityQ.size()));
+        }
+
+        // The queue has been released here so the other threads can keep loading in parallel.
+        {
+            Profiler::ScopedTimer timer {"Texture decode"};
+            textureData->load();
+        }
+
+        std::unique_lock<std::mutex> lock {mMutex};
+        mLoadingTextures.erase(textureData.get());
+    }
+}
+
+std::shared_ptr<TextureData> TextureLoader::popTextureData()
+{
+    const auto now = std::chrono::steady_clock::now();
+
+    while (!mHighPriorityQ.empty()) {
+        QueueEntry entry {std::move(mHighPriorityQ.front())};
+        mHighPriorityQ.pop_front();
+        mTextureDataLookup.erase(entry.textureData.get());
+        if (now - entry.requestTime <= staleRequestTime)
+            return entry.textureData;
+    }
+
+    if (!mLowPriorityQ.empty()) {
+        QueueEntry entry {std::move(mLowPriorityQ.front())};
+        mLowPriorityQ.pop_front();
+        mTextureDataLookup.erase(entry.textureData.get());
+        return entry.textureData;
+    }
+
+    return nullptr;
+}
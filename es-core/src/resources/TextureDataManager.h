@@ -10,37 +10,62 @@
 #define ES_CORE_RESOURCES_TEXTURE_DATA_MANAGER_H
 
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <list>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <set>
 #include <thread>
+#include <vector>
 
 class TextureData;
 class TextureResource;
 
+// Loads texture data using a pool of worker threads. Textures that are about to be rendered
+// have high priority and are loaded before textures which were only requested in advance, and
+// within each priority the most recently requested texture is loaded first.
 class TextureLoader
 {
 public:
+    enum class Priority {
+        LOW, // Texture was created or requested but is not necessarily visible.
+        HIGH // Texture is being rendered.
+    };
+
     TextureLoader();
     ~TextureLoader();
 
-    void load(std::shared_ptr<TextureData> textureData);
+    void load(std::shared_ptr<TextureData> textureData, Priority priority = Priority::LOW);
     void remove(std::shared_ptr<TextureData> textureData);
 
-    void setExit() { mExit = true; }
+    void setExit();
     size_t getQueueSize();
 
 private:
-    void processQueue();
+    struct QueueEntry {
+        std::shared_ptr<TextureData> textureData;
+        Priority priority;
+        std::chrono::steady_clock::time_point requestTime;
+    };
+
+    void startThreads();
     void threadProc();
+    // Returns the next texture to load, or nullptr if the queues are empty.
+    std::shared_ptr<TextureData> popTextureData();
+    std::list<QueueEntry>& getQueue(Priority priority)
+    {
+        return (priority == Priority::HIGH ? mHighPriorityQ : mLowPriorityQ);
+    }
 
-    std::list<std::shared_ptr<TextureData>> mTextureDataQ;
-    std::map<TextureData*, std::list<std::shared_ptr<TextureData>>::const_iterator>
-        mTextureDataLookup;
+    std::list<QueueEntry> mHighPriorityQ;
+    std::list<QueueEntry> mLowPriorityQ;
+    std::map<TextureData*, std::list<QueueEntry>::iterator> mTextureDataLookup;
+    // Textures currently being loaded by a worker thread.
+    std::set<TextureData*> mLoadingTextures;
 
-    std::unique_ptr<std::thread> mThread;
+    std::vector<std::thread> mThreads;
     std::mutex mMutex;
     std::condition_variable mEvent;
     std::atomic<bool> mExit;
@@ -72,7 +97,9 @@ public:
     // will be deleted when the other thread has finished with it.
     void remove(const TextureResource* key);
 
-    std::shared_ptr<TextureData> get(const TextureResource* key);
+    std::shared_ptr<TextureData> get(
+        const TextureResource* key,
+        TextureLoader::Priority priority = TextureLoader::Priority::LOW);
     bool bind(const TextureResource* key, const unsigned int texUnit);
 
     // Get the total size of all textures managed by this object, loaded and unloaded in bytes.
@@ -83,8 +110,10 @@ public:
     // be committed to VRAM as the queue is processed.
     size_t getQueueSize();
     // Load a texture, freeing resources as necessary to make space.
-    void load(std::shared_ptr<TextureData> tex, bool block = false);
-    // Make sure that threadProc() does not continue to run during application shutdown.
+    void load(std::shared_ptr<TextureData> tex,
+              bool block = false,
+              TextureLoader::Priority priority = TextureLoader::Priority::LOW);
+    // Make sure that the loader threads do not continue to run during application shutdown.
     void setExit()
     {
         if (mLoader)
@@ -0,0 +1,271 @@
+//  SPDX-License-Identifier: MIT
+//
+//  ES-DE
+//  TextureDiskCache.cpp
+//
+//  On-disk cache of decoded and premultiplied image data, keyed by the image file path,
+//  its modification time and size and the requested texture size. A cache hit avoids
+//  decoding the image file when a texture is reloaded.
+//
+
+#include "resources/TextureDiskCache.h"
+
+#include "Log.h"
+#include "Settings.h"
+#include "utils/FileSystemUtil.h"
+#include "utils/StringUtil.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <tuple>
+
+namespace
+{
+    // Increase the version if the file format is changed, older files will then be replaced.
+    const char cacheFileMagic[4] {'E', 'S', 'T', 'C'};
+    const unsigned int cacheFileVersion {1};
+    // Sanity check for the image dimensions read from the cache files.
+    const unsigned int maxImageDimension {16384};
+
+    struct CacheFileHeader {
+        char magic[4];
+        unsigned int version;
+        unsigned int keyLength;
+        unsigned int width;
+        unsigned int height;
+        float sourceWidth;
+        float sourceHeight;
+    };
+
+    // 64-bit FNV-1a hash, used for the cache file names so they are stable between sessions.
+    unsigned long long hashKey(const std::string& key)
+    {
+        unsigned long long hash {14695981039346656037ull};
+        for (const char character : key) {
+            hash ^= static_cast<unsigned char>(character);
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+} // namespace
+
+TextureDiskCache::TextureDiskCache()
+    : mCacheDirectory {Utils::FileSystem::getAppDataDirectory() + "/cache/textures"}
+    , mTotalSize {0}
+    , mTempFileCounter {0}
+    , mTotalSizeKnown {false}
+{
+}
+
+TextureDiskCache& TextureDiskCache::getInstance()
+{
+    static TextureDiskCache instance;
+    return instance;
+}
+
+const bool TextureDiskCache::isCacheable(const std::string& path) const
+{
+    // Bundled resources are small and are loaded quickly anyway.
+    if (path.empty() || (path.size() > 1 && path[0] == ':' && path[1] == '/'))
+        return false;
+
+    return Settings::getInstance()->getBool(Settings::BoolID::CACHE_DECODED_IMAGES);
+}
+
+bool TextureDiskCache::read(const std::string& path,
+                            size_t targetWidth,
+                            size_t targetHeight,
+                            Image& image)
+{
+    std::string cacheFile;
+    const std::string key {getKey(path, targetWidth, targetHeight, cacheFile)};
+
+    if (key.empty())
+        return false;
+
+#if defined(_WIN64)
+    std::ifstream stream {Utils::String::stringToWideString(cacheFile).c_str(),
+                          std::ios::binary};
+#else
+    std::ifstream stream {cacheFile, std::ios::binary};
+#endif
+
+    if (stream.fail())
+        return false;
+
+    CacheFileHeader header {};
+    stream.read(reinterpret_cast<char*>(&header), sizeof(header));
+
+    if (stream.fail() || std::memcmp(header.magic, cacheFileMagic, sizeof(cacheFileMagic)) != 0 ||
+        header.version != cacheFileVersion || header.keyLength != key.size() ||
+        header.width == 0 || header.height == 0 || header.width > maxImageDimension ||
+        header.height > maxImageDimension)
+        return false;
+
+    // The file name is a hash so the full key is stored in the file to rule out collisions.
+    std::string fileKey(header.keyLength, '\0');
+    stream.read(&fileKey[0], header.keyLength);
+    if (stream.fail() || fileKey != key)
+        return false;
+
+    image.dataRGBA.resize(static_cast<size_t>(header.width) * header.height * 4);
+    stream.read(reinterpret_cast<char*>(image.dataRGBA.data()),
+                static_cast<std::streamsize>(image.dataRGBA.size()));
+
+    if (stream.fail()) {
+        image.dataRGBA.clear();
+        return false;
+    }
+
+    image.width = header.width;
+    image.height = header.height;
+    image.sourceWidth = header.sourceWidth;
+    image.sourceHeight = header.sourceHeight;
+
+    return true;
+}
+
+void TextureDiskCache::write(const std::string& path,
+                             size_t targetWidth,
+                             size_t targetHeight,
+                             const unsigned char* dataRGBA,
+                             size_t width,
+                             size_t height,
+                             float sourceWidth,
+                             float sourceHeight)
+{
+    std::string cacheFile;
+    const std::string key {getKey(path, targetWidth, targetHeight, cacheFile)};
+
+    if (key.empty() || dataRGBA == nullptr || width == 0 || height == 0)
+        return;
+
+    const size_t dataSize {width * height * 4};
+
+    if (!Utils::FileSystem::isDirectory(mCacheDirectory) &&
+        !Utils::FileSystem::createDirectory(mCacheDirectory)) {
+        LOG(LogWarning) << "TextureDiskCache: Couldn't create directory \"" << mCacheDirectory
+                        << "\"";
+        return;
+    }
+
+    CacheFileHeader header {};
+    std::memcpy(header.magic, cacheFileMagic, sizeof(cacheFileMagic));
+    header.version = cacheFileVersion;
+    header.keyLength = static_cast<unsigned int>(key.size());
+    header.width = static_cast<unsigned int>(width);
+    header.height = static_cast<unsigned int>(height);
+    header.sourceWidth = sourceWidth;
+    header.sourceHeight = sourceHeight;
+
+    // Several loader threads may write the same file, so every write uses its own temporary
+    // file which is then renamed to the actual cache file.
+    const std::string tempFile {cacheFile + "." + std::to_string(mTempFileCounter++) + ".tmp"};
+
+#if defined(_WIN64)
+    std::ofstream stream {Utils::String::stringToWideString(tempFile).c_str(),
+                          std::ios::binary | std::ios::trunc};
+#else
+    std::ofstream stream {tempFile, std::ios::binary | std::ios::trunc};
+#endif
+
+    if (stream.fail())
+        return;
+
+    stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    stream.write(key.data(), static_cast<std::streamsize>(key.size()));
+    stream.write(reinterpret_cast<const char*>(dataRGBA), static_cast<std::streamsize>(dataSize));
+    stream.close();
+
+    // If an existing entry is replaced then its size should not be counted twice.
+    const long long previousSize {
+        Utils::FileSystem::exists(cacheFile) ?
+            std::max(0LL, static_cast<long long>(Utils::FileSystem::getFileSize(cacheFile))) :
+            0};
+
+    if (stream.fail() || Utils::FileSystem::replaceFile(tempFile, cacheFile)) {
+        LOG(LogWarning) << "TextureDiskCache: Couldn't write cache file \"" << cacheFile << "\"";
+        Utils::FileSystem::removeFile(tempFile);
+        return;
+    }
+
+    mTotalSize += static_cast<long long>(sizeof(header) + key.size() + dataSize) - previousSize;
+    pruneCache();
+}
+
+std::string TextureDiskCache::getKey(const std::string& path,
+                                     size_t targetWidth,
+                                     size_t targetHeight,
+                                     std::string& cacheFile) const
+{
+    const long long writeTime {Utils::FileSystem::getLastWriteTime(path)};
+
+    if (writeTime == -1)
+        return "";
+
+    std::string key {path};
+    key.append("|")
+        .append(std::to_string(writeTime))
+        .append("|")
+        .append(std::to_string(Utils::FileSystem::getFileSize(path)))
+        .append("|")
+        .append(std::to_string(targetWidth))
+        .append("x")
+        .append(std::to_string(targetHeight));
+
+    std::stringstream fileName;
+    fileName << std::hex << std::setfill('0') << std::setw(16) << hashKey(key);
+    cacheFile = mCacheDirectory + "/" + fileName.str() + ".bin";
+
+    return key;
+}
+
+void TextureDiskCache::pruneCache()
+{
+    const long long maxSize {
+        static_cast<long long>(std::clamp(
+            Settings::getInstance()->getInt(Settings::IntID::CACHE_DECODED_IMAGES_SIZE), 64,
+            16384)) *
+        1024 * 1024};
+
+    std::unique_lock<std::mutex> lock {mMutex};
+
+    if (mTotalSizeKnown && mTotalSize <= maxSize)
+        return;
+
+    // Oldest files first.
+    std::vector<std::tuple<long long, long long, std::string>> cacheFiles;
+    long long totalSize {0};
+
+    for (auto& file : Utils::FileSystem::getDirContent(mCacheDirectory)) {
+        if (Utils::FileSystem::getExtension(file) != ".bin")
+            continue;
+        const long long size {static_cast<long long>(Utils::FileSystem::getFileSize(file))};
+        cacheFiles.emplace_back(Utils::FileSystem::getLastWriteTime(file), size, file);
+        totalSize += size;
+    }
+
+    mTotalSize = totalSize;
+    mTotalSizeKnown = true;
+
+    if (mTotalSize <= maxSize)
+        return;
+
+    std::sort(cacheFiles.begin(), cacheFiles.end());
+
+    // Remove down to three quarters of the limit so that pruning doesn't take place on every
+    // write once the cache is full.
+    for (auto& cacheFile : cacheFiles) {
+        if (mTotalSize <= maxSize / 4 * 3)
+            break;
+        if (Utils::FileSystem::removeFile(std::get<2>(cacheFile)))
+            mTotalSize -= std::get<1>(cacheFile);
+    }
+
+    LOG(LogDebug) << "TextureDiskCache::pruneCache(): Cache size reduced to "
+                  << mTotalSize / 1024 / 1024 << " MiB";
+}
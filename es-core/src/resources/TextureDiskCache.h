@@ -0,0 +1,67 @@
+//  SPDX-License-Identifier: MIT
+//
+//  ES-DE
+//  TextureDiskCache.h
+//
+//  On-disk cache of decoded and premultiplied image data, keyed by the image file path,
+//  its modification time and size and the requested texture size. A cache hit avoids
+//  decoding the image file when a texture is reloaded.
+//
+
+#ifndef ES_CORE_RESOURCES_TEXTURE_DISK_CACHE_H
+#define ES_CORE_RESOURCES_TEXTURE_DISK_CACHE_H
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class TextureDiskCache
+{
+public:
+    struct Image {
+        std::vector<unsigned char> dataRGBA;
+        size_t width;
+        size_t height;
+        float sourceWidth;
+        float sourceHeight;
+    };
+
+    static TextureDiskCache& getInstance();
+
+    // Whether the cache is enabled and whether the file should be cached at all.
+    const bool isCacheable(const std::string& path) const;
+
+    // The target size is the size the image was scaled to, or zero for the original size.
+    // Both functions are safe to call from multiple threads. The image data is written
+    // directly from the passed buffer to avoid copying it.
+    bool read(const std::string& path, size_t targetWidth, size_t targetHeight, Image& image);
+    void write(const std::string& path,
+               size_t targetWidth,
+               size_t targetHeight,
+               const unsigned char* dataRGBA,
+               size_t width,
+               size_t height,
+               float sourceWidth,
+               float sourceHeight);
+
+private:
+    TextureDiskCache();
+
+    // Returns the cache key and sets the cache file path, or returns an empty string if the
+    // image file doesn't exist.
+    std::string getKey(const std::string& path,
+                       size_t targetWidth,
+                       size_t targetHeight,
+                       std::string& cacheFile) const;
+    // Remove the oldest cache files until the total size is below the configured limit.
+    void pruneCache();
+
+    std::string mCacheDirectory;
+    std::mutex mMutex;
+    std::atomic<long long> mTotalSize;
+    std::atomic<unsigned int> mTempFileCounter;
+    bool mTotalSizeKnown;
+};
+
+#endif // ES_CORE_RESOURCES_TEXTURE_DISK_CACHE_H
@@ -21,7 +21,9 @@ TextureResource::TextureResource(const std::string& path,
                                  bool dynamic,
                                  bool linearMagnify,
                                  bool mipmapping,
-                                 bool scalable)
+                                 bool scalable,
+                                 size_t maxWidth,
+                                 size_t maxHeight)
     : mTextureData {nullptr}
     , mInvalidSVGFile {false}
     , mForceLoad {false}
@@ -37,6 +39,8 @@ TextureResource::TextureResource(const std::string& path,
             data->setTileSize(tileWidth, tileHeight);
             data->setLinearMagnify(linearMagnify);
             data->setMipmapping(mipmapping);
+            if (!scalable)
+                data->setMaxSize(maxWidth, maxHeight);
             // Force the texture manager to load it using a blocking load.
             sTextureDataManager.load(data, true);
             if (scalable)
@@ -49,6 +53,8 @@ TextureResource::TextureResource(const std::string& path,
             data->setTileSize(tileWidth, tileHeight);
             data->setLinearMagnify(linearMagnify);
             data->setMipmapping(mipmapping);
+            if (!scalable)
+                data->setMaxSize(maxWidth, maxHeight);
             // Load it so we can read the width/height.
             data->load();
             if (scalable)
@@ -89,6 +95,18 @@ void TextureResource::initFromPixels(const unsigned char* dataRGBA, size_t width
     mSourceSize = glm::vec2 {static_cast<float>(width), static_cast<float>(height)};
 }
 
+void TextureResource::updateFromPixels(unsigned char* data,
+                                       size_t width,
+                                       size_t height,
+                                       Renderer::TextureType type)
+{
+    // This is only valid if we have a local texture data object.
+    assert(mTextureData != nullptr);
+    mTextureData->updateFromPixels(data, width, height, type);
+    mSize = glm::ivec2 {static_cast<int>(width), static_cast<int>(height)};
+    mSourceSize = glm::vec2 {static_cast<float>(width), static_cast<float>(height)};
+}
+
 void TextureResource::initFromMemory(const char* data, size_t length)
 {
     // This is only valid if we have a local texture data object.
@@ -171,7 +189,7 @@ std::shared_ptr<TextureResource> TextureResource::get(const std::string& path,
     const std::string canonicalPath {Utils::FileSystem::getCanonicalPath(path)};
     if (canonicalPath.empty()) {
         std::shared_ptr<TextureResource> tex(new TextureResource(
-            "", tileWidth, tileHeight, tile, false, linearMagnify, mipmapping, false));
+            "", tileWidth, tileHeight, tile, false, linearMagnify, mipmapping, false, 0, 0));
         // Make sure we get properly deinitialized even though we do nothing on reinitialization.
         ResourceManager::getInstance().addReloadable(tex);
         return tex;
@@ -218,7 +236,7 @@ std::shared_ptr<TextureResource> TextureResource::get(const std::string& path,
     // Need to create it.
     std::shared_ptr<TextureResource> tex {std::shared_ptr<TextureResource>(
         new TextureResource(std::get<0>(key), tileWidth, tileHeight, tile, dynamic, linearMagnify,
-                            mipmapping, isScalable))};
+                            mipmapping, isScalable, width, height))};
     std::shared_ptr<TextureData> data {sTextureDataManager.get(tex.get())};
 
     if (!isScalable || (isScalable && width != 0.0f && height != 0.0f)) {
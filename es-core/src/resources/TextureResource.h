@@ -26,6 +26,8 @@ class TextureData;
 class TextureResource : public IReloadable
 {
 public:
+    // For SVG images the width and height is the size to rasterize at, and raster images
+    // larger than this size are scaled down when loaded (if set to zero they never are).
     static std::shared_ptr<TextureResource> get(const std::string& path,
                                                 bool tile = false,
                                                 bool forceLoad = false,
@@ -37,6 +39,11 @@ public:
                                                 float tileWidth = 0.0f,
                                                 float tileHeight = 0.0f);
     void initFromPixels(const unsigned char* dataRGBA, size_t width, size_t height);
+    // Uploads the pixels without keeping a copy in RAM, used for video frames.
+    void updateFromPixels(unsigned char* data,
+                          size_t width,
+                          size_t height,
+                          Renderer::TextureType type = Renderer::TextureType::BGRA);
     virtual void initFromMemory(const char* data, size_t length);
     static void manualUnload(const std::string& path, bool tile);
     static void manualUnloadAll() { sTextureMap.clear(); }
@@ -90,7 +97,9 @@ protected:
                     bool dynamic,
                     bool linearMagnify,
                     bool mipmapping,
-                    bool scalable);
+                    bool scalable,
+                    size_t maxWidth,
+                    size_t maxHeight);
     virtual void unload(ResourceManager& rm);
     virtual void reload(ResourceManager& rm);
 
@@ -8,6 +8,56 @@
 
 #include "utils/CImgUtil.h"
 
+#include "utils/PixelUtil.h"
+
+#include <algorithm>
+
+namespace
+{
+    // Counts the rows and columns along the image edges where all of the selected channels are
+    // zero, in the order left, top, right, bottom. Note that the first row and column from the
+    // bottom and right are never counted, matching how the images were processed originally.
+    void countZeroEdges(const cimg_library::CImg<unsigned char>& image,
+                        int firstChannel,
+                        int lastChannel,
+                        int (&counts)[4])
+    {
+        const int width {image.width()};
+        const int height {image.height()};
+
+        auto isRowZero = [&](int row) {
+            for (int channel {firstChannel}; channel <= lastChannel; ++channel) {
+                if (!Utils::Pixel::isZero(image.data(0, row, 0, channel), width))
+                    return false;
+            }
+            return true;
+        };
+
+        counts[1] = 0;
+        for (int i {height - 1}; i > 0 && isRowZero(i); --i)
+            ++counts[1];
+
+        counts[3] = 0;
+        for (int i {0}; i < height && isRowZero(i); ++i)
+            ++counts[3];
+
+        // A column is zero if the bitwise OR of all its values is zero.
+        std::vector<unsigned char> columns(width, 0);
+        for (int channel {firstChannel}; channel <= lastChannel; ++channel) {
+            for (int row {0}; row < height; ++row)
+                Utils::Pixel::orBytes(columns.data(), image.data(0, row, 0, channel), width);
+        }
+
+        counts[0] = 0;
+        for (int i {0}; i < width && columns[i] == 0; ++i)
+            ++counts[0];
+
+        counts[2] = 0;
+        for (int i {width - 1}; i > 0 && columns[i] == 0; --i)
+            ++counts[2];
+    }
+} // namespace
+
 namespace Utils
 {
     namespace CImg
@@ -16,28 +66,24 @@ namespace Utils
                                cimg_library::CImg<unsigned char>& image)
         {
             // CImg does not interleave pixels as in BGRABGRABGRA so a conversion is required.
-            int counter {0};
-            for (int r {0}; r < image.height(); ++r) {
-                for (int c {0}; c < image.width(); ++c) {
-                    image(c, r, 0, 0) = imageBGRA[counter + 0];
-                    image(c, r, 0, 1) = imageBGRA[counter + 1];
-                    image(c, r, 0, 2) = imageBGRA[counter + 2];
-                    image(c, r, 0, 3) = imageBGRA[counter + 3];
-                    counter += 4;
-                }
-            }
+            Pixel::deinterleave(imageBGRA.data(),
+                                {image.data(0, 0, 0, 0), image.data(0, 0, 0, 1),
+                                 image.data(0, 0, 0, 2), image.data(0, 0, 0, 3)},
+                                static_cast<size_t>(image.width()) * image.height());
         }
 
         void convertCImgToBGRA(const cimg_library::CImg<unsigned char>& image,
                                std::vector<unsigned char>& imageBGRA)
         {
+            const size_t rowSize {static_cast<size_t>(image.width()) * 4};
+            size_t offset {imageBGRA.size()};
+            imageBGRA.resize(offset + rowSize * image.height());
+
             for (int r {image.height() - 1}; r >= 0; --r) {
-                for (int c {0}; c < image.width(); ++c) {
-                    imageBGRA.emplace_back((unsigned char)image(c, r, 0, 0));
-                    imageBGRA.emplace_back((unsigned char)image(c, r, 0, 1));
-                    imageBGRA.emplace_back((unsigned char)image(c, r, 0, 2));
-                    imageBGRA.emplace_back((unsigned char)image(c, r, 0, 3));
-                }
+                Pixel::interleave({image.data(0, r, 0, 0), image.data(0, r, 0, 1),
+                                   image.data(0, r, 0, 2), image.data(0, r, 0, 3)},
+                                  &imageBGRA[offset], image.width());
+                offset += rowSize;
             }
         }
 
@@ -45,28 +91,24 @@ namespace Utils
                                cimg_library::CImg<unsigned char>& image)
         {
             // CImg does not interleave pixels as in RGBARGBARGBA so a conversion is required.
-            int counter {0};
-            for (int r {0}; r < image.height(); ++r) {
-                for (int c {0}; c < image.width(); ++c) {
-                    image(c, r, 0, 0) = imageRGBA[counter + 2];
-                    image(c, r, 0, 1) = imageRGBA[counter + 1];
-                    image(c, r, 0, 2) = imageRGBA[counter + 0];
-                    image(c, r, 0, 3) = imageRGBA[counter + 3];
-                    counter += 4;
-                }
-            }
+            Pixel::deinterleave(imageRGBA.data(),
+                                {image.data(0, 0, 0, 2), image.data(0, 0, 0, 1),
+                                 image.data(0, 0, 0, 0), image.data(0, 0, 0, 3)},
+                                static_cast<size_t>(image.width()) * image.height());
         }
 
         void convertCImgToRGBA(const cimg_library::CImg<unsigned char>& image,
                                std::vector<unsigned char>& imageRGBA)
         {
+            const size_t rowSize {static_cast<size_t>(image.width()) * 4};
+            size_t offset {imageRGBA.size()};
+            imageRGBA.resize(offset + rowSize * image.height());
+
             for (int r {image.height() - 1}; r >= 0; --r) {
-                for (int c {0}; c < image.width(); ++c) {
-                    imageRGBA.emplace_back((unsigned char)image(c, r, 0, 2));
-                    imageRGBA.emplace_back((unsigned char)image(c, r, 0, 1));
-                    imageRGBA.emplace_back((unsigned char)image(c, r, 0, 0));
-                    imageRGBA.emplace_back((unsigned char)image(c, r, 0, 3));
-                }
+                Pixel::interleave({image.data(0, r, 0, 2), image.data(0, r, 0, 1),
+                                   image.data(0, r, 0, 0), image.data(0, r, 0, 3)},
+                                  &imageRGBA[offset], image.width());
+                offset += rowSize;
             }
         }
 
@@ -77,53 +119,8 @@ namespace Utils
             if (image.spectrum() != 4)
                 return;
 
-            double pixelValueSum {0.0};
-            int rowCounterTop {0};
-            int rowCounterBottom {0};
-            unsigned int columnCounterLeft {0};
-            unsigned int columnCounterRight {0};
-
             // Count the number of rows and columns that are completely transparent.
-            for (int i {image.height() - 1}; i > 0; --i) {
-                cimg_library::CImg<unsigned char> imageRow = image.get_rows(i, i);
-                pixelValueSum = imageRow.get_shared_channel(3).sum();
-                if (pixelValueSum == 0.0)
-                    ++rowCounterTop;
-                else
-                    break;
-            }
-
-            for (int i {0}; i < image.height(); ++i) {
-                cimg_library::CImg<unsigned char> imageRow = image.get_rows(i, i);
-                pixelValueSum = imageRow.get_shared_channel(3).sum();
-                if (pixelValueSum == 0.0)
-                    ++rowCounterBottom;
-                else
-                    break;
-            }
-
-            for (int i {0}; i < image.width(); ++i) {
-                cimg_library::CImg<unsigned char> imageColumn = image.get_columns(i, i);
-                pixelValueSum = imageColumn.get_shared_channel(3).sum();
-                if (pixelValueSum == 0.0)
-                    ++columnCounterLeft;
-                else
-                    break;
-            }
-
-            for (int i {image.width() - 1}; i > 0; --i) {
-                cimg_library::CImg<unsigned char> imageColumn = image.get_columns(i, i);
-                pixelValueSum = imageColumn.get_shared_channel(3).sum();
-                if (pixelValueSum == 0.0)
-                    ++columnCounterRight;
-                else
-                    break;
-            }
-
-            imageCoords[0] = columnCounterLeft;
-            imageCoords[1] = rowCounterTop;
-            imageCoords[2] = columnCounterRight;
-            imageCoords[3] = rowCounterBottom;
+            countZeroEdges(image, 3, 3, imageCoords);
         }
 
         void removeTransparentPadding(cimg_library::CImg<unsigned char>& image)
@@ -132,48 +129,13 @@ namespace Utils
             if (image.spectrum() != 4)
                 return;
 
-            double pixelValueSum {0.0};
-            int rowCounterTop {0};
-            int rowCounterBottom {0};
-            unsigned int columnCounterLeft {0};
-            unsigned int columnCounterRight {0};
-
-            // Count the number of rows and columns that are completely transparent.
-            for (int i {image.height() - 1}; i > 0; --i) {
-                cimg_library::CImg<unsigned char> imageRow = image.get_rows(i, i);
-                pixelValueSum = imageRow.get_shared_channel(3).sum();
-                if (pixelValueSum == 0.0)
-                    ++rowCounterTop;
-                else
-                    break;
-            }
-
-            for (int i {0}; i < image.height(); ++i) {
-                cimg_library::CImg<unsigned char> imageRow = image.get_rows(i, i);
-                pixelValueSum = imageRow.get_shared_channel(3).sum();
-                if (pixelValueSum == 0.0)
-                    ++rowCounterBottom;
-                else
-                    break;
-            }
+            int counts[4];
+            getTransparentPaddingCoords(image, counts);
 
-            for (int i {0}; i < image.width(); ++i) {
-                cimg_library::CImg<unsigned char> imageColumn = image.get_columns(i, i);
-                pixelValueSum = imageColumn.get_shared_channel(3).sum();
-                if (pixelValueSum == 0.0)
-                    ++columnCounterLeft;
-                else
-                    break;
-            }
-
-            for (int i {image.width() - 1}; i > 0; --i) {
-                cimg_library::CImg<unsigned char> imageColumn = image.get_columns(i, i);
-                pixelValueSum = imageColumn.get_shared_channel(3).sum();
-                if (pixelValueSum == 0.0)
-                    ++columnCounterRight;
-                else
-                    break;
-            }
+            const int columnCounterLeft {counts[0]};
+            const int rowCounterTop {counts[1]};
+            const int columnCounterRight {counts[2]};
+            const int rowCounterBottom {counts[3]};
 
             if (rowCounterTop > 0)
                 image.crop(0, 0, 0, 3, image.width() - 1, image.height() - 1 - rowCounterTop, 0, 0);
@@ -191,31 +153,12 @@ namespace Utils
 
         void cropLetterboxes(cimg_library::CImg<unsigned char>& image)
         {
-            double pixelValueSum {0.0};
-            int rowCounterUpper {0};
-            int rowCounterLower {0};
-
-            // Count the number of rows that are pure black.
-            for (int i {image.height() - 1}; i > 0; --i) {
-                cimg_library::CImg<unsigned char> imageRow = image.get_rows(i, i);
-                // Ignore the alpha channel.
-                imageRow.channels(0, 2);
-                pixelValueSum = imageRow.sum();
-                if (pixelValueSum == 0.0)
-                    ++rowCounterUpper;
-                else
-                    break;
-            }
+            // Count the number of rows that are pure black, ignoring the alpha channel.
+            int counts[4];
+            countZeroEdges(image, 0, std::min(image.spectrum(), 3) - 1, counts);
 
-            for (int i {0}; i < image.height(); ++i) {
-                cimg_library::CImg<unsigned char> imageRow = image.get_rows(i, i);
-                imageRow.channels(0, 2);
-                pixelValueSum = imageRow.sum();
-                if (pixelValueSum == 0.0)
-                    ++rowCounterLower;
-                else
-                    break;
-            }
+            const int rowCounterUpper {counts[1]};
+            const int rowCounterLower {counts[3]};
 
             if (rowCounterUpper > 0)
                 image.crop(0, 0, 0, 3, image.width() - 1, image.height() - 1 - rowCounterUpper, 0,
@@ -227,31 +170,12 @@ namespace Utils
 
         void cropPillarboxes(cimg_library::CImg<unsigned char>& image)
         {
-            double pixelValueSum {0.0};
-            unsigned int columnCounterLeft {0};
-            unsigned int columnCounterRight {0};
-
-            // Count the number of columns that are pure black.
-            for (int i {0}; i < image.width(); ++i) {
-                cimg_library::CImg<unsigned char> imageColumn = image.get_columns(i, i);
-                // Ignore the alpha channel.
-                imageColumn.channels(0, 2);
-                pixelValueSum = imageColumn.sum();
-                if (pixelValueSum == 0.0)
-                    ++columnCounterLeft;
-                else
-                    break;
-            }
+            // Count the number of columns that are pure black, ignoring the alpha channel.
+            int counts[4];
+            countZeroEdges(image, 0, std::min(image.spectrum(), 3) - 1, counts);
 
-            for (int i {image.width() - 1}; i > 0; --i) {
-                cimg_library::CImg<unsigned char> imageColumn = image.get_columns(i, i);
-                imageColumn.channels(0, 2);
-                pixelValueSum = imageColumn.sum();
-                if (pixelValueSum == 0.0)
-                    ++columnCounterRight;
-                else
-                    break;
-            }
+            const int columnCounterLeft {counts[0]};
+            const int columnCounterRight {counts[2]};
 
             if (columnCounterLeft > 0)
                 image.crop(columnCounterLeft, 0, 0, 3, image.width() - 1, image.height() - 1, 0, 0);
@@ -270,35 +194,41 @@ namespace Utils
             if (image.spectrum() != 4)
                 return;
 
+            const int width {image.width()};
+            const int height {image.height()};
+
             // Make the shadow image larger than the source image to leave space for the
             // drop shadow.
             cimg_library::CImg<unsigned char> shadowImage(
-                image.width() + shadowDistance * 3, image.height() + shadowDistance * 3, 1, 4, 0);
-
-            // Create a mask image.
-            cimg_library::CImg<unsigned char> maskImage(image.width(), image.height(), 1, 4, 0);
-            maskImage.draw_image(0, 0, image);
-            // Fill the RGB channels with white so we end up with a simple mask.
-            maskImage.get_shared_channels(0, 2).fill(255);
-
-            // Make a black outline of the source image as a basis for the shadow.
-            shadowImage.draw_image(shadowDistance, shadowDistance, image);
-            shadowImage.get_shared_channels(0, 2).fill(0);
-            // Lower the transparency and apply the blur.
+                width + shadowDistance * 3, height + shadowDistance * 3, 1, 4, 0);
+
+            // The shadow is a black outline of the source image, so only the alpha channel needs
+            // to be copied as the color channels are already zero.
+            for (int y {0}; y < height; ++y)
+                std::copy_n(image.data(0, y, 0, 3), width,
+                            shadowImage.data(shadowDistance, y + shadowDistance, 0, 3));
+
+            // Lower the transparency and apply the blur. Blurring the color channels is not
+            // needed as they are all zero.
             shadowImage.get_shared_channel(3) /= transparency;
-            shadowImage.blur_box(static_cast<const float>(shadowDistance),
-                                 static_cast<const float>(shadowDistance), 1, true, iterations);
-
-            // Add the mask to the alpha channel of the shadow image.
-            shadowImage.get_shared_channel(3).draw_image(0, 0, maskImage.get_shared_channels(0, 0),
-                                                         maskImage.get_shared_channel(3), 1, 255);
-            // Draw the source image on top of the shadow image.
-            shadowImage.draw_image(0, 0, image.get_shared_channels(0, 2),
-                                   image.get_shared_channel(3), 1, 255);
+            Pixel::boxBlur(shadowImage.data(0, 0, 0, 3), shadowImage.width(),
+                           shadowImage.height(), shadowDistance, iterations);
+
+            // Draw the source image on top of the shadow image. As the shadow is black this is
+            // the same as premultiplying the color channels with the source alpha values, and
+            // the source alpha values are composited on top of the shadow alpha values.
+            for (int y {0}; y < height; ++y) {
+                const unsigned char* alpha {image.data(0, y, 0, 3)};
+                for (int channel {0}; channel < 3; ++channel)
+                    Pixel::premultiply(shadowImage.data(0, y, 0, channel),
+                                       image.data(0, y, 0, channel), alpha, width);
+                Pixel::alphaOver(shadowImage.data(0, y, 0, 3), alpha, width);
+            }
+
             // Remove the any unused space that we added to leave room for the shadow.
             removeTransparentPadding(shadowImage);
 
-            image = shadowImage;
+            image = std::move(shadowImage);
         }
 
     } // namespace CImg
@@ -23,6 +23,7 @@
 #include "utils/PlatformUtil.h"
 #include "utils/StringUtil.h"
 
+#include <chrono>
 #include <fstream>
 #include <regex>
 #include <string>
@@ -640,6 +641,40 @@ namespace Utils
             }
         }
 
+        long long getLastWriteTime(const std::string& path)
+        {
+            // The value is only meant for detecting changes, it's not converted to any clock.
+            // Returns -1 if the file doesn't exist or if its status can't be read.
+            const std::string& genericPath {getGenericPath(path)};
+            std::error_code errorCode;
+#if defined(_WIN64)
+            const std::filesystem::file_time_type writeTime {std::filesystem::last_write_time(
+                Utils::String::stringToWideString(genericPath), errorCode)};
+#else
+            const std::filesystem::file_time_type writeTime {
+                std::filesystem::last_write_time(genericPath, errorCode)};
+#endif
+            if (errorCode)
+                return -1;
+
+            return static_cast<long long>(writeTime.time_since_epoch().count());
+        }
+
+        bool isRecentlyModified(const long long writeTime)
+        {
+            // Further changes within the timestamp resolution of the filesystem wouldn't
+            // change the modification time, so such a value can't be used to detect changes.
+            const std::chrono::seconds threshold {2};
+            const long long now {static_cast<long long>(
+                std::filesystem::file_time_type::clock::now().time_since_epoch().count())};
+
+            return now - writeTime <
+                   static_cast<long long>(
+                       std::chrono::duration_cast<std::filesystem::file_time_type::duration>(
+                           threshold)
+                           .count());
+        }
+
         std::string expandHomePath(const std::string& path)
         {
             // Expand home path if ~ is used.
@@ -829,6 +864,33 @@ namespace Utils
 #endif
         }
 
+        bool replaceFile(const std::string& sourcePath, const std::string& destinationPath)
+        {
+#if defined(_WIN64)
+            const std::string backupPath {destinationPath + ".bak"};
+            const bool hasBackup {exists(destinationPath)};
+
+            if (hasBackup) {
+                removeFile(backupPath);
+                if (renameFile(destinationPath, backupPath, true))
+                    return true;
+            }
+
+            if (renameFile(sourcePath, destinationPath, true)) {
+                if (hasBackup)
+                    renameFile(backupPath, destinationPath, true);
+                return true;
+            }
+
+            if (hasBackup)
+                removeFile(backupPath);
+
+            return false;
+#else
+            return renameFile(sourcePath, destinationPath, true);
+#endif
+        }
+
         bool createEmptyFile(const std::filesystem::path& path)
         {
             const std::filesystem::path cleanPath {path.lexically_normal().make_preferred()};
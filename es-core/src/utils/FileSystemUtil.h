@@ -52,6 +52,8 @@ namespace Utils
         std::string getStem(const std::string& path);
         std::string getExtension(const std::string& path);
         long getFileSize(const std::filesystem::path& path);
+        long long getLastWriteTime(const std::string& path);
+        bool isRecentlyModified(const long long writeTime);
         std::string expandHomePath(const std::string& path);
         std::string resolveRelativePath(const std::string& path,
                                         const std::string& relativeTo,
@@ -69,6 +71,9 @@ namespace Utils
         bool renameFile(const std::string& sourcePath,
                         const std::string& destinationPath,
                         bool overwrite);
+        // Replaces destinationPath with sourcePath, returns true on failure. On Windows a rename
+        // can't overwrite an existing file, so it's moved aside first and restored on failure.
+        bool replaceFile(const std::string& sourcePath, const std::string& destinationPath);
         bool createEmptyFile(const std::filesystem::path& path);
         bool removeFile(const std::string& path);
         bool removeDirectory(const std::string& path, bool recursive);
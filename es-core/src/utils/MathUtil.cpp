@@ -7,7 +7,10 @@
 //  The GLM library headers are also included from here.
 //
 
-#define MD5_MAX_FILE_CHUNK_SIZE 32768
+// Files are memory mapped in windows of this size when hashing them, and if that's not
+// possible they are read in chunks of the smaller size instead.
+#define HASH_FILE_MAP_SIZE 67108864
+#define HASH_FILE_CHUNK_SIZE 4194304
 
 #if defined(_MSC_VER) // MSVC compiler.
 #define _CRT_SECURE_NO_WARNINGS
@@ -18,11 +21,201 @@
 #include "utils/FileSystemUtil.h"
 #include "utils/StringUtil.h"
 
+#include <array>
 #include <cstring>
 #include <fstream>
+#include <functional>
 #include <sstream>
 #include <vector>
 
+#if !defined(_WIN64)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+    using ChunkCallback = std::function<void(const unsigned char* data, size_t length)>;
+
+    bool readFileStream(const std::string& path, const ChunkCallback& callback)
+    {
+#if defined(_WIN64)
+        std::ifstream inputFile {Utils::String::stringToWideString(path).c_str(),
+                                 std::ios::binary};
+#else
+        std::ifstream inputFile {path, std::ios::binary};
+#endif
+        if (inputFile.fail())
+            return false;
+
+        std::vector<char> chunk(HASH_FILE_CHUNK_SIZE);
+        size_t bytesRead {0};
+
+        // Process in chunks so we don't need to load the whole file into memory at once.
+        while (inputFile) {
+            inputFile.read(&chunk[0], HASH_FILE_CHUNK_SIZE);
+            const size_t chunkSize {static_cast<size_t>(inputFile.gcount())};
+            if (chunkSize == 0)
+                break;
+            callback(reinterpret_cast<const unsigned char*>(&chunk[0]), chunkSize);
+            bytesRead += chunkSize;
+        }
+
+        return bytesRead > 0;
+    }
+
+    // Passes the file contents to the callback in large chunks. Where supported the file is
+    // memory mapped which avoids copying all the data through the stream buffers.
+    bool readFileChunks(const std::string& path, const ChunkCallback& callback)
+    {
+        if (Utils::FileSystem::isDirectory(path))
+            return false;
+
+#if defined(_WIN64)
+        return readFileStream(path, callback);
+#else
+        const int fileDescriptor {open(path.c_str(), O_RDONLY)};
+        if (fileDescriptor == -1)
+            return false;
+
+        struct stat fileInfo {};
+        if (fstat(fileDescriptor, &fileInfo) != 0 || fileInfo.st_size <= 0) {
+            close(fileDescriptor);
+            return false;
+        }
+
+        const size_t fileSize {static_cast<size_t>(fileInfo.st_size)};
+        size_t offset {0};
+
+        while (offset < fileSize) {
+            const size_t mapSize {std::min(static_cast<size_t>(HASH_FILE_MAP_SIZE),
+                                           fileSize - offset)};
+            void* data {mmap(nullptr, mapSize, PROT_READ, MAP_PRIVATE, fileDescriptor,
+                             static_cast<off_t>(offset))};
+
+            if (data == MAP_FAILED) {
+                close(fileDescriptor);
+                // Some filesystems such as certain network shares don't support memory
+                // mapping, so fall back to regular reads if it fails right away.
+                if (offset == 0)
+                    return readFileStream(path, callback);
+                return false;
+            }
+
+            posix_madvise(data, mapSize, POSIX_MADV_SEQUENTIAL);
+            callback(static_cast<const unsigned char*>(data), mapSize);
+            munmap(data, mapSize);
+            offset += mapSize;
+        }
+
+        close(fileDescriptor);
+        return true;
+#endif
+    }
+
+    std::string md5Final(unsigned int (&state)[4],
+                         unsigned int (&count)[2],
+                         unsigned char (&buffer)[64])
+    {
+        static unsigned char padding[64] {0x80, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+                                          0,    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+                                          0,    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+                                          0,    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+
+        // Encodes unsigned int input into unsigned char output. Assumes len is a multiple of 4.
+        auto encodeFunc = [](unsigned char output[], const unsigned int input[],
+                             unsigned int len) {
+            for (unsigned int i {0}, j {0}; j < len; ++i, j += 4) {
+                output[j] = input[i] & 0xff;
+                output[j + 1] = (input[i] >> 8) & 0xff;
+                output[j + 2] = (input[i] >> 16) & 0xff;
+                output[j + 3] = (input[i] >> 24) & 0xff;
+            }
+        };
+
+        // Save number of bits.
+        unsigned char bits[8];
+        encodeFunc(bits, count, 8);
+
+        // Pad out to 56 mod 64.
+        unsigned int index {count[0] / 8 % 64};
+        unsigned int padLen {(index < 56) ? (56 - index) : (120 - index)};
+        Utils::Math::md5Update(padding, padLen, state, count, buffer);
+
+        // Append length (before padding).
+        Utils::Math::md5Update(bits, 8, state, count, buffer);
+
+        // The result.
+        unsigned char digest[16];
+
+        // Store state in digest.
+        encodeFunc(digest, state, 16);
+
+        // Convert to hex string.
+        char buf[33];
+        for (int i {0}; i < 16; ++i)
+            snprintf(buf + i * 2, 16, "%02x", digest[i]);
+        buf[32] = 0;
+
+        return std::string(buf);
+    }
+
+    struct SHA1Context {
+        unsigned int state[5] {0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0};
+        unsigned long long length {0};
+        unsigned char buffer[64] {};
+        size_t bufferSize {0};
+    };
+
+    void sha1Update(SHA1Context& context, const unsigned char* data, size_t length)
+    {
+        context.length += length;
+
+        if (context.bufferSize > 0) {
+            const size_t fill {std::min(length, 64 - context.bufferSize)};
+            memcpy(&context.buffer[context.bufferSize], data, fill);
+            context.bufferSize += fill;
+            data += fill;
+            length -= fill;
+            if (context.bufferSize < 64)
+                return;
+            Utils::Math::sha1Transform(context.buffer, context.state);
+            context.bufferSize = 0;
+        }
+
+        for (; length >= 64; data += 64, length -= 64)
+            Utils::Math::sha1Transform(data, context.state);
+
+        memcpy(context.buffer, data, length);
+        context.bufferSize = length;
+    }
+
+    std::string sha1Final(SHA1Context& context)
+    {
+        const unsigned long long bitLength {context.length * 8};
+
+        // Append the 0x80 byte and pad with zeros to 56 mod 64, followed by the
+        // message length in bits as a big endian 64-bit value.
+        unsigned char padding[72] {0x80};
+        const size_t padLength {context.bufferSize < 56 ? 56 - context.bufferSize :
+                                                          120 - context.bufferSize};
+        for (int i {0}; i < 8; ++i)
+            padding[padLength + i] = static_cast<unsigned char>(bitLength >> (56 - i * 8));
+
+        sha1Update(context, padding, padLength + 8);
+
+        char buf[41];
+        for (int i {0}; i < 20; ++i)
+            snprintf(buf + i * 2, 3, "%02x",
+                     static_cast<unsigned char>(context.state[i / 4] >> (24 - (i % 4) * 8)));
+        buf[40] = 0;
+
+        return std::string(buf);
+    }
+} // namespace
+
 namespace Utils
 {
     namespace Math
@@ -109,40 +302,9 @@ namespace Utils
             state[3] = 0x10325476;
 
             if (isFilePath) {
-                if (Utils::FileSystem::isDirectory(hashArg))
-                    return "";
-#if defined(_WIN64)
-                std::ifstream inputFile {Utils::String::stringToWideString(hashArg).c_str(),
-                                         std::ios::binary};
-#else
-                std::ifstream inputFile {hashArg, std::ios::binary};
-#endif
-                if (inputFile.fail()) {
-                    inputFile.close();
-                    return "";
-                }
-
-                inputFile.seekg(0, std::ios::end);
-                long fileLength {static_cast<long>(inputFile.tellg())};
-                inputFile.seekg(0, std::ios::beg);
-
-                std::vector<char> chunk(MD5_MAX_FILE_CHUNK_SIZE);
-                long bytesRead {0};
-
-                // Process in chunks so we don't need to load the whole file into memory at once.
-                while (bytesRead < fileLength) {
-                    const int chunkSize {static_cast<int>(
-                        fileLength - bytesRead > MD5_MAX_FILE_CHUNK_SIZE ? MD5_MAX_FILE_CHUNK_SIZE :
-                                                                           fileLength - bytesRead)};
-                    inputFile.read(&chunk[0], chunkSize);
-                    md5Update(reinterpret_cast<const unsigned char*>(&chunk[0]), chunkSize, state,
-                              count, buffer);
-                    bytesRead += chunkSize;
-                }
-
-                inputFile.close();
-
-                if (bytesRead == 0)
+                if (!readFileChunks(hashArg, [&](const unsigned char* data, size_t length) {
+                        md5Update(data, static_cast<unsigned int>(length), state, count, buffer);
+                    }))
                     return "";
             }
             else {
@@ -150,47 +312,123 @@ namespace Utils
                           static_cast<unsigned int>(hashArg.length()), state, count, buffer);
             }
 
-            static unsigned char padding[64] {0x80, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-                                              0,    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-                                              0,    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-                                              0,    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+            return md5Final(state, count, buffer);
+        }
 
-            // Encodes unsigned int input into unsigned char output. Assumes len is a multiple of 4.
-            auto encodeFunc = [](unsigned char output[], const unsigned int input[],
-                                 unsigned int len) {
-                for (unsigned int i {0}, j {0}; j < len; ++i, j += 4) {
-                    output[j] = input[i] & 0xff;
-                    output[j + 1] = (input[i] >> 8) & 0xff;
-                    output[j + 2] = (input[i] >> 16) & 0xff;
-                    output[j + 3] = (input[i] >> 24) & 0xff;
-                }
-            };
+        FileHashes fileHashes(const std::string& path)
+        {
+            FileHashes hashes;
 
-            // Save number of bits.
-            unsigned char bits[8];
-            encodeFunc(bits, count, 8);
+            unsigned int crc {0xffffffff};
 
-            // Pad out to 56 mod 64.
-            unsigned int index {count[0] / 8 % 64};
-            unsigned int padLen {(index < 56) ? (56 - index) : (120 - index)};
-            md5Update(padding, padLen, state, count, buffer);
+            unsigned char md5Buffer[64] {};
+            unsigned int md5Count[2] {};
+            unsigned int md5State[4] {0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476};
+
+            SHA1Context sha1Context;
+
+            if (!readFileChunks(path, [&](const unsigned char* data, size_t length) {
+                    crc = crc32Update(crc, data, length);
+                    md5Update(data, static_cast<unsigned int>(length), md5State, md5Count,
+                              md5Buffer);
+                    sha1Update(sha1Context, data, length);
+                }))
+                return hashes;
+
+            char crcBuffer[9];
+            snprintf(crcBuffer, 9, "%08x", crc ^ 0xffffffff);
+            hashes.crc32 = crcBuffer;
+            hashes.md5 = md5Final(md5State, md5Count, md5Buffer);
+            hashes.sha1 = sha1Final(sha1Context);
+
+            return hashes;
+        }
 
-            // Append length (before padding).
-            md5Update(bits, 8, state, count, buffer);
+        unsigned int crc32Update(unsigned int crc, const unsigned char* buf, size_t length)
+        {
+            // Lookup tables for the reflected 0xedb88320 polynomial, which allow processing
+            // four bytes per iteration (the slicing-by-4 method).
+            static const std::array<std::array<unsigned int, 256>, 4> crcTable {[] {
+                std::array<std::array<unsigned int, 256>, 4> table {};
+                for (unsigned int i {0}; i < 256; ++i) {
+                    unsigned int value {i};
+                    for (int j {0}; j < 8; ++j)
+                        value = (value & 1) ? (value >> 1) ^ 0xedb88320 : value >> 1;
+                    table[0][i] = value;
+                }
+                for (unsigned int i {0}; i < 256; ++i) {
+                    for (int j {1}; j < 4; ++j)
+                        table[j][i] = (table[j - 1][i] >> 8) ^ table[0][table[j - 1][i] & 0xff];
+                }
+                return table;
+            }()};
+
+            for (; length >= 4; buf += 4, length -= 4) {
+                crc ^= static_cast<unsigned int>(buf[0]) |
+                       (static_cast<unsigned int>(buf[1]) << 8) |
+                       (static_cast<unsigned int>(buf[2]) << 16) |
+                       (static_cast<unsigned int>(buf[3]) << 24);
+                crc = crcTable[3][crc & 0xff] ^ crcTable[2][(crc >> 8) & 0xff] ^
+                      crcTable[1][(crc >> 16) & 0xff] ^ crcTable[0][crc >> 24];
+            }
 
-            // The result.
-            unsigned char digest[16];
+            for (; length > 0; ++buf, --length)
+                crc = (crc >> 8) ^ crcTable[0][(crc ^ *buf) & 0xff];
 
-            // Store state in digest.
-            encodeFunc(digest, state, 16);
+            return crc;
+        }
 
-            // Convert to hex string.
-            char buf[33];
+        void sha1Transform(const unsigned char block[64], unsigned int (&state)[5])
+        {
+            auto rotateLeftFunc = [](unsigned int x, int n) { return (x << n) | (x >> (32 - n)); };
+
+            unsigned int w[80];
             for (int i {0}; i < 16; ++i)
-                snprintf(buf + i * 2, 16, "%02x", digest[i]);
-            buf[32] = 0;
+                w[i] = (static_cast<unsigned int>(block[i * 4]) << 24) |
+                       (static_cast<unsigned int>(block[i * 4 + 1]) << 16) |
+                       (static_cast<unsigned int>(block[i * 4 + 2]) << 8) |
+                       (static_cast<unsigned int>(block[i * 4 + 3]));
+            for (int i {16}; i < 80; ++i)
+                w[i] = rotateLeftFunc(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+
+            unsigned int a {state[0]};
+            unsigned int b {state[1]};
+            unsigned int c {state[2]};
+            unsigned int d {state[3]};
+            unsigned int e {state[4]};
+
+            for (int i {0}; i < 80; ++i) {
+                unsigned int f;
+                unsigned int k;
+                if (i < 20) {
+                    f = (b & c) | (~b & d);
+                    k = 0x5a827999;
+                }
+                else if (i < 40) {
+                    f = b ^ c ^ d;
+                    k = 0x6ed9eba1;
+                }
+                else if (i < 60) {
+                    f = (b & c) | (b & d) | (c & d);
+                    k = 0x8f1bbcdc;
+                }
+                else {
+                    f = b ^ c ^ d;
+                    k = 0xca62c1d6;
+                }
+                const unsigned int temp {rotateLeftFunc(a, 5) + f + e + k + w[i]};
+                e = d;
+                d = c;
+                c = rotateLeftFunc(b, 30);
+                b = a;
+                a = temp;
+            }
 
-            return std::string(buf);
+            state[0] += a;
+            state[1] += b;
+            state[2] += c;
+            state[3] += d;
+            state[4] += e;
         }
 
         void md5Update(const unsigned char input[],
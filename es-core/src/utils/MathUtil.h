@@ -44,6 +44,19 @@ namespace Utils
                        unsigned char (&buffer)[64]);
         void md5Transform(const unsigned char block[64], unsigned int (&state)[4]);
 
+        struct FileHashes {
+            std::string crc32;
+            std::string md5;
+            std::string sha1;
+        };
+
+        // Calculates the CRC32, MD5 and SHA1 digests of a file while reading it only once.
+        // The digests are blank if the file is empty or could not be read.
+        FileHashes fileHashes(const std::string& path);
+        unsigned int crc32Update(unsigned int crc, const unsigned char* buf, size_t length);
+        // The SHA1 transform is based on the algorithm as described in RFC 3174.
+        void sha1Transform(const unsigned char block[64], unsigned int (&state)[5]);
+
     } // namespace Math
 
 } // namespace Utils
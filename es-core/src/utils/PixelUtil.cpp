@@ -0,0 +1,655 @@
+//  SPDX-License-Identifier: MIT
+//
+//  ES-DE
+//  PixelUtil.cpp
+//
+//  Low-level pixel processing kernels operating on raw 8-bit buffers.
+//  Uses AVX2, SSE2 or NEON if enabled at build time, otherwise scalar code.
+//
+
+#include "utils/PixelUtil.h"
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+// SSE2 is part of the x86-64 baseline, whereas AVX2 is only used if the compiler has been
+// told to target it, such as via -march=native or /arch:AVX2. NEON is only used on AArch64
+// as 32-bit ARM lacks vector division.
+#if defined(__SSE2__) || defined(_M_X64)
+#define PIXEL_UTIL_SSE2
+#include <emmintrin.h>
+#if defined(__AVX2__)
+#define PIXEL_UTIL_AVX2
+#include <immintrin.h>
+#endif
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#define PIXEL_UTIL_NEON
+#include <arm_neon.h>
+#endif
+
+namespace
+{
+    std::atomic<bool> vectorization {true};
+
+    bool useVectorization() { return vectorization.load(std::memory_order_relaxed); }
+
+#if defined(PIXEL_UTIL_SSE2)
+    template <int Shift>
+    __m128i extractChannel(const __m128i (&pixels)[4])
+    {
+        const __m128i mask {_mm_set1_epi32(0xFF)};
+        const __m128i first {
+            _mm_packs_epi32(_mm_and_si128(_mm_srli_epi32(pixels[0], Shift), mask),
+                            _mm_and_si128(_mm_srli_epi32(pixels[1], Shift), mask))};
+        const __m128i second {
+            _mm_packs_epi32(_mm_and_si128(_mm_srli_epi32(pixels[2], Shift), mask),
+                            _mm_and_si128(_mm_srli_epi32(pixels[3], Shift), mask))};
+        return _mm_packus_epi16(first, second);
+    }
+
+    // Exact division by 255 for values up to 65279.
+    __m128i divideBy255(const __m128i values)
+    {
+        return _mm_srli_epi16(
+            _mm_add_epi16(_mm_add_epi16(values, _mm_set1_epi16(1)), _mm_srli_epi16(values, 8)), 8);
+    }
+
+    // Zero-extends 16 bytes to four vectors of 32-bit integers.
+    void widenBytes(const unsigned char* data, __m128i (&values)[4])
+    {
+        const __m128i zero {_mm_setzero_si128()};
+        const __m128i bytes {_mm_loadu_si128(reinterpret_cast<const __m128i*>(data))};
+        const __m128i low {_mm_unpacklo_epi8(bytes, zero)};
+        const __m128i high {_mm_unpackhi_epi8(bytes, zero)};
+        values[0] = _mm_unpacklo_epi16(low, zero);
+        values[1] = _mm_unpackhi_epi16(low, zero);
+        values[2] = _mm_unpacklo_epi16(high, zero);
+        values[3] = _mm_unpackhi_epi16(high, zero);
+    }
+#endif
+
+#if defined(PIXEL_UTIL_AVX2)
+    template <int Shift>
+    __m256i extractChannel(const __m256i (&pixels)[4])
+    {
+        const __m256i mask {_mm256_set1_epi32(0xFF)};
+        const __m256i first {
+            _mm256_packs_epi32(_mm256_and_si256(_mm256_srli_epi32(pixels[0], Shift), mask),
+                               _mm256_and_si256(_mm256_srli_epi32(pixels[1], Shift), mask))};
+        const __m256i second {
+            _mm256_packs_epi32(_mm256_and_si256(_mm256_srli_epi32(pixels[2], Shift), mask),
+                               _mm256_and_si256(_mm256_srli_epi32(pixels[3], Shift), mask))};
+        // The pack instructions operate on each 128-bit lane separately, so the groups of
+        // four pixels need to be put back in order.
+        return _mm256_permutevar8x32_epi32(_mm256_packus_epi16(first, second),
+                                           _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7));
+    }
+
+    __m256i divideBy255(const __m256i values)
+    {
+        return _mm256_srli_epi16(_mm256_add_epi16(_mm256_add_epi16(values, _mm256_set1_epi16(1)),
+                                                  _mm256_srli_epi16(values, 8)),
+                                 8);
+    }
+#endif
+
+#if defined(PIXEL_UTIL_NEON)
+    uint16x8_t divideBy255(const uint16x8_t values)
+    {
+        return vshrq_n_u16(vaddq_u16(vaddq_u16(values, vdupq_n_u16(1)), vshrq_n_u16(values, 8)),
+                           8);
+    }
+
+    void widenBytes(const unsigned char* data, uint32x4_t (&values)[4])
+    {
+        const uint8x16_t bytes {vld1q_u8(data)};
+        const uint16x8_t low {vmovl_u8(vget_low_u8(bytes))};
+        const uint16x8_t high {vmovl_u8(vget_high_u8(bytes))};
+        values[0] = vmovl_u16(vget_low_u16(low));
+        values[1] = vmovl_u16(vget_high_u16(low));
+        values[2] = vmovl_u16(vget_low_u16(high));
+        values[3] = vmovl_u16(vget_high_u16(high));
+    }
+#endif
+
+    // Applies the box filter along the columns of the image. This is the same algorithm as
+    // CImg::_cimg_blur_box_apply() with Neumann boundary conditions, i.e. every output value
+    // is the floored average of the window of input values around it, where an even box size
+    // gives half weight to the two outermost values.
+    void boxFilterColumns(unsigned char* plane,
+                          const int width,
+                          const int height,
+                          const unsigned int boxSize,
+                          const unsigned int iterations)
+    {
+        const int halfWindow {static_cast<int>(boxSize - 1) / 2};
+        const bool evenSize {boxSize % 2 == 0};
+        const unsigned int divisor {boxSize * 2};
+
+        // Single precision division is only exact up to a certain box size.
+        const bool vectorize {useVectorization() && boxSize <= 1024};
+
+        std::vector<unsigned char> source(plane, plane + static_cast<size_t>(width) * height);
+        std::vector<unsigned int> sums(width);
+
+        auto row = [&](int y) {
+            return source.data() + static_cast<size_t>(std::clamp(y, 0, height - 1)) * width;
+        };
+
+        for (unsigned int iteration {0}; iteration < iterations; ++iteration) {
+            if (iteration > 0)
+                std::copy(plane, plane + source.size(), source.begin());
+
+            std::fill(sums.begin(), sums.end(), 0);
+            for (int y {-halfWindow}; y <= halfWindow; ++y) {
+                const unsigned char* sourceRow {row(y)};
+                for (int x {0}; x < width; ++x)
+                    sums[x] += sourceRow[x];
+            }
+
+            for (int y {0}; y < height; ++y) {
+                // The window moves one step down, except for the first row.
+                const unsigned char* addRow {y > 0 ? row(y + halfWindow) : nullptr};
+                const unsigned char* prevRow {row(y - halfWindow - 1)};
+                const unsigned char* nextRow {row(y + halfWindow + 1)};
+                unsigned char* outputRow {plane + static_cast<size_t>(y) * width};
+                int x {0};
+
+                if (vectorize) {
+#if defined(PIXEL_UTIL_SSE2)
+                    const __m128 divisorVector {_mm_set1_ps(static_cast<float>(divisor))};
+                    for (; x + 16 <= width; x += 16) {
+                        __m128i prev[4];
+                        __m128i next[4];
+                        __m128i results[4];
+                        widenBytes(prevRow + x, prev);
+                        widenBytes(nextRow + x, next);
+                        __m128i add[4];
+                        if (addRow != nullptr)
+                            widenBytes(addRow + x, add);
+                        for (int i {0}; i < 4; ++i) {
+                            __m128i* sumPtr {reinterpret_cast<__m128i*>(sums.data() + x + i * 4)};
+                            __m128i sum {_mm_loadu_si128(sumPtr)};
+                            if (addRow != nullptr) {
+                                // The row leaving the window is the same as prevRow.
+                                sum = _mm_sub_epi32(_mm_add_epi32(sum, add[i]), prev[i]);
+                                _mm_storeu_si128(sumPtr, sum);
+                            }
+                            __m128i value {_mm_slli_epi32(sum, 1)};
+                            if (evenSize)
+                                value = _mm_add_epi32(value, _mm_add_epi32(prev[i], next[i]));
+                            results[i] = _mm_cvttps_epi32(
+                                _mm_div_ps(_mm_cvtepi32_ps(value), divisorVector));
+                        }
+                        _mm_storeu_si128(
+                            reinterpret_cast<__m128i*>(outputRow + x),
+                            _mm_packus_epi16(_mm_packs_epi32(results[0], results[1]),
+                                             _mm_packs_epi32(results[2], results[3])));
+                    }
+#elif defined(PIXEL_UTIL_NEON)
+                    const float32x4_t divisorVector {vdupq_n_f32(static_cast<float>(divisor))};
+                    for (; x + 16 <= width; x += 16) {
+                        uint32x4_t prev[4];
+                        uint32x4_t next[4];
+                        uint32x4_t add[4];
+                        uint32x4_t results[4];
+                        widenBytes(prevRow + x, prev);
+                        widenBytes(nextRow + x, next);
+                        if (addRow != nullptr)
+                            widenBytes(addRow + x, add);
+                        for (int i {0}; i < 4; ++i) {
+                            unsigned int* sumPtr {sums.data() + x + i * 4};
+                            uint32x4_t sum {vld1q_u32(sumPtr)};
+                            if (addRow != nullptr) {
+                                sum = vsubq_u32(vaddq_u32(sum, add[i]), prev[i]);
+                                vst1q_u32(sumPtr, sum);
+                            }
+                            uint32x4_t value {vshlq_n_u32(sum, 1)};
+                            if (evenSize)
+                                value = vaddq_u32(value, vaddq_u32(prev[i], next[i]));
+                            results[i] =
+                                vcvtq_u32_f32(vdivq_f32(vcvtq_f32_u32(value), divisorVector));
+                        }
+                        const uint16x8_t low {
+                            vcombine_u16(vmovn_u32(results[0]), vmovn_u32(results[1]))};
+                        const uint16x8_t high {
+                            vcombine_u16(vmovn_u32(results[2]), vmovn_u32(results[3]))};
+                        vst1q_u8(outputRow + x, vcombine_u8(vmovn_u16(low), vmovn_u16(high)));
+                    }
+#endif
+                }
+
+                for (; x < width; ++x) {
+                    if (addRow != nullptr)
+                        sums[x] = sums[x] + addRow[x] - prevRow[x];
+                    unsigned int value {sums[x] * 2};
+                    if (evenSize)
+                        value += prevRow[x] + nextRow[x];
+                    outputRow[x] = static_cast<unsigned char>(value / divisor);
+                }
+            }
+        }
+    }
+
+    void transpose(const unsigned char* source,
+                   unsigned char* destination,
+                   const int width,
+                   const int height)
+    {
+        // Work on small blocks to stay within the cache.
+        constexpr int blockSize {32};
+        for (int blockY {0}; blockY < height; blockY += blockSize) {
+            for (int blockX {0}; blockX < width; blockX += blockSize) {
+                const int endY {std::min(blockY + blockSize, height)};
+                const int endX {std::min(blockX + blockSize, width)};
+                for (int y {blockY}; y < endY; ++y) {
+                    for (int x {blockX}; x < endX; ++x)
+                        destination[static_cast<size_t>(x) * height + y] =
+                            source[static_cast<size_t>(y) * width + x];
+                }
+            }
+        }
+    }
+} // namespace
+
+namespace Utils
+{
+    namespace Pixel
+    {
+        const char* getInstructionSet()
+        {
+#if defined(PIXEL_UTIL_AVX2)
+            return "AVX2";
+#elif defined(PIXEL_UTIL_SSE2)
+            return "SSE2";
+#elif defined(PIXEL_UTIL_NEON)
+            return "NEON";
+#else
+            return "scalar";
+#endif
+        }
+
+        void setVectorization(bool state) { vectorization = state; }
+
+        void deinterleave(const unsigned char* source,
+                          unsigned char* const (&planes)[4],
+                          size_t numPixels)
+        {
+            size_t i {0};
+
+            if (useVectorization()) {
+#if defined(PIXEL_UTIL_AVX2)
+                for (; i + 32 <= numPixels; i += 32) {
+                    const __m256i* sourcePtr {reinterpret_cast<const __m256i*>(source + i * 4)};
+                    const __m256i pixels[4] {
+                        _mm256_loadu_si256(sourcePtr), _mm256_loadu_si256(sourcePtr + 1),
+                        _mm256_loadu_si256(sourcePtr + 2), _mm256_loadu_si256(sourcePtr + 3)};
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(planes[0] + i),
+                                        extractChannel<0>(pixels));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(planes[1] + i),
+                                        extractChannel<8>(pixels));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(planes[2] + i),
+                                        extractChannel<16>(pixels));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(planes[3] + i),
+                                        extractChannel<24>(pixels));
+                }
+#endif
+#if defined(PIXEL_UTIL_SSE2)
+                for (; i + 16 <= numPixels; i += 16) {
+                    const __m128i* sourcePtr {reinterpret_cast<const __m128i*>(source + i * 4)};
+                    const __m128i pixels[4] {
+                        _mm_loadu_si128(sourcePtr), _mm_loadu_si128(sourcePtr + 1),
+                        _mm_loadu_si128(sourcePtr + 2), _mm_loadu_si128(sourcePtr + 3)};
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(planes[0] + i),
+                                     extractChannel<0>(pixels));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(planes[1] + i),
+                                     extractChannel<8>(pixels));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(planes[2] + i),
+                                     extractChannel<16>(pixels));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(planes[3] + i),
+                                     extractChannel<24>(pixels));
+                }
+#elif defined(PIXEL_UTIL_NEON)
+                for (; i + 16 <= numPixels; i += 16) {
+                    const uint8x16x4_t pixels {vld4q_u8(source + i * 4)};
+                    vst1q_u8(planes[0] + i, pixels.val[0]);
+                    vst1q_u8(planes[1] + i, pixels.val[1]);
+                    vst1q_u8(planes[2] + i, pixels.val[2]);
+                    vst1q_u8(planes[3] + i, pixels.val[3]);
+                }
+#endif
+            }
+
+            for (; i < numPixels; ++i) {
+                planes[0][i] = source[i * 4 + 0];
+                planes[1][i] = source[i * 4 + 1];
+                planes[2][i] = source[i * 4 + 2];
+                planes[3][i] = source[i * 4 + 3];
+            }
+        }
+
+        void interleave(const unsigned char* const (&planes)[4],
+                        unsigned char* destination,
+                        size_t numPixels)
+        {
+            size_t i {0};
+
+            if (useVectorization()) {
+#if defined(PIXEL_UTIL_AVX2)
+                for (; i + 32 <= numPixels; i += 32) {
+                    const __m256i c0 {
+                        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(planes[0] + i))};
+                    const __m256i c1 {
+                        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(planes[1] + i))};
+                    const __m256i c2 {
+                        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(planes[2] + i))};
+                    const __m256i c3 {
+                        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(planes[3] + i))};
+                    const __m256i low01 {_mm256_unpacklo_epi8(c0, c1)};
+                    const __m256i high01 {_mm256_unpackhi_epi8(c0, c1)};
+                    const __m256i low23 {_mm256_unpacklo_epi8(c2, c3)};
+                    const __m256i high23 {_mm256_unpackhi_epi8(c2, c3)};
+                    // Each of these hold four pixels from both the lower and upper half.
+                    const __m256i pixels0 {_mm256_unpacklo_epi16(low01, low23)};
+                    const __m256i pixels1 {_mm256_unpackhi_epi16(low01, low23)};
+                    const __m256i pixels2 {_mm256_unpacklo_epi16(high01, high23)};
+                    const __m256i pixels3 {_mm256_unpackhi_epi16(high01, high23)};
+                    __m256i* destinationPtr {reinterpret_cast<__m256i*>(destination + i * 4)};
+                    _mm256_storeu_si256(destinationPtr,
+                                        _mm256_permute2x128_si256(pixels0, pixels1, 0x20));
+                    _mm256_storeu_si256(destinationPtr + 1,
+                                        _mm256_permute2x128_si256(pixels2, pixels3, 0x20));
+                    _mm256_storeu_si256(destinationPtr + 2,
+                                        _mm256_permute2x128_si256(pixels0, pixels1, 0x31));
+                    _mm256_storeu_si256(destinationPtr + 3,
+                                        _mm256_permute2x128_si256(pixels2, pixels3, 0x31));
+                }
+#endif
+#if defined(PIXEL_UTIL_SSE2)
+                for (; i + 16 <= numPixels; i += 16) {
+                    const __m128i c0 {
+                        _mm_loadu_si128(reinterpret_cast<const __m128i*>(planes[0] + i))};
+                    const __m128i c1 {
+                        _mm_loadu_si128(reinterpret_cast<const __m128i*>(planes[1] + i))};
+                    const __m128i c2 {
+                        _mm_loadu_si128(reinterpret_cast<const __m128i*>(planes[2] + i))};
+                    const __m128i c3 {
+                        _mm_loadu_si128(reinterpret_cast<const __m128i*>(planes[3] + i))};
+                    const __m128i low01 {_mm_unpacklo_epi8(c0, c1)};
+                    const __m128i high01 {_mm_unpackhi_epi8(c0, c1)};
+                    const __m128i low23 {_mm_unpacklo_epi8(c2, c3)};
+                    const __m128i high23 {_mm_unpackhi_epi8(c2, c3)};
+                    __m128i* destinationPtr {reinterpret_cast<__m128i*>(destination + i * 4)};
+                    _mm_storeu_si128(destinationPtr, _mm_unpacklo_epi16(low01, low23));
+                    _mm_storeu_si128(destinationPtr + 1, _mm_unpackhi_epi16(low01, low23));
+                    _mm_storeu_si128(destinationPtr + 2, _mm_unpacklo_epi16(high01, high23));
+                    _mm_storeu_si128(destinationPtr + 3, _mm_unpackhi_epi16(high01, high23));
+                }
+#elif defined(PIXEL_UTIL_NEON)
+                for (; i + 16 <= numPixels; i += 16) {
+                    const uint8x16x4_t pixels {{vld1q_u8(planes[0] + i), vld1q_u8(planes[1] + i),
+                                                vld1q_u8(planes[2] + i), vld1q_u8(planes[3] + i)}};
+                    vst4q_u8(destination + i * 4, pixels);
+                }
+#endif
+            }
+
+            for (; i < numPixels; ++i) {
+                destination[i * 4 + 0] = planes[0][i];
+                destination[i * 4 + 1] = planes[1][i];
+                destination[i * 4 + 2] = planes[2][i];
+                destination[i * 4 + 3] = planes[3][i];
+            }
+        }
+
+        bool isZero(const unsigned char* data, size_t length)
+        {
+            size_t i {0};
+
+            if (useVectorization()) {
+#if defined(PIXEL_UTIL_AVX2)
+                for (; i + 32 <= length; i += 32) {
+                    const __m256i values {
+                        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i))};
+                    if (!_mm256_testz_si256(values, values))
+                        return false;
+                }
+#endif
+#if defined(PIXEL_UTIL_SSE2)
+                for (; i + 16 <= length; i += 16) {
+                    const __m128i values {
+                        _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i))};
+                    if (_mm_movemask_epi8(_mm_cmpeq_epi8(values, _mm_setzero_si128())) != 0xFFFF)
+                        return false;
+                }
+#elif defined(PIXEL_UTIL_NEON)
+                for (; i + 16 <= length; i += 16) {
+                    if (vmaxvq_u8(vld1q_u8(data + i)) != 0)
+                        return false;
+                }
+#endif
+            }
+
+            for (; i < length; ++i) {
+                if (data[i] != 0)
+                    return false;
+            }
+
+            return true;
+        }
+
+        void orBytes(unsigned char* destination, const unsigned char* source, size_t length)
+        {
+            size_t i {0};
+
+            if (useVectorization()) {
+#if defined(PIXEL_UTIL_AVX2)
+                for (; i + 32 <= length; i += 32) {
+                    __m256i* destinationPtr {reinterpret_cast<__m256i*>(destination + i)};
+                    _mm256_storeu_si256(
+                        destinationPtr,
+                        _mm256_or_si256(
+                            _mm256_loadu_si256(destinationPtr),
+                            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i))));
+                }
+#endif
+#if defined(PIXEL_UTIL_SSE2)
+                for (; i + 16 <= length; i += 16) {
+                    __m128i* destinationPtr {reinterpret_cast<__m128i*>(destination + i)};
+                    const __m128i values {
+                        _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i))};
+                    _mm_storeu_si128(destinationPtr,
+                                     _mm_or_si128(_mm_loadu_si128(destinationPtr), values));
+                }
+#elif defined(PIXEL_UTIL_NEON)
+                for (; i + 16 <= length; i += 16)
+                    vst1q_u8(destination + i,
+                             vorrq_u8(vld1q_u8(destination + i), vld1q_u8(source + i)));
+#endif
+            }
+
+            for (; i < length; ++i)
+                destination[i] |= source[i];
+        }
+
+        void swapBytes(unsigned char* first, unsigned char* second, size_t length)
+        {
+            size_t i {0};
+
+            if (useVectorization()) {
+#if defined(PIXEL_UTIL_AVX2)
+                for (; i + 32 <= length; i += 32) {
+                    __m256i* firstPtr {reinterpret_cast<__m256i*>(first + i)};
+                    __m256i* secondPtr {reinterpret_cast<__m256i*>(second + i)};
+                    const __m256i temp {_mm256_loadu_si256(firstPtr)};
+                    _mm256_storeu_si256(firstPtr, _mm256_loadu_si256(secondPtr));
+                    _mm256_storeu_si256(secondPtr, temp);
+                }
+#endif
+#if defined(PIXEL_UTIL_SSE2)
+                for (; i + 16 <= length; i += 16) {
+                    __m128i* firstPtr {reinterpret_cast<__m128i*>(first + i)};
+                    __m128i* secondPtr {reinterpret_cast<__m128i*>(second + i)};
+                    const __m128i temp {_mm_loadu_si128(firstPtr)};
+                    _mm_storeu_si128(firstPtr, _mm_loadu_si128(secondPtr));
+                    _mm_storeu_si128(secondPtr, temp);
+                }
+#elif defined(PIXEL_UTIL_NEON)
+                for (; i + 16 <= length; i += 16) {
+                    const uint8x16_t temp {vld1q_u8(first + i)};
+                    vst1q_u8(first + i, vld1q_u8(second + i));
+                    vst1q_u8(second + i, temp);
+                }
+#endif
+            }
+
+            for (; i < length; ++i)
+                std::swap(first[i], second[i]);
+        }
+
+        void premultiply(unsigned char* destination,
+                         const unsigned char* source,
+                         const unsigned char* alpha,
+                         size_t length)
+        {
+            size_t i {0};
+
+            if (useVectorization()) {
+#if defined(PIXEL_UTIL_AVX2)
+                const __m256i zero256 {_mm256_setzero_si256()};
+                for (; i + 32 <= length; i += 32) {
+                    const __m256i values {
+                        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i))};
+                    const __m256i alphas {
+                        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(alpha + i))};
+                    const __m256i low {
+                        divideBy255(_mm256_mullo_epi16(_mm256_unpacklo_epi8(values, zero256),
+                                                       _mm256_unpacklo_epi8(alphas, zero256)))};
+                    const __m256i high {
+                        divideBy255(_mm256_mullo_epi16(_mm256_unpackhi_epi8(values, zero256),
+                                                       _mm256_unpackhi_epi8(alphas, zero256)))};
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i),
+                                        _mm256_packus_epi16(low, high));
+                }
+#endif
+#if defined(PIXEL_UTIL_SSE2)
+                const __m128i zero {_mm_setzero_si128()};
+                for (; i + 16 <= length; i += 16) {
+                    const __m128i values {
+                        _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i))};
+                    const __m128i alphas {
+                        _mm_loadu_si128(reinterpret_cast<const __m128i*>(alpha + i))};
+                    const __m128i low {divideBy255(_mm_mullo_epi16(
+                        _mm_unpacklo_epi8(values, zero), _mm_unpacklo_epi8(alphas, zero)))};
+                    const __m128i high {divideBy255(_mm_mullo_epi16(
+                        _mm_unpackhi_epi8(values, zero), _mm_unpackhi_epi8(alphas, zero)))};
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i),
+                                     _mm_packus_epi16(low, high));
+                }
+#elif defined(PIXEL_UTIL_NEON)
+                for (; i + 16 <= length; i += 16) {
+                    const uint8x16_t values {vld1q_u8(source + i)};
+                    const uint8x16_t alphas {vld1q_u8(alpha + i)};
+                    const uint16x8_t low {
+                        divideBy255(vmull_u8(vget_low_u8(values), vget_low_u8(alphas)))};
+                    const uint16x8_t high {
+                        divideBy255(vmull_u8(vget_high_u8(values), vget_high_u8(alphas)))};
+                    vst1q_u8(destination + i, vcombine_u8(vmovn_u16(low), vmovn_u16(high)));
+                }
+#endif
+            }
+
+            for (; i < length; ++i)
+                destination[i] = static_cast<unsigned char>(source[i] * alpha[i] / 255);
+        }
+
+        void alphaOver(unsigned char* destination, const unsigned char* alpha, size_t length)
+        {
+            size_t i {0};
+
+            if (useVectorization()) {
+#if defined(PIXEL_UTIL_AVX2)
+                const __m256i zero256 {_mm256_setzero_si256()};
+                const __m256i max256 {_mm256_set1_epi16(255)};
+                for (; i + 32 <= length; i += 32) {
+                    __m256i* destinationPtr {reinterpret_cast<__m256i*>(destination + i)};
+                    const __m256i values {_mm256_loadu_si256(destinationPtr)};
+                    const __m256i alphas {
+                        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(alpha + i))};
+                    const __m256i alphasLow {_mm256_unpacklo_epi8(alphas, zero256)};
+                    const __m256i alphasHigh {_mm256_unpackhi_epi8(alphas, zero256)};
+                    const __m256i low {_mm256_add_epi16(
+                        alphasLow, divideBy255(_mm256_mullo_epi16(
+                                       _mm256_unpacklo_epi8(values, zero256),
+                                       _mm256_sub_epi16(max256, alphasLow))))};
+                    const __m256i high {_mm256_add_epi16(
+                        alphasHigh, divideBy255(_mm256_mullo_epi16(
+                                        _mm256_unpackhi_epi8(values, zero256),
+                                        _mm256_sub_epi16(max256, alphasHigh))))};
+                    _mm256_storeu_si256(destinationPtr, _mm256_packus_epi16(low, high));
+                }
+#endif
+#if defined(PIXEL_UTIL_SSE2)
+                const __m128i zero {_mm_setzero_si128()};
+                const __m128i max {_mm_set1_epi16(255)};
+                for (; i + 16 <= length; i += 16) {
+                    __m128i* destinationPtr {reinterpret_cast<__m128i*>(destination + i)};
+                    const __m128i values {_mm_loadu_si128(destinationPtr)};
+                    const __m128i alphas {
+                        _mm_loadu_si128(reinterpret_cast<const __m128i*>(alpha + i))};
+                    const __m128i alphasLow {_mm_unpacklo_epi8(alphas, zero)};
+                    const __m128i alphasHigh {_mm_unpackhi_epi8(alphas, zero)};
+                    const __m128i low {_mm_add_epi16(
+                        alphasLow, divideBy255(_mm_mullo_epi16(_mm_unpacklo_epi8(values, zero),
+                                                               _mm_sub_epi16(max, alphasLow))))};
+                    const __m128i high {_mm_add_epi16(
+                        alphasHigh, divideBy255(_mm_mullo_epi16(_mm_unpackhi_epi8(values, zero),
+                                                                _mm_sub_epi16(max, alphasHigh))))};
+                    _mm_storeu_si128(destinationPtr, _mm_packus_epi16(low, high));
+                }
+#elif defined(PIXEL_UTIL_NEON)
+                for (; i + 16 <= length; i += 16) {
+                    const uint8x16_t values {vld1q_u8(destination + i)};
+                    const uint8x16_t alphas {vld1q_u8(alpha + i)};
+                    const uint8x16_t inverse {vmvnq_u8(alphas)};
+                    const uint16x8_t low {
+                        divideBy255(vmull_u8(vget_low_u8(values), vget_low_u8(inverse)))};
+                    const uint16x8_t high {
+                        divideBy255(vmull_u8(vget_high_u8(values), vget_high_u8(inverse)))};
+                    vst1q_u8(destination + i,
+                             vaddq_u8(alphas, vcombine_u8(vmovn_u16(low), vmovn_u16(high))));
+                }
+#endif
+            }
+
+            for (; i < length; ++i)
+                destination[i] = static_cast<unsigned char>(
+                    alpha[i] + destination[i] * (255 - alpha[i]) / 255);
+        }
+
+        void boxBlur(unsigned char* plane,
+                     int width,
+                     int height,
+                     unsigned int boxSize,
+                     unsigned int iterations)
+        {
+            if (width <= 0 || height <= 0 || boxSize <= 1 || iterations == 0)
+                return;
+
+            // The horizontal pass is done on a transposed copy so that the same column kernel
+            // can be used for both directions.
+            if (width > 1) {
+                std::vector<unsigned char> transposed(static_cast<size_t>(width) * height);
+                transpose(plane, transposed.data(), width, height);
+                boxFilterColumns(transposed.data(), height, width, boxSize, iterations);
+                transpose(transposed.data(), plane, height, width);
+            }
+
+            if (height > 1)
+                boxFilterColumns(plane, width, height, boxSize, iterations);
+        }
+
+    } // namespace Pixel
+
+} // namespace Utils
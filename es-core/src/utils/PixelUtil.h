@@ -0,0 +1,62 @@
+//  SPDX-License-Identifier: MIT
+//
+//  ES-DE
+//  PixelUtil.h
+//
+//  Low-level pixel processing kernels operating on raw 8-bit buffers.
+//  Uses AVX2, SSE2 or NEON if enabled at build time, otherwise scalar code.
+//
+
+#ifndef ES_CORE_UTILS_PIXEL_UTIL_H
+#define ES_CORE_UTILS_PIXEL_UTIL_H
+
+#include <cstddef>
+
+namespace Utils
+{
+    namespace Pixel
+    {
+        // Returns "AVX2", "SSE2", "NEON" or "scalar".
+        const char* getInstructionSet();
+        // Setting this to false forces the scalar code paths, which is used by the benchmark
+        // to compare the kernels. The output is identical regardless of this setting.
+        void setVectorization(bool state);
+
+        // Splits interleaved four-channel pixels into separate planes, channel N of the
+        // source is written to planes[N].
+        void deinterleave(const unsigned char* source,
+                          unsigned char* const (&planes)[4],
+                          size_t numPixels);
+        // Combines four planes into interleaved pixels, the reverse of deinterleave().
+        void interleave(const unsigned char* const (&planes)[4],
+                        unsigned char* destination,
+                        size_t numPixels);
+
+        bool isZero(const unsigned char* data, size_t length);
+        // Bitwise OR of source into destination.
+        void orBytes(unsigned char* destination, const unsigned char* source, size_t length);
+        // Exchanges the contents of two non-overlapping buffers.
+        void swapBytes(unsigned char* first, unsigned char* second, size_t length);
+
+        // destination = source * alpha / 255, rounded down.
+        void premultiply(unsigned char* destination,
+                         const unsigned char* source,
+                         const unsigned char* alpha,
+                         size_t length);
+        // Composites alpha on top of the destination alpha values, i.e. the result is
+        // alpha + destination * (255 - alpha) / 255, rounded down.
+        void alphaOver(unsigned char* destination, const unsigned char* alpha, size_t length);
+
+        // Box blur of a single channel image with clamped edges. This gives identical results
+        // to CImg::blur_box() with Neumann boundary conditions for integer box sizes.
+        void boxBlur(unsigned char* plane,
+                     int width,
+                     int height,
+                     unsigned int boxSize,
+                     unsigned int iterations);
+
+    } // namespace Pixel
+
+} // namespace Utils
+
+#endif // ES_CORE_UTILS_PIXEL_UTIL_H
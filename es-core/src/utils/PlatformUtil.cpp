@@ -238,7 +238,7 @@ namespace Utils
                 SDL_GetWindowSize(Renderer::getInstance()->getSDLWindow(), &width, &height);
                 SDL_SetWindowSize(Renderer::getInstance()->getSDLWindow(), width + 1, height);
                 SDL_Delay(100);
-                glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+                Renderer::getInstance()->clearScreen();
                 Renderer::getInstance()->swapBuffers();
                 SDL_Event event {};
 
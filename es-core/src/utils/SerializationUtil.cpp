@@ -0,0 +1,109 @@
+//  SPDX-License-Identifier: MIT
+//
+//  ES-DE
+//  SerializationUtil.cpp
+//
+//  Functions for the binary cache files.
+//  Read and write values and strings, check the file header and replace
+//  cache files without risking partially written files.
+//
+
+#include "utils/SerializationUtil.h"
+
+#include "utils/FileSystemUtil.h"
+#include "utils/StringUtil.h"
+
+#include <fstream>
+
+namespace Utils
+{
+    namespace Serialization
+    {
+        void writeString(std::string& buffer, const std::string& value)
+        {
+            writeValue<unsigned int>(buffer, static_cast<unsigned int>(value.size()));
+            buffer.append(value);
+        }
+
+        bool readString(const std::string& buffer, size_t& offset, std::string& value)
+        {
+            unsigned int size {0};
+            if (!readValue<unsigned int>(buffer, offset, size) || offset + size > buffer.size())
+                return false;
+            value.assign(buffer, offset, size);
+            offset += size;
+            return true;
+        }
+
+        void writeHeader(std::string& buffer, const char (&magic)[4], const unsigned int version)
+        {
+            buffer.append(magic, sizeof(magic));
+            writeValue<unsigned int>(buffer, version);
+        }
+
+        bool readHeader(const std::string& buffer,
+                        size_t& offset,
+                        const char (&magic)[4],
+                        const unsigned int version)
+        {
+            if (offset + sizeof(magic) > buffer.size() ||
+                std::memcmp(&buffer[offset], magic, sizeof(magic)) != 0)
+                return false;
+
+            offset += sizeof(magic);
+
+            unsigned int fileVersion {0};
+            return readValue<unsigned int>(buffer, offset, fileVersion) && fileVersion == version;
+        }
+
+        bool readFile(const std::string& path, std::string& buffer)
+        {
+            if (!Utils::FileSystem::exists(path))
+                return false;
+
+#if defined(_WIN64)
+            std::ifstream stream {Utils::String::stringToWideString(path).c_str(),
+                                  std::ios::binary};
+#else
+            std::ifstream stream {path, std::ios::binary};
+#endif
+            if (stream.fail())
+                return false;
+
+            buffer.assign(std::istreambuf_iterator<char>(stream),
+                          std::istreambuf_iterator<char>());
+            return !stream.bad();
+        }
+
+        bool writeFile(const std::string& path, const std::string& buffer)
+        {
+            const std::string directory {Utils::FileSystem::getParent(path)};
+            if (!Utils::FileSystem::isDirectory(directory) &&
+                !Utils::FileSystem::createDirectory(directory))
+                return false;
+
+            const std::string tempFile {path + ".tmp"};
+
+#if defined(_WIN64)
+            std::ofstream stream {Utils::String::stringToWideString(tempFile).c_str(),
+                                  std::ios::binary | std::ios::trunc};
+#else
+            std::ofstream stream {tempFile, std::ios::binary | std::ios::trunc};
+#endif
+            if (stream.fail())
+                return false;
+
+            stream.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            stream.close();
+
+            if (stream.fail() || Utils::FileSystem::replaceFile(tempFile, path)) {
+                Utils::FileSystem::removeFile(tempFile);
+                return false;
+            }
+
+            return true;
+        }
+
+    } // namespace Serialization
+
+} // namespace Utils
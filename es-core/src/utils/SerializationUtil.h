@@ -0,0 +1,57 @@
+//  SPDX-License-Identifier: MIT
+//
+//  ES-DE
+//  SerializationUtil.h
+//
+//  Functions for the binary cache files.
+//  Read and write values and strings, check the file header and replace
+//  cache files without risking partially written files.
+//
+
+#ifndef ES_CORE_UTILS_SERIALIZATION_UTIL_H
+#define ES_CORE_UTILS_SERIALIZATION_UTIL_H
+
+#include <cstring>
+#include <string>
+
+namespace Utils
+{
+    namespace Serialization
+    {
+        // The values are stored in the native byte order as the cache files are not
+        // meant to be moved between devices.
+        template <typename T> void writeValue(std::string& buffer, const T value)
+        {
+            buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+
+        template <typename T> bool readValue(const std::string& buffer, size_t& offset, T& value)
+        {
+            if (offset + sizeof(T) > buffer.size())
+                return false;
+            std::memcpy(&value, &buffer[offset], sizeof(T));
+            offset += sizeof(T);
+            return true;
+        }
+
+        void writeString(std::string& buffer, const std::string& value);
+        bool readString(const std::string& buffer, size_t& offset, std::string& value);
+
+        // The header consists of the four character magic and the file format version. Increase
+        // the version if the file format is changed, older files will then be discarded.
+        void writeHeader(std::string& buffer, const char (&magic)[4], const unsigned int version);
+        bool readHeader(const std::string& buffer,
+                        size_t& offset,
+                        const char (&magic)[4],
+                        const unsigned int version);
+
+        bool readFile(const std::string& path, std::string& buffer);
+        // Writes to a temporary file which then replaces the file, so an interrupted
+        // write can't leave a partial file. The directory is created if needed.
+        bool writeFile(const std::string& path, const std::string& buffer);
+
+    } // namespace Serialization
+
+} // namespace Utils
+
+#endif // ES_CORE_UTILS_SERIALIZATION_UTIL_H
@@ -9,21 +9,56 @@
 // Vertex section of code:
 #if defined(VERTEX)
 
-uniform mat4 MVPMatrix;
+// The vertices are batched across draw calls so the position is transformed on the CPU and
+// the per-draw parameters are looked up using the draw index instead of set as uniforms.
+in vec4 clipPositionVertex;
 in vec2 positionVertex;
 in vec2 texCoordVertex;
 in vec4 colorVertex;
+in uint drawIndexVertex;
+
+// This must match RendererOpenGL::BatchDraw and Renderer::BATCH_MAX_DRAWS.
+struct BatchDraw {
+    vec4 clipRegion;
+    // Brightness, opacity, saturation and dimming.
+    vec4 params;
+    // Texture width and height, corner radius and reflections falloff.
+    vec4 shape;
+    uint shaderFlags;
+};
+
+layout(std140) uniform BatchDraws {
+    BatchDraw draws[256];
+};
 
 out vec2 position;
 out vec2 texCoord;
 out vec4 color;
+flat out uint shaderFlags;
+flat out vec4 clipRegion;
+flat out vec2 texSize;
+flat out float brightness;
+flat out float opacity;
+flat out float saturation;
+flat out float dimming;
+flat out float cornerRadius;
+flat out float reflectionsFalloff;
 
 void main(void)
 {
-    gl_Position = MVPMatrix * vec4(positionVertex.xy, 0.0, 1.0);
+    gl_Position = clipPositionVertex;
     position = positionVertex;
     texCoord = texCoordVertex;
     color.abgr = colorVertex.rgba;
+    shaderFlags = draws[drawIndexVertex].shaderFlags;
+    clipRegion = draws[drawIndexVertex].clipRegion;
+    brightness = draws[drawIndexVertex].params.x;
+    opacity = draws[drawIndexVertex].params.y;
+    saturation = draws[drawIndexVertex].params.z;
+    dimming = draws[drawIndexVertex].params.w;
+    texSize = draws[drawIndexVertex].shape.xy;
+    cornerRadius = draws[drawIndexVertex].shape.z;
+    reflectionsFalloff = draws[drawIndexVertex].shape.w;
 }
 
 // Fragment section of code:
@@ -36,19 +71,19 @@ precision highp float;
 in vec2 position;
 in vec2 texCoord;
 in vec4 color;
-
-uniform vec2 texSize;
-uniform vec4 clipRegion;
-uniform float brightness;
-uniform float saturation;
-uniform float opacity;
-uniform float dimming;
-uniform float cornerRadius;
-uniform float reflectionsFalloff;
-uniform uint shaderFlags;
+flat in uint shaderFlags;
+flat in vec4 clipRegion;
+flat in vec2 texSize;
+flat in float brightness;
+flat in float opacity;
+flat in float saturation;
+flat in float dimming;
+flat in float cornerRadius;
+flat in float reflectionsFalloff;
 
 uniform sampler2D textureSampler0;
 uniform sampler2D textureSampler1;
+uniform sampler2D textureSampler2;
 out vec4 FragColor;
 
 // shaderFlags:
@@ -60,6 +95,7 @@ out vec4 FragColor;
 // 0x00000020 - Rounded corners
 // 0x00000040 - Rounded corners with no anti-aliasing
 // 0x00000080 - Convert pixel format
+// 0x00000100 - Convert planar YUV
 
 void main()
 {
@@ -79,10 +115,20 @@ void main()
 
     // Pixel format conversion is sometimes required as not all mobile GPUs support all
     // OpenGL operations in BGRA format.
-    if (0x0u != (shaderFlags & 0x80u))
+    if (0x0u != (shaderFlags & 0x80u)) {
         sampledColor.bgra = texture(textureSampler0, texCoord);
-    else
+    }
+    else if (0x0u != (shaderFlags & 0x100u)) {
+        // Video frames with the Y, U and V planes in separate textures, these are always
+        // converted to BT.601 limited range by the video player.
+        float y = 1.164 * (texture(textureSampler0, texCoord).r - 0.0625);
+        float u = texture(textureSampler1, texCoord).r - 0.5;
+        float v = texture(textureSampler2, texCoord).r - 0.5;
+        sampledColor = vec4(y + 1.596 * v, y - 0.392 * u - 0.813 * v, y + 2.017 * u, 1.0);
+    }
+    else {
         sampledColor = texture(textureSampler0, texCoord);
+    }
 
     // Rounded corners.
     if (0x0u != (shaderFlags & 0x20u) || 0x0u != (shaderFlags & 0x40u)) {